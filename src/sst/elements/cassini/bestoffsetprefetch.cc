@@ -0,0 +1,112 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "bestoffsetprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+BestOffsetPrefetcher::BestOffsetPrefetcher(ComponentId_t id, Params& params) : FeedbackPrefetcher(id, params, "BestOffsetPrefetcher") {
+    unsigned maxOffset = params.find<unsigned>("max_offset", 64);
+    unsigned pageLines = pageSize / blockSize;
+    if (maxOffset >= pageLines) maxOffset = pageLines - 1;
+    if (maxOffset == 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: max_offset must be at least 1 and a page must hold more than one line\n", getName().c_str());
+
+    // Offsets whose only prime factors are 2, 3 and 5
+    for (unsigned d = 1; d <= maxOffset; d++) {
+        unsigned n = d;
+        while (n % 2 == 0) n /= 2;
+        while (n % 3 == 0) n /= 3;
+        while (n % 5 == 0) n /= 5;
+        if (n == 1)
+            offsets.push_back(d);
+    }
+    scores.assign(offsets.size(), 0);
+    testIndex = 0;
+    round = 0;
+    bestOffset = 1; // Next-line until the first phase completes
+
+    scoreMax = params.find<unsigned>("score_max", 31);
+    roundMax = params.find<unsigned>("round_max", 100);
+    badScore = params.find<unsigned>("bad_score", 1);
+
+    size_t rrSize = params.find<size_t>("rr_table_size", 256);
+    size_t size = 1;
+    while (size < rrSize) size <<= 1;
+    rr.assign(size, invalidLine);
+    rrMask = size - 1;
+
+    statPhases = registerStatistic<uint64_t>("learning_phases");
+    statBestOffset = registerStatistic<uint64_t>("best_offset");
+}
+
+void BestOffsetPrefetcher::train(const CacheListenerNotification& notify, bool prefetched) {
+    // Trigger on demand misses and on the first use of a prefetched line
+    if (notify.getResultType() != MISS && !prefetched)
+        return;
+
+    const Addr addr = lineAddr(notify.getPhysicalAddress());
+    const Addr line = addr / blockSize;
+
+    // Learning: would offsets[testIndex] have prefetched this line?
+    unsigned d = offsets[testIndex];
+    bool phaseDone = false;
+    if (line >= d && rr[rrSlot(line - d)] == line - d) {
+        if (++scores[testIndex] >= scoreMax) {
+            endPhase();
+            phaseDone = true;
+        }
+    }
+    if (!phaseDone && ++testIndex == offsets.size()) {
+        testIndex = 0;
+        if (++round >= roundMax)
+            endPhase();
+    }
+
+    rr[rrSlot(line)] = line;
+
+    if (bestOffset == 0)
+        return;
+
+    for (unsigned k = 1; k <= getDegree(); k++) {
+        Addr target = addr + (Addr)k * bestOffset * blockSize;
+        if (!samePage(addr, target))
+            break;
+        if (!issuePrefetch(target))
+            break;
+    }
+}
+
+void BestOffsetPrefetcher::endPhase() {
+    size_t best = 0;
+    for (size_t i = 1; i < scores.size(); i++) {
+        if (scores[i] > scores[best])
+            best = i;
+    }
+    bestOffset = scores[best] > badScore ? offsets[best] : 0;
+
+    output->verbose(CALL_INFO, 1, 0, "Learning phase done after %u rounds, best offset %u (score %u), prefetching %s\n",
+            round, offsets[best], scores[best], bestOffset ? "on" : "off");
+    statPhases->addData(1);
+    statBestOffset->addData(bestOffset);
+
+    scores.assign(scores.size(), 0);
+    testIndex = 0;
+    round = 0;
+}
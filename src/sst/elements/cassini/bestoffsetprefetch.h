@@ -0,0 +1,96 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_BESTOFFSET_PREFETCH
+#define _H_SST_BESTOFFSET_PREFETCH
+
+#include <vector>
+
+#include "feedbackprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Best-offset prefetcher (after Michaud, HPCA 2016)
+ *
+ * Learns a single line offset D and prefetches X+D (and X+2D... up to the
+ * degree) on each demand miss or first hit to a prefetched line X. Candidate
+ * offsets are the numbers up to 'max_offset' whose only prime factors are 2,
+ * 3 and 5. On each triggering access one candidate d is tested: it scores if
+ * X-d is in the recent-requests table, i.e., prefetching with offset d would
+ * have covered X. A learning phase ends when a candidate reaches 'score_max'
+ * or after 'round_max' rounds over all candidates; the best candidate becomes
+ * D, or prefetching stops for the next phase if its score is at most
+ * 'bad_score'. Prefetches stay within the page.
+ */
+class BestOffsetPrefetcher : public FeedbackPrefetcher {
+public:
+    BestOffsetPrefetcher(ComponentId_t id, Params& params);
+    ~BestOffsetPrefetcher() { }
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        BestOffsetPrefetcher,
+            "cassini",
+            "BestOffsetPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Best-offset prefetcher with feedback-directed throttling",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_FEEDBACK_PREFETCHER_ELI_PARAMS,
+        { "max_offset", "Largest candidate offset in lines (capped to the lines in a page)", "64" },
+        { "rr_table_size", "Entries in the recent-requests table (rounded up to a power of 2)", "256" },
+        { "score_max", "A learning phase ends when a candidate offset reaches this score", "31" },
+        { "round_max", "A learning phase ends after this many rounds over the candidate offsets", "100" },
+        { "bad_score", "Stop prefetching for a phase if the best score is at most this", "1" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_FEEDBACK_PREFETCHER_ELI_STATS,
+        { "learning_phases", "Number of completed learning phases", "phases", 1 },
+        { "best_offset", "Offset (in lines) selected at the end of each learning phase, 0 if prefetching was turned off", "lines", 2 }
+    )
+
+protected:
+    void train(const CacheListenerNotification& notify, bool prefetched) override;
+
+private:
+    void endPhase();
+    size_t rrSlot(Addr line) const { return (line ^ (line >> 8)) & rrMask; }
+
+    std::vector<unsigned> offsets;  // Candidate offsets in lines
+    std::vector<unsigned> scores;
+    size_t testIndex;
+    unsigned round;
+    unsigned bestOffset;            // 0 if prefetching is off
+    unsigned scoreMax;
+    unsigned roundMax;
+    unsigned badScore;
+
+    std::vector<Addr> rr;           // Recent requests, line numbers; invalidLine if empty
+    Addr rrMask;
+    static constexpr Addr invalidLine = ~(Addr)0;
+
+    Statistic<uint64_t>* statPhases;
+    Statistic<uint64_t>* statBestOffset;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
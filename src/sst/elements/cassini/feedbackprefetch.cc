@@ -0,0 +1,204 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "feedbackprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+FeedbackPrefetcher::FeedbackPrefetcher(ComponentId_t id, Params& params, const std::string& name) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    uint32_t verbosity = params.find<uint32_t>("verbose", 0);
+    output = new Output(name + "[" + getName() + " | @f:@p:@l] ", verbosity, 0, Output::STDOUT);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    if (blockSize == 0 || (blockSize & (blockSize - 1)) != 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size must be a power of 2. You specified: %" PRIu64 "\n", getName().c_str(), blockSize);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    if (pageSize < blockSize || pageSize % blockSize != 0)
+        output->fatal(CALL_INFO, -1, "%s, Error: page_size must be a multiple of cache_line_size. You specified: %" PRIu64 "\n", getName().c_str(), pageSize);
+
+    minDegree = params.find<unsigned>("min_degree", 1);
+    maxDegree = params.find<unsigned>("max_degree", 8);
+    degree = params.find<unsigned>("degree", 2);
+    if (minDegree == 0 || maxDegree < minDegree)
+        output->fatal(CALL_INFO, -1, "%s, Error: need 1 <= min_degree <= max_degree. You specified: min_degree=%u, max_degree=%u\n", getName().c_str(), minDegree, maxDegree);
+    if (degree < minDegree) degree = minDegree;
+    if (degree > maxDegree) degree = maxDegree;
+
+    throttleEnabled = params.find<bool>("throttle", true);
+    throttleInterval = params.find<uint64_t>("throttle_interval", 256);
+    if (throttleInterval == 0) throttleInterval = 1;
+    accuracyHigh = params.find<double>("accuracy_high", 0.75);
+    accuracyLow = params.find<double>("accuracy_low", 0.40);
+    dropThreshold = params.find<double>("drop_threshold", 0.25);
+    accuracy = 1.0;
+
+    size_t trackSize = params.find<size_t>("tracking_table_size", 1024);
+    size_t size = 1;
+    while (size < trackSize) size <<= 1;
+    tracked.assign(size, invalidAddr);
+    trackMask = size - 1;
+
+    issuedThisAccess = 0;
+    intervalIssued = intervalDropped = intervalUseful = 0;
+    totalIssued = totalUseful = totalLate = totalUncovered = 0;
+
+    statIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statFiltered = registerStatistic<uint64_t>("prefetches_filtered");
+    statDropped = registerStatistic<uint64_t>("prefetches_dropped");
+    statRedundant = registerStatistic<uint64_t>("prefetches_redundant");
+    statUseful = registerStatistic<uint64_t>("prefetches_useful");
+    statLate = registerStatistic<uint64_t>("prefetches_late");
+    statUseless = registerStatistic<uint64_t>("prefetches_useless");
+    statUncovered = registerStatistic<uint64_t>("demand_misses_uncovered");
+    statDegree = registerStatistic<uint64_t>("throttle_degree");
+}
+
+FeedbackPrefetcher::~FeedbackPrefetcher() {
+    delete output;
+}
+
+size_t FeedbackPrefetcher::trackSlot(Addr line, bool& found) const {
+    Addr block = line / blockSize;
+    size_t slot = (block ^ (block >> 13)) & trackMask;
+    found = (tracked[slot] == line);
+    return slot;
+}
+
+void FeedbackPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const NotifyResultType notifyResType = notify.getResultType();
+    const Addr line = lineAddr(notify.getPhysicalAddress());
+
+    bool found;
+    size_t slot = trackSlot(line, found);
+
+    switch (notifyType) {
+        case PREFETCH:
+            if (!found)
+                return;     // Not one of ours
+            if (notifyResType == DROPPED) {
+                statDropped->addData(1);
+                intervalDropped++;
+                tracked[slot] = invalidAddr;
+            } else if (notifyResType == HIT) {
+                statRedundant->addData(1);
+                tracked[slot] = invalidAddr;
+            }
+            return;
+        case EVICT:
+            if (found) {
+                statUseless->addData(1);
+                tracked[slot] = invalidAddr;
+            }
+            return;
+        case READ:
+        case WRITE:
+            break;
+        default:
+            return;
+    }
+
+    if (found) {
+        if (notifyResType == HIT) {
+            statUseful->addData(1);
+        } else {
+            statLate->addData(1);
+            totalLate++;
+        }
+        totalUseful++;
+        intervalUseful++;
+        tracked[slot] = invalidAddr;
+    } else if (notifyResType == MISS) {
+        statUncovered->addData(1);
+        totalUncovered++;
+    }
+
+    issuedThisAccess = 0;
+    train(notify, found);
+}
+
+bool FeedbackPrefetcher::issuePrefetch(Addr addr) {
+    if (issuedThisAccess >= degree)
+        return false;
+
+    const Addr line = lineAddr(addr);
+    bool found;
+    size_t slot = trackSlot(line, found);
+    if (found) {
+        statFiltered->addData(1);
+        return true;
+    }
+    tracked[slot] = line;
+
+    output->verbose(CALL_INFO, 2, 0, "Issue prefetch, address: 0x%" PRIx64 ", degree: %u\n", line, degree);
+
+    statIssued->addData(1);
+    totalIssued++;
+    intervalIssued++;
+    issuedThisAccess++;
+
+    for (std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+        MemEvent* ev = new MemEvent(getName(), line, line, Command::GetS);
+        ev->setSize(blockSize);
+        ev->setPrefetchFlag(true);
+        (*(*callbackItr))(ev);
+    }
+
+    if (intervalIssued >= throttleInterval)
+        throttle();
+
+    return issuedThisAccess < degree;
+}
+
+/* Feedback-directed throttling: back off when the cache drops prefetches or they are inaccurate, ramp up when they are accurate */
+void FeedbackPrefetcher::throttle() {
+    uint64_t accepted = intervalIssued > intervalDropped ? intervalIssued - intervalDropped : 0;
+    accuracy = accepted ? (double)intervalUseful / (double)accepted : 0.0;
+    if (accuracy > 1.0) accuracy = 1.0; // Uses of prefetches issued in an earlier interval
+
+    if (throttleEnabled) {
+        if ((double)intervalDropped > dropThreshold * (double)intervalIssued || accuracy < accuracyLow) {
+            if (degree > minDegree) degree--;
+        } else if (accuracy >= accuracyHigh) {
+            if (degree < maxDegree) degree++;
+        }
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Interval: issued %" PRIu64 ", dropped %" PRIu64 ", useful %" PRIu64 ", accuracy %.2f, degree now %u\n",
+            intervalIssued, intervalDropped, intervalUseful, accuracy, degree);
+
+    statDegree->addData(degree);
+    intervalIssued = intervalDropped = intervalUseful = 0;
+}
+
+void FeedbackPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void FeedbackPrefetcher::printStats(Output &UNUSED(out)) {
+    uint64_t covered = totalUseful + totalUncovered;
+    output->verbose(CALL_INFO, 1, 0, "Prefetches issued: %" PRIu64 ", accuracy: %.3f, coverage: %.3f, late: %.3f, final degree: %u\n",
+            totalIssued,
+            totalIssued ? (double)totalUseful / (double)totalIssued : 0.0,
+            covered ? (double)totalUseful / (double)covered : 0.0,
+            totalUseful ? (double)totalLate / (double)totalUseful : 0.0,
+            degree);
+}
@@ -0,0 +1,151 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_FEEDBACK_PREFETCH
+#define _H_SST_FEEDBACK_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/subcomponent.h>
+#include <sst/core/output.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Common base for the table-based prefetchers (best-offset, SPP, IP-stride)
+ *
+ * Tracks the prefetches it issued in a fixed-size table and uses the cache's
+ * notifications to classify each one:
+ *  - useful:    a demand access hit the prefetched line
+ *  - late:      a demand access missed on a line whose prefetch was still outstanding
+ *  - useless:   the line was evicted before any demand access
+ *  - redundant: the line was already in the cache
+ *  - dropped:   the cache rejected the prefetch because max_outstanding_prefetch
+ *               or drop_prefetch_mshr_level was reached
+ * Every 'throttle_interval' prefetches the degree (prefetches per triggering
+ * access) is raised when accuracy is high and lowered when accuracy is low or
+ * the cache is dropping prefetches, so prefetches back off before they fill
+ * the MSHR.
+ *
+ * Subclasses implement train(), which is called for every demand access and
+ * issues prefetches with issuePrefetch() until it returns false.
+ */
+
+#define CASSINI_FEEDBACK_PREFETCHER_ELI_PARAMS { "verbose", "Controls the verbosity of the prefetcher", "0" },\
+            { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },\
+            { "page_size", "Page size; prefetches do not cross page boundaries unless the prefetcher says otherwise", "4096" },\
+            { "degree", "Initial number of prefetches per triggering access", "2" },\
+            { "min_degree", "Lowest degree the throttle can select", "1" },\
+            { "max_degree", "Highest degree the throttle can select", "8" },\
+            { "throttle", "Adjust the degree from measured accuracy and cache drops, 0 is no, 1 is yes", "1" },\
+            { "throttle_interval", "Number of prefetches (issued or dropped) between throttle decisions", "256" },\
+            { "accuracy_high", "Raise the degree when interval accuracy is at least this fraction", "0.75" },\
+            { "accuracy_low", "Lower the degree when interval accuracy is below this fraction", "0.40" },\
+            { "drop_threshold", "Lower the degree when more than this fraction of the interval's prefetches were dropped by the cache", "0.25" },\
+            { "tracking_table_size", "Entries in the table of issued prefetches used to measure accuracy and filter duplicates (rounded up to a power of 2)", "1024" }
+
+#define CASSINI_FEEDBACK_PREFETCHER_ELI_STATS { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },\
+            { "prefetches_filtered", "Prefetches not issued because the line was already prefetched and not yet used", "prefetches", 1 },\
+            { "prefetches_dropped", "Prefetches dropped by the cache (max_outstanding_prefetch or drop_prefetch_mshr_level)", "prefetches", 1 },\
+            { "prefetches_redundant", "Prefetches to lines that were already in the cache", "prefetches", 1 },\
+            { "prefetches_useful", "Prefetched lines that a demand access hit (timely)", "prefetches", 1 },\
+            { "prefetches_late", "Prefetched lines that a demand access missed on while the prefetch was outstanding", "prefetches", 1 },\
+            { "prefetches_useless", "Prefetched lines evicted before any demand access", "prefetches", 1 },\
+            { "demand_misses_uncovered", "Demand misses to lines that were not prefetched", "misses", 1 },\
+            { "throttle_degree", "Degree selected at each throttle interval", "prefetches", 2 }
+
+class FeedbackPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    FeedbackPrefetcher(ComponentId_t id, Params& params, const std::string& name);
+    virtual ~FeedbackPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify) override;
+    void registerResponseCallback(Event::HandlerBase *handler) override;
+    void printStats(Output &out) override;
+
+protected:
+    /* Train on a demand access and issue prefetches. 'prefetched' is set if the access was to a line this prefetcher brought in (or is bringing in) */
+    virtual void train(const CacheListenerNotification& notify, bool prefetched) = 0;
+
+    /* Issue a prefetch for the line containing addr. Returns false once this access's budget (the degree) is used up */
+    bool issuePrefetch(Addr addr);
+
+    Addr lineAddr(Addr addr) const { return addr & ~(blockSize - 1); }
+    bool samePage(Addr a, Addr b) const { return (a / pageSize) == (b / pageSize); }
+    unsigned getDegree() const { return degree; }
+    /* Accuracy measured over the last throttle interval */
+    double getAccuracy() const { return accuracy; }
+
+    Output* output;
+    uint64_t blockSize;
+    uint64_t pageSize;
+
+private:
+    void throttle();
+    /* Returns the tracking table slot for a line and whether the line is in it */
+    size_t trackSlot(Addr line, bool& found) const;
+
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+
+    std::vector<Addr> tracked;      // Issued prefetches awaiting a demand access or eviction; invalidAddr if empty
+    Addr trackMask;
+    static constexpr Addr invalidAddr = ~(Addr)0;
+
+    unsigned degree;
+    unsigned minDegree;
+    unsigned maxDegree;
+    unsigned issuedThisAccess;
+    bool throttleEnabled;
+    uint64_t throttleInterval;
+    double accuracyHigh;
+    double accuracyLow;
+    double dropThreshold;
+    double accuracy;
+
+    // Counts for the current throttle interval
+    uint64_t intervalIssued;
+    uint64_t intervalDropped;
+    uint64_t intervalUseful;
+
+    // Totals for printStats
+    uint64_t totalIssued;
+    uint64_t totalUseful;
+    uint64_t totalLate;
+    uint64_t totalUncovered;
+
+    Statistic<uint64_t>* statIssued;
+    Statistic<uint64_t>* statFiltered;
+    Statistic<uint64_t>* statDropped;
+    Statistic<uint64_t>* statRedundant;
+    Statistic<uint64_t>* statUseful;
+    Statistic<uint64_t>* statLate;
+    Statistic<uint64_t>* statUseless;
+    Statistic<uint64_t>* statUncovered;
+    Statistic<uint64_t>* statDegree;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
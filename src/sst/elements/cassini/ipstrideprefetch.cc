@@ -0,0 +1,79 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "ipstrideprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+IPStridePrefetcher::IPStridePrefetcher(ComponentId_t id, Params& params) : FeedbackPrefetcher(id, params, "IPStridePrefetcher") {
+    size_t tableSize = params.find<size_t>("table_size", 64);
+    size_t size = 1;
+    while (size < tableSize) size <<= 1;
+    table.assign(size, Entry{0, 0, 0, 0, false});
+    tableMask = size - 1;
+
+    confidenceMax = params.find<unsigned>("confidence_max", 3);
+    confidenceThreshold = params.find<unsigned>("confidence_threshold", 2);
+    if (confidenceThreshold > confidenceMax)
+        output->fatal(CALL_INFO, -1, "%s, Error: confidence_threshold (%u) cannot be larger than confidence_max (%u)\n", getName().c_str(), confidenceThreshold, confidenceMax);
+    distance = params.find<unsigned>("distance", 1);
+    if (distance == 0) distance = 1;
+    overrunPageBoundary = params.find<bool>("overrun_page_boundaries", false);
+
+    statTableMiss = registerStatistic<uint64_t>("stride_table_misses");
+}
+
+void IPStridePrefetcher::train(const CacheListenerNotification& notify, bool UNUSED(prefetched)) {
+    const Addr ip = notify.getInstructionPointer();
+    const Addr addr = lineAddr(notify.getPhysicalAddress());
+    const Addr line = addr / blockSize;
+
+    Entry& entry = table[((ip >> 2) ^ (ip >> 12)) & tableMask];
+    if (!entry.valid || entry.ip != ip) {
+        statTableMiss->addData(1);
+        entry = Entry{ip, line, 0, 0, true};
+        return;
+    }
+
+    int64_t delta = (int64_t)(line - entry.lastLine);
+    if (delta == 0)
+        return; // Same line again, nothing to learn
+
+    if (delta == entry.stride) {
+        if (entry.confidence < confidenceMax)
+            entry.confidence++;
+    } else {
+        if (entry.confidence > 0)
+            entry.confidence--;
+        if (entry.confidence == 0)
+            entry.stride = delta;
+    }
+    entry.lastLine = line;
+
+    if (entry.confidence < confidenceThreshold || entry.stride == 0)
+        return;
+
+    for (unsigned k = distance; k < distance + getDegree(); k++) {
+        Addr target = addr + (Addr)(entry.stride * (int64_t)k * (int64_t)blockSize);
+        if (!overrunPageBoundary && !samePage(addr, target))
+            break;
+        if (!issuePrefetch(target))
+            break;
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_IPSTRIDE_PREFETCH
+#define _H_SST_IPSTRIDE_PREFETCH
+
+#include <vector>
+
+#include "feedbackprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Per-instruction stride prefetcher
+ *
+ * A direct-mapped table indexed by instruction pointer holds the last line
+ * each load/store touched, its stride and a saturating confidence counter.
+ * Once the same stride has been seen 'confidence_threshold' times, the
+ * prefetcher fetches 'degree' lines along the stride starting 'distance'
+ * strides ahead. Accesses without an instruction pointer (IP 0) all share
+ * one entry, which then behaves as a global stride detector.
+ */
+class IPStridePrefetcher : public FeedbackPrefetcher {
+public:
+    IPStridePrefetcher(ComponentId_t id, Params& params);
+    ~IPStridePrefetcher() { }
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        IPStridePrefetcher,
+            "cassini",
+            "IPStridePrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Instruction-pointer indexed stride prefetcher with confidence counters and feedback-directed throttling",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_FEEDBACK_PREFETCHER_ELI_PARAMS,
+        { "table_size", "Number of entries in the stride table (rounded up to a power of 2)", "64" },
+        { "confidence_threshold", "Number of times a stride must repeat before it is prefetched", "2" },
+        { "confidence_max", "Maximum value of the confidence counter", "3" },
+        { "distance", "How many strides ahead of the access the first prefetch is", "1" },
+        { "overrun_page_boundaries", "Allow prefetches to cross page boundaries, 0 is no, 1 is yes", "0" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_FEEDBACK_PREFETCHER_ELI_STATS,
+        { "stride_table_misses", "Accesses whose instruction pointer was not in the stride table", "accesses", 1 }
+    )
+
+protected:
+    void train(const CacheListenerNotification& notify, bool prefetched) override;
+
+private:
+    struct Entry {
+        Addr ip;
+        Addr lastLine;      // In lines
+        int64_t stride;     // In lines
+        unsigned confidence;
+        bool valid;
+    };
+
+    std::vector<Entry> table;
+    Addr tableMask;
+    unsigned confidenceThreshold;
+    unsigned confidenceMax;
+    unsigned distance;
+    bool overrunPageBoundary;
+
+    Statistic<uint64_t>* statTableMiss;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
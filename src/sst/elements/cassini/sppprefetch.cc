@@ -0,0 +1,147 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "sppprefetch.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+SPPPrefetcher::SPPPrefetcher(ComponentId_t id, Params& params) : FeedbackPrefetcher(id, params, "SPPPrefetcher") {
+    size_t stSize = params.find<size_t>("signature_table_size", 256);
+    size_t size = 1;
+    while (size < stSize) size <<= 1;
+    signatureTable.assign(size, SignatureEntry{0, 0, 0, false});
+    signatureMask = size - 1;
+
+    size_t ptSize = params.find<size_t>("pattern_table_size", 512);
+    size = 1;
+    while (size < ptSize) size <<= 1;
+    patternTable.assign(size, PatternEntry{0, {0}, {0}});
+    patternMask = size - 1;
+
+    signatureBits = params.find<unsigned>("signature_bits", 12);
+    if (signatureBits == 0 || signatureBits > 30)
+        output->fatal(CALL_INFO, -1, "%s, Error: signature_bits must be between 1 and 30. You specified: %u\n", getName().c_str(), signatureBits);
+    prefetchThreshold = params.find<double>("prefetch_threshold", 0.25);
+    lookaheadThreshold = params.find<double>("lookahead_threshold", 0.25);
+    maxDepth = params.find<unsigned>("max_depth", 8);
+    pageLines = pageSize / blockSize;
+
+    statSignatureMiss = registerStatistic<uint64_t>("signature_table_misses");
+    statDepth = registerStatistic<uint64_t>("lookahead_depth");
+}
+
+/* Shift in the delta in sign-magnitude form */
+unsigned SPPPrefetcher::nextSignature(unsigned signature, int delta) const {
+    unsigned encoded = delta < 0 ? (unsigned)(-delta) | 0x40 : (unsigned)delta;
+    return ((signature << 3) ^ encoded) & ((1u << signatureBits) - 1);
+}
+
+void SPPPrefetcher::updatePattern(unsigned signature, int delta) {
+    PatternEntry& entry = pattern(signature);
+    unsigned slot = deltaSlots;
+    unsigned victim = 0;
+    for (unsigned i = 0; i < deltaSlots; i++) {
+        if (entry.deltaCount[i] != 0 && entry.delta[i] == delta) {
+            slot = i;
+            break;
+        }
+        if (entry.deltaCount[i] < entry.deltaCount[victim])
+            victim = i;
+    }
+    if (slot == deltaSlots) {
+        slot = victim;
+        entry.delta[slot] = delta;
+        entry.deltaCount[slot] = 0;
+    }
+    entry.deltaCount[slot]++;
+    entry.sigCount++;
+
+    // Halve all counters on saturation to keep the ratios
+    if (entry.sigCount >= counterMax || entry.deltaCount[slot] >= counterMax) {
+        entry.sigCount >>= 1;
+        for (unsigned i = 0; i < deltaSlots; i++)
+            entry.deltaCount[i] >>= 1;
+        if (entry.sigCount == 0) entry.sigCount = 1;
+    }
+}
+
+void SPPPrefetcher::train(const CacheListenerNotification& notify, bool UNUSED(prefetched)) {
+    const Addr addr = lineAddr(notify.getPhysicalAddress());
+    const Addr page = addr / pageSize;
+    const Addr pageBase = page * pageSize;
+    const unsigned offset = (addr - pageBase) / blockSize;
+
+    SignatureEntry& st = signatureTable[(page ^ (page >> 10)) & signatureMask];
+    if (!st.valid || st.page != page) {
+        statSignatureMiss->addData(1);
+        st = SignatureEntry{page, offset, 0, true};
+        return;
+    }
+
+    int delta = (int)offset - (int)st.lastOffset;
+    if (delta == 0)
+        return;
+
+    updatePattern(st.signature, delta);
+    st.signature = nextSignature(st.signature, delta);
+    st.lastOffset = offset;
+
+    // Walk the most likely path; the measured accuracy discounts each step
+    double alpha = getAccuracy();
+    if (alpha < 0.1) alpha = 0.1;
+    if (alpha > 0.95) alpha = 0.95;
+
+    double pathConfidence = 1.0;
+    unsigned signature = st.signature;
+    int base = offset;
+    unsigned depth = 0;
+    for (; depth < maxDepth; depth++) {
+        PatternEntry& entry = pattern(signature);
+        if (entry.sigCount == 0)
+            break;
+
+        int bestDelta = 0;
+        unsigned bestCount = 0;
+        for (unsigned i = 0; i < deltaSlots; i++) {
+            if (entry.deltaCount[i] == 0)
+                continue;
+            double confidence = pathConfidence * entry.deltaCount[i] / entry.sigCount;
+            int target = base + entry.delta[i];
+            if (confidence >= prefetchThreshold && target >= 0 && target < (int)pageLines) {
+                if (!issuePrefetch(pageBase + (Addr)target * blockSize)) {
+                    statDepth->addData(depth + 1);
+                    return;
+                }
+            }
+            if (entry.deltaCount[i] > bestCount) {
+                bestCount = entry.deltaCount[i];
+                bestDelta = entry.delta[i];
+            }
+        }
+
+        if (bestCount == 0)
+            break;
+        pathConfidence = pathConfidence * bestCount / entry.sigCount * alpha;
+        base += bestDelta;
+        if (pathConfidence < lookaheadThreshold || base < 0 || base >= (int)pageLines)
+            break;
+        signature = nextSignature(signature, bestDelta);
+    }
+    statDepth->addData(depth);
+}
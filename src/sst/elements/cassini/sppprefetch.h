@@ -0,0 +1,110 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_SPP_PREFETCH
+#define _H_SST_SPP_PREFETCH
+
+#include <vector>
+
+#include "feedbackprefetch.h"
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Signature path prefetcher (after Kim et al., MICRO 2016)
+ *
+ * The signature table keeps, per page, the last line offset accessed and a
+ * signature that compresses the page's recent deltas. The pattern table maps
+ * a signature to up to four next deltas with counters. On each access the
+ * prefetcher walks the most likely path of deltas, multiplying confidences
+ * along the way (scaled by the measured prefetch accuracy), and prefetches
+ * every delta whose path confidence is at least 'prefetch_threshold'. The walk
+ * stops at 'lookahead_threshold', 'max_depth', the page boundary, or when the
+ * throttle's degree is used up.
+ */
+class SPPPrefetcher : public FeedbackPrefetcher {
+public:
+    SPPPrefetcher(ComponentId_t id, Params& params);
+    ~SPPPrefetcher() { }
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        SPPPrefetcher,
+            "cassini",
+            "SPPPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Signature path prefetcher with lookahead and feedback-directed throttling",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        CASSINI_FEEDBACK_PREFETCHER_ELI_PARAMS,
+        { "signature_table_size", "Entries (pages) in the signature table (rounded up to a power of 2)", "256" },
+        { "pattern_table_size", "Entries in the pattern table (rounded up to a power of 2)", "512" },
+        { "signature_bits", "Width of a signature in bits", "12" },
+        { "prefetch_threshold", "Minimum path confidence (0-1) to issue a prefetch", "0.25" },
+        { "lookahead_threshold", "Minimum path confidence (0-1) to keep walking the signature path", "0.25" },
+        { "max_depth", "Maximum lookahead depth", "8" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        CASSINI_FEEDBACK_PREFETCHER_ELI_STATS,
+        { "signature_table_misses", "Accesses to pages not in the signature table", "accesses", 1 },
+        { "lookahead_depth", "Depth reached by each signature path walk", "steps", 2 }
+    )
+
+protected:
+    void train(const CacheListenerNotification& notify, bool prefetched) override;
+
+private:
+    static constexpr unsigned deltaSlots = 4;
+    static constexpr unsigned counterMax = 15;
+
+    struct SignatureEntry {
+        Addr page;
+        unsigned lastOffset;
+        unsigned signature;
+        bool valid;
+    };
+
+    struct PatternEntry {
+        unsigned sigCount;
+        int delta[deltaSlots];
+        unsigned deltaCount[deltaSlots];
+    };
+
+    unsigned nextSignature(unsigned signature, int delta) const;
+    void updatePattern(unsigned signature, int delta);
+    PatternEntry& pattern(unsigned signature) { return patternTable[signature & patternMask]; }
+
+    std::vector<SignatureEntry> signatureTable;
+    Addr signatureMask;
+    std::vector<PatternEntry> patternTable;
+    unsigned patternMask;
+    unsigned signatureBits;
+    double prefetchThreshold;
+    double lookaheadThreshold;
+    unsigned maxDepth;
+    unsigned pageLines;
+
+    Statistic<uint64_t>* statSignatureMiss;
+    Statistic<uint64_t>* statDepth;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
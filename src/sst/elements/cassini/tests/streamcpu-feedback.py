@@ -0,0 +1,74 @@
+# Feedback-directed prefetching example
+#
+# Runs streamCPU against an L1 with one of the table-based prefetchers. The
+# cache drops prefetches beyond max_outstanding_prefetch and the prefetcher
+# throttles its degree from the drops and from its measured accuracy.
+#   sst streamcpu-feedback.py -- --prefetcher=cassini.SPPPrefetcher
+import sst
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--prefetcher", help="prefetcher subcomponent",
+        choices=["cassini.BestOffsetPrefetcher", "cassini.SPPPrefetcher", "cassini.IPStridePrefetcher"],
+        default="cassini.BestOffsetPrefetcher")
+parser.add_argument("--throttle", help="enable feedback-directed throttling (0 or 1)", type=int, default=1)
+args = parser.parse_args()
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "memHierarchy.streamCPU")
+comp_cpu.addParams({
+      "do_write" : "1",
+      "num_loadstore" : "100000",
+      "commFreq" : "100",
+      "memSize" : "524288"
+})
+
+iface = comp_cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+comp_l1cache.addParams({
+      "access_latency_cycles" : "2",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "4",
+      "cache_line_size" : "64",
+      "L1" : "1",
+      "cache_size" : "8 KB",
+      "max_outstanding_prefetch" : "8",
+})
+
+prefetcher = comp_l1cache.setSubComponent("prefetcher", args.prefetcher)
+prefetcher.addParams({
+      "verbose" : "1",
+      "cache_line_size" : "64",
+      "throttle" : args.throttle,
+      "throttle_interval" : "128",
+})
+
+# Enable statistics outputs
+comp_l1cache.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+prefetcher.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+comp_memory = sst.Component("memory", "memHierarchy.MemController")
+comp_memory.addParams({
+      "clock" : "1GHz",
+      "addr_range_start" : 0
+})
+backend = comp_memory.setSubComponent("backend", "memHierarchy.simpleMem")
+backend.addParams({
+      "access_time" : "1000 ns",
+      "mem_size" : "512MiB",
+})
+
+# Define the simulation links
+link_cpu_cache_link = sst.Link("link_cpu_cache_link")
+link_cpu_cache_link.connect( (iface, "port", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (comp_l1cache, "low_network_0", "50ps"), (comp_memory, "direct_link", "50ps") )
@@ -2,6 +2,7 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -55,6 +56,24 @@ class testcase_cassini_prefetch(SSTTestCase):
     def test_cassini_prefetch_nextblock(self):
         self.cassini_prefetch_test_template("nbp")
 
+    # Feedback-directed prefetchers, all run from streamcpu-feedback.py
+    # These check the prefetcher's accuracy, coverage and lateness statistics rather than diffing a reference
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_feedback_bestoffset skipped if threads > 3")
+    def test_cassini_prefetch_feedback_bestoffset(self):
+        self.cassini_feedback_test_template("bestoffset", '--model-options="--prefetcher=cassini.BestOffsetPrefetcher"')
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_feedback_spp skipped if threads > 3")
+    def test_cassini_prefetch_feedback_spp(self):
+        self.cassini_feedback_test_template("spp", '--model-options="--prefetcher=cassini.SPPPrefetcher"')
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_feedback_ipstride skipped if threads > 3")
+    def test_cassini_prefetch_feedback_ipstride(self):
+        self.cassini_feedback_test_template("ipstride", '--model-options="--prefetcher=cassini.IPStridePrefetcher"')
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_feedback_nothrottle skipped if threads > 3")
+    def test_cassini_prefetch_feedback_nothrottle(self):
+        self.cassini_feedback_test_template("nothrottle", '--model-options="--throttle=0"', throttle=False)
+
 #####
 
     def cassini_prefetch_test_template(self, testcase, testtimeout=180):
@@ -93,6 +112,66 @@ class testcase_cassini_prefetch(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+    # streamcpu-feedback.py streams through memory 8 bytes at a time, so every prefetcher should
+    # find the pattern; the bounds are loose enough to hold across timing changes
+    def cassini_feedback_test_template(self, variant, other_args, throttle=True, testtimeout=180):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName = "test_cassini_prefetch_feedback_{0}".format(variant)
+        sdlfile = "{0}/streamcpu-feedback.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=other_args, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("cassini_prefetch test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        stats = self._readPrefetcherStats(outfile)
+        for name in ["prefetches_issued", "prefetches_useful", "prefetches_late", "prefetches_dropped",
+                     "prefetches_redundant", "prefetches_useless", "demand_misses_uncovered", "throttle_degree"]:
+            self.assertTrue(name in stats, "Statistic {0} not found in {1}".format(name, outfile))
+
+        issued = stats["prefetches_issued"][0]
+        dropped = stats["prefetches_dropped"][0]
+        useful = stats["prefetches_useful"][0]
+        late = stats["prefetches_late"][0]
+        uncovered = stats["demand_misses_uncovered"][0]
+        self.assertTrue(issued > 0, "{0}: no prefetches issued".format(testDataFileName))
+
+        # Every issued prefetch is classified at most once
+        classified = useful + late + dropped + stats["prefetches_redundant"][0] + stats["prefetches_useless"][0]
+        self.assertTrue(classified <= issued, "{0}: {1} prefetches classified but only {2} issued".format(testDataFileName, classified, issued))
+
+        # Accuracy over the prefetches the cache accepted, coverage of demand misses, and lateness of the useful ones
+        accepted = issued - dropped
+        accuracy = float(useful + late) / accepted if accepted else 0.0
+        coverage = float(useful + late) / (useful + late + uncovered) if (useful + late + uncovered) else 0.0
+        lateness = float(late) / (useful + late) if (useful + late) else 0.0
+        log_debug("{0}: accuracy {1:.3f}, coverage {2:.3f}, late {3:.3f}".format(testDataFileName, accuracy, coverage, lateness))
+        self.assertTrue(accuracy >= 0.5, "{0}: accuracy {1:.3f} on a streaming access pattern".format(testDataFileName, accuracy))
+        self.assertTrue(coverage >= 0.5, "{0}: coverage {1:.3f} on a streaming access pattern".format(testDataFileName, coverage))
+        self.assertTrue(0.0 <= lateness <= 1.0, "{0}: lateness {1:.3f}".format(testDataFileName, lateness))
+
+        # throttle_degree records the degree at each throttle interval: [sum, count, min, max]
+        degree = stats["throttle_degree"]
+        self.assertTrue(degree[1] > 0, "{0}: no throttle intervals completed".format(testDataFileName))
+        if not throttle:
+            self.assertTrue(degree[2] == degree[3], "{0}: degree changed from {1} to {2} with throttling off".format(testDataFileName, degree[2], degree[3]))
+
+    # Return {stat_name : [sum, count, min, max]} for the prefetcher's accumulator statistics
+    def _readPrefetcherStats(self, out_file):
+        cons_accum = re.compile(r' ([\w.:]+)\.(\w+) : Accumulator : Sum\.\w+ = (\d+); SumSQ\.\w+ = \d+; Count\.\w+ = (\d+); Min\.\w+ = (\d+); Max\.\w+ = (\d+);')
+        stats = {}
+        with open(out_file, 'r') as fp:
+            for line in fp:
+                m = cons_accum.match(line)
+                if m != None and m.group(1).startswith("l1cache"):
+                    stats[m.group(2)] = [int(m.group(3)), int(m.group(4)), int(m.group(5)), int(m.group(6))]
+        return stats
+
     def _prettyPrintDiffs(self, stat_diff, oth_diff):
         out = ""
         if len(stat_diff) != 0:
@@ -47,23 +47,24 @@ void Sieve::recordMiss(Addr addr, bool isRead) {
                 allocMap[allocID] = rwCount_t();
                 evI = allocMap.find(allocID);
             }
+            // Each modeled miss stands for samplePeriod_ misses across all sets
             if (isRead) {
-                evI->second.first++;
-                statReadMisses->addData(1);
+                evI->second.first += samplePeriod_;
+                statReadMisses->addDataNTimes(samplePeriod_, 1);
             } else {
-                evI->second.second++;
-                statWriteMisses->addData(1);
+                evI->second.second += samplePeriod_;
+                statWriteMisses->addDataNTimes(samplePeriod_, 1);
             }
             return;
         }
     }
 
     if (isRead) {
-        statUnassocReadMisses->addData(1);
-        statReadMisses->addData(1);
+        statUnassocReadMisses->addDataNTimes(samplePeriod_, 1);
+        statReadMisses->addDataNTimes(samplePeriod_, 1);
     } else {
-        statUnassocWriteMisses->addData(1);
-        statWriteMisses->addData(1);
+        statUnassocWriteMisses->addDataNTimes(samplePeriod_, 1);
+        statWriteMisses->addDataNTimes(samplePeriod_, 1);
     }
 }
 
@@ -119,15 +120,22 @@ void Sieve::processEvent(SST::Event* ev, int link) {
     event->setBaseAddr(toBaseAddr(event->getAddr()));
     Addr baseAddr   = event->getBaseAddr();
 
-    SharedCacheLine * cline = cacheArray_->lookup(baseAddr, true);
-    bool miss = (cline == nullptr);
+    // With set sampling, accesses to unmodeled sets only get a response
+    Addr arrayAddr;
+    bool sampled = sampleSet(baseAddr, arrayAddr);
+    bool miss = false;
     Addr replacementAddr = 0;
 
+    if (sampled) {
+        statSampledAccesses->addData(1);
+        miss = (cacheArray_->lookup(arrayAddr, true) == nullptr);
+    }
+
     if (miss) {                                     /* Miss.  If needed, evict candidate */
         // output_->debug(_L3_,"-- Cache Miss --\n");
-        SharedCacheLine * line = cacheArray_->findReplacementCandidate(baseAddr);
+        SharedCacheLine * line = cacheArray_->findReplacementCandidate(arrayAddr);
         replacementAddr = line->getAddr();
-        cacheArray_->replace(baseAddr, line);
+        cacheArray_->replace(arrayAddr, line);
         line->setState(M);
 
         bool isRead = (cmd == Command::GetS);
@@ -145,15 +153,15 @@ void Sieve::processEvent(SST::Event* ev, int link) {
             listener_->notifyAccess(notify);
         }
 
-    } else {
-        if (cmd == Command::GetS) statReadHits->addData(1);
-        else statWriteHits->addData(1);
+    } else if (sampled) {
+        if (cmd == Command::GetS) statReadHits->addDataNTimes(samplePeriod_, 1);
+        else statWriteHits->addDataNTimes(samplePeriod_, 1);
     }
 
     // Debug output. Ifdef this for even better performance
 #ifdef __SST_DEBUG_OUTPUT__
     output_->debug(_L4_, "%s, Src = %s, Cmd = %s, BaseAddr = %" PRIx64 ", Addr = %" PRIx64 ", VA = %" PRIx64 ", PC = %" PRIx64 ", Size = %d: %s\n",
-            getName().c_str(), event->getSrc().c_str(), CommandString[(int)cmd], baseAddr, event->getAddr(), event->getVirtualAddress(), event->getInstructionPointer(), event->getSize(), miss ? "MISS" : "HIT");
+            getName().c_str(), event->getSrc().c_str(), CommandString[(int)cmd], baseAddr, event->getAddr(), event->getVirtualAddress(), event->getInstructionPointer(), event->getSize(), !sampled ? "NOT SAMPLED" : (miss ? "MISS" : "HIT"));
     if (miss) output_->debug(_L5_, "%s, Replaced address %" PRIx64 "\n", getName().c_str(), replacementAddr);
 #endif
 
@@ -176,6 +184,11 @@ void Sieve::processEvent(SST::Event* ev, int link) {
     //output_->debug(_L3_,"%s, Sending Response, Addr = %" PRIx64 "\n", getName().c_str(), event->getAddr());
 
     delete ev;
+
+    if (outputInterval_ != 0 && ++accessCount_ == outputInterval_) {
+        accessCount_ = 0;
+        outputStats(-1);
+    }
 }
 
 void Sieve::init(unsigned int phase) {
@@ -195,6 +208,11 @@ void Sieve::init(unsigned int phase) {
 }
 
 void Sieve::outputStats(int marker) {
+    if (binaryOutput_) {
+        writeBinaryStats(marker);
+        return;
+    }
+
     // create name <outFileName> + <sequence> + marker (optional)
     stringstream fileName;
     fileName << outFileName << "-" << outCount;
@@ -239,12 +257,57 @@ void Sieve::outputStats(int marker) {
     delete output_file;
 }
 
+/* Append one dump to the binary profile file and flush it so the profile can be read while the simulation runs */
+void Sieve::writeBinaryStats(int marker) {
+    // the listener (if any) still writes text, one file per dump
+    if (listener_) {
+        stringstream fileName;
+        fileName << outFileName << "-" << outCount;
+        if (-1 != marker) {
+            fileName << "-" << marker;
+        }
+        fileName << ".txt";
+        Output* output_file = new Output("",0,0,SST::Output::FILE, fileName.str());
+        listener_->printStats(*output_file);
+        delete output_file;
+    }
+
+    vector<SieveProfileEntry> entries;
+    entries.reserve(allocMap.size());
+    for (allocCountMap_t::iterator i = allocMap.begin(); i != allocMap.end(); ) {
+        rwCount_t &counts = i->second;
+        if (counts.first != 0 || counts.second != 0) {
+            SieveProfileEntry entry = { i->first, counts.first, counts.second };
+            entries.push_back(entry);
+        }
+        if ((counts.first == 0 && counts.second == 0) || resetStatsOnOutput) {
+            i = allocMap.erase(i);
+        } else {
+            i++;
+        }
+    }
+
+    SieveProfileDump dump = { outCount, marker, entries.size() };
+    outCount++;
+    bool ok = fwrite(&dump, sizeof(dump), 1, binaryFile_) == 1;
+    ok = ok && fwrite(entries.data(), sizeof(SieveProfileEntry), entries.size(), binaryFile_) == entries.size();
+    ok = ok && fflush(binaryFile_) == 0;
+    if (!ok)
+        output_->fatal(CALL_INFO, -1, "%s, Error: failed to write the binary malloc profile\n", getName().c_str());
+}
+
 void Sieve::finish(){
     outputStats(-1);
+    if (binaryFile_) {
+        fclose(binaryFile_);
+        binaryFile_ = nullptr;
+    }
 }
 
 
 Sieve::~Sieve(){
+    if (binaryFile_)
+        fclose(binaryFile_);
     delete cacheArray_;
     delete output_;
 }
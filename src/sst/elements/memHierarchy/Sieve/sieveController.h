@@ -55,7 +55,10 @@ public:
             {"debug",                   "(uint) Print debug information. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",             "(uint) Debugging/verbosity level. Between 0 and 10", "0"},
             {"output_file",             "(string) Name of file to output malloc information to. Will have sequence number (and optional marker number) and .txt appended to it. E.g. sieveMallocRank-3.txt", "sieveMallocRank"},
-            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"} )
+            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true.", "0"},
+            {"output_format",           "(string) Format of the malloc miss profiles. 'text' writes one file per dump. 'binary' appends every dump to a single file, <output_file>.bin, as it is made. See sieveController.h for the record layout.", "text"},
+            {"output_interval",         "(uint) Also dump the malloc miss profiles every this many accesses, so long runs stream their profiles without buoys. 0 dumps only at buoys and at the end of simulation.", "0"},
+            {"set_sample_fraction",     "(float) Fraction of the cache's sets to model. The sieve models one set in every round(1/fraction), which must divide the number of sets. Accesses to other sets are not modeled. Hit and miss counts (statistics and per-malloc counts) are scaled up to estimate the full cache.", "1.0"} )
 
     SST_ELI_DOCUMENT_PORTS(
             {"cpu_link_%(port)d", "Ports connected to the CPUs", {"memHierarchy.MemEventBase"}},
@@ -67,7 +70,8 @@ public:
             {"WriteHits",   "Number of write requests that hit in the sieve", "count", 1},
             {"WriteMisses", "Number of write requests that missed in the sieve", "count", 1},
             {"UnassociatedReadMisses", "Number of read misses that did not match a malloc", "count", 1},
-            {"UnassociatedWriteMisses", "Number of write misses that did not match a malloc", "count", 1} )
+            {"UnassociatedWriteMisses", "Number of write misses that did not match a malloc", "count", 1},
+            {"SampledAccesses", "Number of accesses to modeled sets (all accesses unless set_sample_fraction is less than 1)", "count", 1} )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"profiler", "(string) Name of profiling subcomponent. Currently only configured to work with cassini.AddrHistogrammer.", "SST::MemHierarchy::CacheListener"} )
 
@@ -88,6 +92,29 @@ public:
         return baseAddr;
     }
 
+    /* Layout of the binary profile file (output_format = binary), in host byte order:
+     *   SieveProfileHeader, once
+     *   then per dump: SieveProfileDump, followed by 'entries' SieveProfileEntry records
+     * Counts are already scaled by the set sampling period. */
+    struct SieveProfileHeader {
+        char     magic[8];      // "SSTSIEVE"
+        uint32_t version;
+        uint32_t lineSize;
+        uint64_t samplePeriod;  // 1 if every set is modeled
+        uint64_t flags;         // SIEVE_PROFILE_RESET if counts restart at zero after each dump, else dumps are cumulative
+    };
+    static const uint64_t SIEVE_PROFILE_RESET = 0x1;
+    struct SieveProfileDump {
+        uint64_t sequence;      // Same sequence number a text dump would have in its file name
+        int64_t  marker;        // Buoy marker, -1 for the end of simulation and interval dumps
+        uint64_t entries;
+    };
+    struct SieveProfileEntry {
+        uint64_t mallocID;
+        uint64_t readMisses;
+        uint64_t writeMisses;
+    };
+
 private:
     struct mallocEntry {
         uint64_t id;    // ID assigned by ariel
@@ -113,6 +140,22 @@ private:
 
     void recordMiss(Addr addr, bool isRead);
 
+    /** Set sampling. Returns whether the line at baseAddr is in a modeled set and, if so, the address to use in the (smaller) cache array */
+    bool sampleSet(Addr baseAddr, Addr& arrayAddr) {
+        if (samplePeriod_ == 1) {
+            arrayAddr = baseAddr;
+            return true;
+        }
+        Addr line = baseAddr / lineSize_;
+        Addr set = line % numSets_;
+        if (set % samplePeriod_ != 0)
+            return false;
+        arrayAddr = ((line / numSets_) * (numSets_ / samplePeriod_) + set / samplePeriod_) * lineSize_;
+        return true;
+    }
+    uint64_t samplePeriod_;
+    uint64_t numSets_;
+
     /** Destructor for Sieve Component */
     ~Sieve();
 
@@ -129,7 +172,12 @@ private:
 
     /** output and clear stats to file  */
     void outputStats(int marker);
+    void writeBinaryStats(int marker);
     bool resetStatsOnOutput;
+    bool binaryOutput_;
+    FILE* binaryFile_;
+    uint64_t outputInterval_;
+    uint64_t accessCount_;
 
     CacheArray<SharedCacheLine>* cacheArray_;
     Output*             output_;
@@ -146,6 +194,7 @@ private:
     Statistic<uint64_t>* statWriteMisses;
     Statistic<uint64_t>* statUnassocReadMisses;
     Statistic<uint64_t>* statUnassocWriteMisses;
+    Statistic<uint64_t>* statSampledAccesses;
 
 };
 
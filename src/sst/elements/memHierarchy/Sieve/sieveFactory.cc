@@ -20,6 +20,8 @@
 
 #include <sst_config.h>
 #include <sst/core/params.h>
+#include <cstdio>
+#include <cstring>
 #include "../util.h"
 #include "../hash.h"
 #include "sieveController.h"
@@ -57,6 +59,17 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
     uint64_t cacheSize = ua.getRoundedValue();
     uint64_t numLines = cacheSize/lineSize_;
 
+    /* Set sampling: model one set in every samplePeriod_ and scale the counts by samplePeriod_ */
+    double sampleFraction = params.find<double>("set_sample_fraction", 1.0);
+    if (sampleFraction <= 0.0 || sampleFraction > 1.0)
+        output_->fatal(CALL_INFO, -1, "Invalid param: set_sample_fraction - must be greater than 0 and at most 1. You specified: %f\n", sampleFraction);
+    samplePeriod_ = (uint64_t)(1.0 / sampleFraction + 0.5);
+    numSets_ = associativity > 0 ? numLines / associativity : 0;
+    if (samplePeriod_ != 1 && (numSets_ == 0 || numSets_ % samplePeriod_ != 0))
+        output_->fatal(CALL_INFO, -1, "Invalid param: set_sample_fraction - the sieve models one set in every %" PRIu64 " but that does not divide the number of sets (%" PRIu64 ")\n",
+                samplePeriod_, numSets_);
+    numLines /= samplePeriod_;
+
     /* ---------------- Initialization ----------------- */
     HashFunction* ht = loadAnonymousSubComponent<HashFunction>("memHierarchy.hash.none", "hash", 0, ComponentInfo::SHARE_NONE, params);
     ReplacementPolicy* replManager = loadUserSubComponent<ReplacementPolicy>("replacement", ComponentInfo::SHARE_NONE, numLines, associativity);
@@ -75,6 +88,30 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
 
     resetStatsOnOutput = params.find<bool>("reset_stats_at_buoy", 0) != 0;
 
+    string format = params.find<std::string>("output_format", "text");
+    if (format != "text" && format != "binary")
+        output_->fatal(CALL_INFO, -1, "Invalid param: output_format - must be 'text' or 'binary'. You specified: %s\n", format.c_str());
+    binaryOutput_ = (format == "binary");
+    binaryFile_ = nullptr;
+    if (binaryOutput_) {
+        string binName = outFileName + ".bin";
+        binaryFile_ = fopen(binName.c_str(), "wb");
+        if (!binaryFile_)
+            output_->fatal(CALL_INFO, -1, "%s, Error: unable to open %s for writing\n", getName().c_str(), binName.c_str());
+        SieveProfileHeader header;
+        memcpy(header.magic, "SSTSIEVE", sizeof(header.magic));
+        header.version = 2;
+        header.lineSize = lineSize_;
+        header.samplePeriod = samplePeriod_;
+        header.flags = 0;
+        if (resetStatsOnOutput)
+            header.flags |= SIEVE_PROFILE_RESET;
+        if (fwrite(&header, sizeof(header), 1, binaryFile_) != 1)
+            output_->fatal(CALL_INFO, -1, "%s, Error: failed to write %s\n", getName().c_str(), binName.c_str());
+    }
+    outputInterval_ = params.find<uint64_t>("output_interval", 0);
+    accessCount_ = 0;
+
     // optional link for allocation / free tracking
     configureLinks();
 
@@ -88,6 +125,7 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
     statWriteMisses = registerStatistic<uint64_t>("WriteMisses");
     statUnassocReadMisses   = registerStatistic<uint64_t>("UnassociatedReadMisses");
     statUnassocWriteMisses  = registerStatistic<uint64_t>("UnassociatedWriteMisses");
+    statSampledAccesses     = registerStatistic<uint64_t>("SampledAccesses");
 }
 
 void Sieve::configureLinks() {
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+# Print the malloc miss profiles from a Sieve binary profile file
+# (output_format = binary), one dump at a time, in the same
+# "mallocID reads writes" form as the text output.
+#
+#   ./sieve-profile-reader.py sieveMallocRank.bin
+#   ./sieve-profile-reader.py --total sieveMallocRank.bin    (totals for the whole run)
+#
+# Dumps are cumulative unless the run set reset_stats_at_buoy, in which case
+# each dump holds only the misses since the previous one.
+#
+# The file may still be growing; a partial dump at the end is ignored.
+import argparse
+import struct
+import sys
+
+header_fmt = "=8sIIQ"   # magic, version, line size, sample period
+flags_fmt = "=Q"        # flags
+reset_flag = 0x1        # counts restart at zero after each dump
+dump_fmt = "=QqQ"       # sequence, marker, entries
+entry_fmt = "=QQQ"      # malloc ID, read misses, write misses
+
+def read_dumps(f):
+    header = f.read(struct.calcsize(header_fmt))
+    if len(header) < struct.calcsize(header_fmt):
+        sys.exit("Truncated header")
+    magic, version, lineSize, period = struct.unpack(header_fmt, header)
+    if magic != b"SSTSIEVE" or version != 2:
+        sys.exit("Not a Sieve profile (version 2) file")
+    data = f.read(struct.calcsize(flags_fmt))
+    if len(data) < struct.calcsize(flags_fmt):
+        sys.exit("Truncated header")
+    flags, = struct.unpack(flags_fmt, data)
+    yield (lineSize, period, flags)
+    while True:
+        data = f.read(struct.calcsize(dump_fmt))
+        if len(data) < struct.calcsize(dump_fmt):
+            return
+        sequence, marker, count = struct.unpack(dump_fmt, data)
+        size = struct.calcsize(entry_fmt)
+        data = f.read(count * size)
+        if len(data) < count * size:
+            return
+        yield (sequence, marker, [ struct.unpack_from(entry_fmt, data, i * size) for i in range(count) ])
+
+parser = argparse.ArgumentParser()
+parser.add_argument("file")
+parser.add_argument("--total", help="print one table of totals for the whole run (the last dump, or the sum of all dumps if counts were reset after each dump)", action="store_true")
+args = parser.parse_args()
+
+with open(args.file, "rb") as f:
+    dumps = read_dumps(f)
+    lineSize, period, flags = next(dumps)
+    print("#Line size %d, one set in %d modeled" % (lineSize, period))
+    totals = {}
+    for sequence, marker, entries in dumps:
+        if args.total:
+            if not flags & reset_flag:
+                totals = {}     # cumulative: the latest dump already holds the totals
+            for mallocID, reads, writes in entries:
+                r, w = totals.get(mallocID, (0, 0))
+                totals[mallocID] = (r + reads, w + writes)
+            continue
+        print("#Dump %d, marker %d" % (sequence, marker))
+        print("#Printing allocation memory accesses (mallocID, reads, writes):")
+        for mallocID, reads, writes in entries:
+            print("%d %d %d" % (mallocID, reads, writes))
+    if args.total:
+        print("#Printing allocation memory accesses (mallocID, reads, writes):")
+        for mallocID in sorted(totals):
+            print("%d %d %d" % (mallocID, totals[mallocID][0], totals[mallocID][1]))
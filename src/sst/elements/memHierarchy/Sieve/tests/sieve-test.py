@@ -1,5 +1,13 @@
 import sst
 import os
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--set_sample_fraction", help="fraction of the sieve's sets to model", default="1.0")
+parser.add_argument("--output_format", help="malloc profile format", choices=["text", "binary"], default="text")
+parser.add_argument("--output_file", help="malloc profile file name", default="mallocRank.txt")
+parser.add_argument("--output_interval", help="also dump the malloc profile every this many accesses", default="0")
+args = parser.parse_args()
 
 #set the number of threads
 os.environ['OMP_NUM_THREADS']="16"
@@ -50,7 +58,10 @@ sieveId.addParams({
     "cache_size": "8MB",
     "associativity": 16,
     "cache_line_size": 64,
-    "output_file" : "mallocRank.txt"
+    "output_file" : args.output_file,
+    "output_format" : args.output_format,
+    "output_interval" : args.output_interval,
+    "set_sample_fraction" : args.set_sample_fraction,
 })    
 
 for x in range(corecount):
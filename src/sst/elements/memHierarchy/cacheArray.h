@@ -17,6 +17,11 @@
 #define CACHEARRAY_H
 
 #include <vector>
+#include <new>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
 
 #include <sst/core/output.h>
 
@@ -50,11 +55,17 @@ class CacheArray {
         Addr            sliceStep_; // For cache slices
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
+        T*              lineStore_; // Backing storage if lines are allocated contiguously, otherwise null
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+
+        /** Constructor for derived arrays; if contiguous, all lines are placed in one set-major allocation */
+        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool contiguous);
+
     public:
 
-        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
+        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
+            CacheArray(dbg, numLines, associativity, lineSize, replacementMgr, hash, false) { }
 
         /** Destructor - Delete all cache line objects */
         virtual ~CacheArray();
@@ -74,16 +85,16 @@ class CacheArray {
 
         /** Function returns the cacheline if found, otherwise a null pointer.
             If updateReplacement is set, the replacement stats are updated */
-        T * lookup(Addr addr, bool updateReplacement);
+        virtual T * lookup(Addr addr, bool updateReplacement);
 
         /** Identify a replacement candidate using the replacement manager */
-        T * findReplacementCandidate(Addr addr);
+        virtual T * findReplacementCandidate(Addr addr);
 
         /** Replace a line with address 'addr' and update its replacement info */
-        void replace(Addr addr, T* candidate);
+        virtual void replace(Addr addr, T* candidate);
 
         /** Deallocate a line and notify replacement manager that it's been deallocated */
-        void deallocate(T* candidate);
+        virtual void deallocate(T* candidate);
 
     /**** Configuration and output */
         void setSliceAware(Addr size, Addr step);
@@ -91,11 +102,119 @@ class CacheArray {
         void printCacheArray(Output &out);
 };
 
+/*
+ * Cache array variant for large, highly-associative arrays
+ * Lines are allocated contiguously in set-major order and a dense copy
+ * of each set's tags is kept so that lookups compare all ways of a set
+ * without touching the line objects (using SIMD compares where available).
+ * The tag copy is maintained by replace(), which is the only place a line's
+ * address changes.
+ */
+template <class T>
+class DenseCacheArray : public CacheArray<T> {
+    public:
+        DenseCacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
+        virtual ~DenseCacheArray() { }
+
+        T * lookup(Addr addr, bool updateReplacement) override;
+        void replace(Addr addr, T* candidate) override;
+
+    protected:
+        /** Return the index of the line that holds addr or -1 */
+        int findIndex(Addr addr);
+
+        std::vector<Addr> tags_; // tags_[set * associativity + way]
+
+    private:
+        /** Return the way in [tags, tags + ways) that holds addr or -1 */
+        static int matchWay(const Addr* tags, unsigned int ways, Addr addr);
+};
+
+/*
+ * Dense cache array with a built-in LRU policy
+ * Picks the same victims as replacement.lru, or as replacement.lru-opt if CoherenceAware,
+ * without a ReplacementPolicy subcomponent or any virtual calls on the lookup/replace path.
+ * Each set keeps a packed recency rank per way: 0 is the most recently used and
+ * 'unused_' (= associativity) marks ways that were never used or were replaced, which is
+ * the equivalent of the subcomponents' zero timestamp. AgeT must be able to hold associativity.
+ * CoherenceAware requires a line type whose ReplacementInfo is a CoherenceReplacementInfo.
+ */
+template <class T, bool CoherenceAware, typename AgeT>
+class LRUCacheArray : public DenseCacheArray<T> {
+    public:
+        LRUCacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, HashFunction* hash) :
+            DenseCacheArray<T>(dbg, numLines, associativity, lineSize, nullptr, hash), unused_(associativity) {
+            ages_.resize(this->numLines_, unused_);
+        }
+        virtual ~LRUCacheArray() { }
+
+        T * lookup(Addr addr, bool updateReplacement) override;
+        T * findReplacementCandidate(Addr addr) override;
+        void replace(Addr addr, T* candidate) override;
+        void deallocate(T* candidate) override;
+
+    private:
+        /** Make line 'index' the most recently used in its set */
+        void touch(unsigned int index);
+
+        /** Mark line 'index' as unused (oldest) */
+        void demote(unsigned int index);
+
+        const AgeT unused_;
+        std::vector<AgeT> ages_; // ages_[set * associativity + way]
+};
+
+/*
+ * Returns a specialized LRU array for the line type if one exists, otherwise null so
+ * that the caller falls back to a CacheArray with a ReplacementPolicy subcomponent.
+ * Specialized for the line types used by the coherence managers; L1CacheLine carries no
+ * coherence replacement info so only plain LRU is available for it.
+ */
+template <class T>
+struct SpecializedLRUArray {
+    static CacheArray<T> * create(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, HashFunction* hash, bool coherenceAware) {
+        return nullptr;
+    }
+};
+
+template <class T, bool CoherenceAware>
+CacheArray<T> * createLRUCacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, HashFunction* hash) {
+    if (associativity < 256)
+        return new LRUCacheArray<T, CoherenceAware, uint8_t>(dbg, numLines, associativity, lineSize, hash);
+    if (associativity < 65536)
+        return new LRUCacheArray<T, CoherenceAware, uint16_t>(dbg, numLines, associativity, lineSize, hash);
+    return nullptr;
+}
+
+template <>
+struct SpecializedLRUArray<L1CacheLine> {
+    static CacheArray<L1CacheLine> * create(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, HashFunction* hash, bool coherenceAware) {
+        if (coherenceAware) return nullptr;
+        return createLRUCacheArray<L1CacheLine, false>(dbg, numLines, associativity, lineSize, hash);
+    }
+};
+
+template <>
+struct SpecializedLRUArray<SharedCacheLine> {
+    static CacheArray<SharedCacheLine> * create(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, HashFunction* hash, bool coherenceAware) {
+        if (coherenceAware) return createLRUCacheArray<SharedCacheLine, true>(dbg, numLines, associativity, lineSize, hash);
+        return createLRUCacheArray<SharedCacheLine, false>(dbg, numLines, associativity, lineSize, hash);
+    }
+};
+
+template <>
+struct SpecializedLRUArray<PrivateCacheLine> {
+    static CacheArray<PrivateCacheLine> * create(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, HashFunction* hash, bool coherenceAware) {
+        if (coherenceAware) return createLRUCacheArray<PrivateCacheLine, true>(dbg, numLines, associativity, lineSize, hash);
+        return createLRUCacheArray<PrivateCacheLine, false>(dbg, numLines, associativity, lineSize, hash);
+    }
+};
+
 /************* Function definitions *****************/
 
 template <class T>
-CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
-    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
+CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool contiguous) :
+    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash), lineStore_(nullptr) {
 
     // Error check parameters
     if (numLines_ == 0)
@@ -121,19 +240,25 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
     sliceSize_ = 1;
     banks_ = 1;
 
-    for (unsigned int i = 0; i < numLines_; i++) {
-        lines_[i] = new T(lineSize_, i);
+    if (contiguous) {
+        lineStore_ = static_cast<T*>(::operator new(sizeof(T) * numLines_));
+        for (unsigned int i = 0; i < numLines_; i++)
+            lines_[i] = new (&lineStore_[i]) T(lineSize_, i);
+    } else {
+        for (unsigned int i = 0; i < numLines_; i++) {
+            lines_[i] = new T(lineSize_, i);
+        }
     }
 
     // Construct rInfo
+    rInfo.resize(numSets_);
     for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
+        rInfo[i].reserve(associativity);
         for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
+            rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
     }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
-    if (!replacementMgr_->checkCompatibility(info))
+    ReplacementInfo * info = rInfo[0].front();
+    if (replacementMgr_ && !replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
 
     setStates = new State[associativity_];
@@ -141,8 +266,14 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
 
 template <class T>
 CacheArray<T>::~CacheArray() {
-    for (size_t i = 0; i < lines_.size(); i++)
-        delete lines_[i];
+    if (lineStore_) {
+        for (size_t i = 0; i < lines_.size(); i++)
+            lines_[i]->~T();
+        ::operator delete(lineStore_);
+    } else {
+        for (size_t i = 0; i < lines_.size(); i++)
+            delete lines_[i];
+    }
     delete replacementMgr_;
     delete hash_;
     delete [] setStates;
@@ -199,6 +330,160 @@ void CacheArray<T>::deallocate(T* candidate) {
     candidate->reset();
 }
 
+template <class T>
+DenseCacheArray<T>::DenseCacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
+    CacheArray<T>(dbg, numLines, associativity, lineSize, replacementMgr, hash, true) {
+
+    tags_.resize(this->numLines_);
+    for (unsigned int i = 0; i < this->numLines_; i++)
+        tags_[i] = this->lines_[i]->getAddr();
+}
+
+template <class T>
+int DenseCacheArray<T>::matchWay(const Addr* tags, unsigned int ways, Addr addr) {
+    unsigned int i = 0;
+#if defined(__AVX2__)
+    __m256i key = _mm256_set1_epi64x((long long)addr);
+    for (; i + 4 <= ways; i += 4) {
+        __m256i cmp = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + i)), key);
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#elif defined(__SSE4_1__)
+    __m128i key = _mm_set1_epi64x((long long)addr);
+    for (; i + 2 <= ways; i += 2) {
+        __m128i cmp = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)(tags + i)), key);
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(cmp));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+#endif
+    for (; i < ways; i++) {
+        if (tags[i] == addr)
+            return i;
+    }
+    return -1;
+}
+
+template <class T>
+int DenseCacheArray<T>::findIndex(const Addr addr) {
+    Addr laddr = this->toLineAddr(addr);
+    unsigned int setBegin = (this->hash_->hash(0, laddr) % this->numSets_) * this->associativity_;
+
+    int way = matchWay(&tags_[setBegin], this->associativity_, addr);
+    return way < 0 ? -1 : (int)(setBegin + way);
+}
+
+template <class T>
+T* DenseCacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
+    int index = findIndex(addr);
+    if (index < 0)
+        return nullptr; // Not found
+
+    if (updateReplacement)
+        this->replacementMgr_->update(index, this->lines_[index]->getReplacementInfo());
+    return this->lines_[index];
+}
+
+template <class T>
+void DenseCacheArray<T>::replace(Addr addr, T* candidate) {
+    CacheArray<T>::replace(addr, candidate);
+    tags_[candidate->getIndex()] = addr;
+}
+
+template <class T, bool CoherenceAware, typename AgeT>
+void LRUCacheArray<T, CoherenceAware, AgeT>::touch(unsigned int index) {
+    AgeT* ages = &ages_[index - (index % this->associativity_)];
+    AgeT old = ages_[index];
+    for (unsigned int i = 0; i < this->associativity_; i++)
+        ages[i] += (ages[i] < old);
+    ages_[index] = 0;
+}
+
+template <class T, bool CoherenceAware, typename AgeT>
+void LRUCacheArray<T, CoherenceAware, AgeT>::demote(unsigned int index) {
+    AgeT old = ages_[index];
+    if (old == unused_)
+        return;
+    AgeT* ages = &ages_[index - (index % this->associativity_)];
+    for (unsigned int i = 0; i < this->associativity_; i++)
+        ages[i] -= (ages[i] > old && ages[i] != unused_);
+    ages_[index] = unused_;
+}
+
+template <class T, bool CoherenceAware, typename AgeT>
+T* LRUCacheArray<T, CoherenceAware, AgeT>::lookup(const Addr addr, bool updateReplacement) {
+    int index = this->findIndex(addr);
+    if (index < 0)
+        return nullptr; // Not found
+
+    if (updateReplacement)
+        touch(index);
+    return this->lines_[index];
+}
+
+/* Same criteria and tie-breaking as LRU/LRUOpt::findBestCandidate:
+ * invalid lines first, then (if coherence aware) not shared, then not owned, then oldest.
+ * State is read from the ReplacementInfo rather than the line to match the subcomponents exactly. */
+template <class T, bool CoherenceAware, typename AgeT>
+T* LRUCacheArray<T, CoherenceAware, AgeT>::findReplacementCandidate(Addr addr) {
+    Addr laddr = this->toLineAddr(addr);
+    unsigned int set = this->hash_->hash(0, laddr) % this->numSets_;
+    unsigned int setBegin = set * this->associativity_;
+    std::vector<ReplacementInfo*>& info = this->rInfo[set];
+    const AgeT* ages = &ages_[setBegin];
+
+    if (info[0]->getState() == I)
+        return this->lines_[setBegin];
+
+    unsigned int best = 0;
+    bool bestShared = false, bestOwned = false;
+    if (CoherenceAware) {
+        bestShared = static_cast<CoherenceReplacementInfo*>(info[0])->getShared();
+        bestOwned = static_cast<CoherenceReplacementInfo*>(info[0])->getOwned();
+    }
+
+    for (unsigned int i = 1; i < this->associativity_; i++) {
+        if (info[i]->getState() == I)
+            return this->lines_[setBegin + i];
+
+        if (CoherenceAware) {
+            bool shared = static_cast<CoherenceReplacementInfo*>(info[i])->getShared();
+            bool owned = static_cast<CoherenceReplacementInfo*>(info[i])->getOwned();
+            if (shared != bestShared) {
+                if (shared) continue;
+            } else if (owned != bestOwned) {
+                if (owned) continue;
+            } else if (ages[i] <= ages[best]) {
+                continue;
+            }
+            bestShared = shared;
+            bestOwned = owned;
+            best = i;
+        } else if (ages[i] > ages[best]) {
+            best = i;
+        }
+    }
+    return this->lines_[setBegin + best];
+}
+
+template <class T, bool CoherenceAware, typename AgeT>
+void LRUCacheArray<T, CoherenceAware, AgeT>::replace(Addr addr, T* candidate) {
+    unsigned int index = candidate->getIndex();
+    demote(index);
+    candidate->reset();
+    candidate->setAddr(addr);
+    touch(index);
+    this->tags_[index] = addr;
+}
+
+template <class T, bool CoherenceAware, typename AgeT>
+void LRUCacheArray<T, CoherenceAware, AgeT>::deallocate(T* candidate) {
+    demote(candidate->getIndex());
+    candidate->reset();
+}
+
 template <class T>
 void CacheArray<T>::setSliceAware(Addr size, Addr step) {
     sliceSize_ = size >> lineOffset_;
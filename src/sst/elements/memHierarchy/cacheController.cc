@@ -37,6 +37,7 @@ using namespace SST::MemHierarchy;
 /* Handle incoming event on the cache links */
 void Cache::handleEvent(SST::Event * ev) {
     MemEventBase* event = static_cast<MemEventBase*>(ev);
+    HostProfiler::Scope prof(profiler_, profEvent_, event->getCmd());
     if (!clockIsOn_)
         turnClockOn();
 
@@ -72,6 +73,7 @@ void Cache::handlePrefetchEvent(SST::Event * ev) {
 /* Handle event from prefetch self link */
 void Cache::processPrefetchEvent(SST::Event * ev) {
     MemEvent * event = static_cast<MemEvent*>(ev);
+    HostProfiler::Scope prof(profiler_, profPrefetch_, event->getCmd());
     event->setBaseAddr(toBaseAddr(event->getAddr()));
     event->setRqstr(getName());
     event->setSrc(getName());
@@ -95,17 +97,20 @@ void Cache::processPrefetchEvent(SST::Event * ev) {
 
 /* Clock handler */
 bool Cache::clockTick(Cycle_t time) {
+    HostProfiler::Scope prof(profiler_, profClock_);
     timestamp_++;
 
     // Drain any outgoing messages
     bool idle = coherenceMgr_->sendOutgoingEvents();
 
+    bool linksIdle = true;
     if (clockUpLink_) {
-        idle &= linkUp_->clock();
+        linksIdle &= linkUp_->clock();
     }
     if (clockDownLink_) {
-        idle &= linkDown_->clock();
+        linksIdle &= linkDown_->clock();
     }
+    idle &= linksIdle;
 
     // MSHR occupancy
     statMSHROccupancy->addData(mshr_->getSize());
@@ -176,6 +181,13 @@ bool Cache::clockTick(Cycle_t time) {
         } else {
             statPrefetchDrop->addData(1);
             coherenceMgr_->removeRequestRecord(prefetchBuffer_.front()->getID());
+            // Tell the prefetchers so they can throttle
+            MemEvent* drop = static_cast<MemEvent*>(prefetchBuffer_.front());
+            CacheListenerNotification notify(drop->getAddr(), drop->getBaseAddr(), drop->getVirtualAddress(),
+                    drop->getInstructionPointer(), drop->getSize(), NotifyAccessType::PREFETCH, NotifyResultType::DROPPED);
+            for (size_t i = 0; i < listeners_.size(); i++)
+                listeners_[i]->notifyAccess(notify);
+            delete drop;
         }
         prefetchBuffer_.pop();
     }
@@ -193,6 +205,17 @@ bool Cache::clockTick(Cycle_t time) {
         return true;
     }
 
+    // If we are only waiting to send events, turn off until the cycle before the next is due
+    if (skipIdle_ && eventBuffer_.empty() && retryBuffer_.empty() && linksIdle) {
+        uint64_t next = coherenceMgr_->getNextDeliveryTime();
+        if (next > timestamp_ + 1) {
+            turnClockOff();
+            skipping_ = true;
+            skipSelfLink_->send(next - timestamp_ - 1, nullptr);
+            return true;
+        }
+    }
+
     // Keep the clock on
     return false;
 }
@@ -204,6 +227,10 @@ void Cache::turnClockOn() {
     coherenceMgr_->updateTimestamp(timestamp_);
     int64_t cyclesOff = timestamp_ - lastActiveClockCycle_;
     statMSHROccupancy->addDataNTimes(cyclesOff, mshr_->getSize());
+    if (skipping_) {
+        statCyclesSkipped->addData(cyclesOff);
+        skipping_ = false;
+    }
     //dbg_->debug(_L3_, "%s turning clock ON at cycle %" PRIu64 ", timestamp %" PRIu64 ", ns %" PRIu64 "\n", this->getName().c_str(), getCurrentSimCycle(), timestamp_, getCurrentSimTimeNano());
     clockIsOn_ = true;
 }
@@ -214,6 +241,12 @@ void Cache::turnClockOff() {
     lastActiveClockCycle_ = timestamp_;
 }
 
+/* Handler for skipSelfLink_. An earlier event may already have turned the clock back on */
+void Cache::skipWakeup(SST::Event * ev) {
+    if (!clockIsOn_)
+        turnClockOn();
+}
+
 /**************************************************************************
  * Event processing
  **************************************************************************/
@@ -228,6 +261,8 @@ void Cache::turnClockOff() {
  *   Returns: whether event was accepted/can be popped off event queue
  */
 bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
+    HostProfiler::Scope prof(profiler_, profProcess_, ev->getCmd());
+
     // Global noncacheable request flag
     if (allNoncacheableRequests_) {
         ev->setFlag(MemEvent::F_NONCACHEABLE);
@@ -536,6 +571,7 @@ void Cache::finish() {
         listeners_[i]->printStats(*out_);
     linkDown_->finish();
     if (linkUp_ != linkDown_) linkUp_->finish();
+    profiler_.print(*out_, getName());
 }
 
 
@@ -35,6 +35,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 namespace SST { namespace MemHierarchy {
 
@@ -69,6 +70,7 @@ public:
             {"noninclusive_directory_entries", "(uint) Number of entries in the directory. Must be at least 1 if the non-inclusive directory exists.", "0"},
             {"noninclusive_directory_associativity", "(uint) For a set-associative directory, number of ways.", "1"},
             {"mshr_num_entries",        "(int) Number of MSHR entries. Not valid for L1s because L1 MSHRs assumed to be sized for the CPU's load/store queue. Setting this to -1 will create a very large MSHR.", "-1"},
+            {"mshr_storage",            "(string) MSHR storage layout. Options: map[ordered map], flat[open-addressed table sized from mshr_num_entries with pooled entries]", "map"},
             {"tag_access_latency_cycles",
                 "(uint) Latency (in cycles) to access tag portion only of cache. Paid by misses and coherence requests that don't need data. If not specified, defaults to access_latency_cycles","access_latency_cycles"},
             {"mshr_latency_cycles",
@@ -89,6 +91,10 @@ public:
             {"cache_line_size",         "(uint) Size of a cache line [aka cache block] in bytes.", "64"},
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
+            {"array_layout",            "(string) Cache array layout. Options: default[line objects allocated individually], dense[contiguous set-major lines with a dense per-set tag array, best for large highly-associative caches]", "default"},
+            {"specialized_replacement", "(bool) Use a built-in version of the replacement policy instead of loading a replacement subcomponent, if one exists for this cache type. Currently 'lru'. Always uses the dense array layout. Victims are identical to the subcomponent.", "false"},
+            {"clock_skip_idle",         "(bool) When the only pending work is outgoing events waiting out their latency, turn the clock off and wake up with a self event when the next one is due instead of ticking every cycle. The cache stays clocked while it has events to process. Timing is identical to the always-clocked mode.", "false"},
+            {"host_profile",            "(bool) Measure host time spent in the event and clock handlers, per handler and per command, and print a 'HostProfile:' summary at the end of simulation.", "false"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
@@ -118,6 +124,7 @@ public:
             {"TotalEventsReplayed",     "Total number of events that were initially blocked and then were replayed", "events", 1},
             {"MSHR_occupancy",          "Number of events in MSHR each cycle", "events", 1},
             {"Bank_conflicts",          "Total number of bank conflicts detected", "count", 1},
+            {"Cycles_skipped",          "Number of cycles the clock was off while waiting to send an outgoing event (clock_skip_idle)", "cycles", 3},
             {"Prefetch_requests",       "Number of prefetches received from prefetcher at this cache", "events", 1},
             {"Prefetch_drops",          "Number of prefetches that were cancelled. Reasons: too many prefetches outstanding, cache can't handle prefetch this cycle, currently handling another event for the address.", "events", 1},
             /*Event receives */
@@ -240,6 +247,9 @@ private:
     void turnClockOn();
     void turnClockOff();
 
+    // Turn the clock back on after skipping idle cycles
+    void skipWakeup(SST::Event * ev);
+
     // Trigger timeouts if events sit in MSHR for too long
     void timeoutWakeup(SST::Event * ev);
     void checkTimeout();
@@ -258,6 +268,7 @@ private:
     MemLinkBase* linkDown_;                 // link manager down (towards memory)
     Link* prefetchSelfLink_;                // link to delay prefetch request receive
     Link* timeoutSelfLink_;                 // link to check for timeouts (possible deadlock)
+    Link* skipSelfLink_;                    // link to wake up after skipping idle cycles
     MSHR* mshr_;                            // MSHR
     CoherenceController* coherenceMgr_;     // Coherence protocol - where most of the event handling happens
 
@@ -280,6 +291,8 @@ private:
     bool                    clockUpLink_;   // Whether link actually needs clock() called or not
     bool                    clockDownLink_; // Whether link actually needs clock() called or not
     SimTime_t               lastActiveClockCycle_;  // Cycle we turned the clock off at - for re-syncing stats
+    bool                    skipIdle_;      // Whether to skip cycles while waiting on outgoing events
+    bool                    skipping_;      // Whether the clock is off because cycles are being skipped
 
     /** Cache state ************************************************************/
     uint64_t                    timestamp_;
@@ -297,9 +310,17 @@ private:
     Output*                 dbg_;
     std::set<Addr>          DEBUG_ADDR;
 
+    /** Host-time profile ******************************************************/
+    HostProfiler            profiler_;
+    unsigned                profEvent_;     // handleEvent()
+    unsigned                profPrefetch_;  // processPrefetchEvent()
+    unsigned                profClock_;     // clockTick()
+    unsigned                profProcess_;   // processEvent(), within clockTick()
+
     /** Statistics *************************************************************/
     Statistic<uint64_t>* statMSHROccupancy;
     Statistic<uint64_t>* statBankConflicts;
+    Statistic<uint64_t>* statCyclesSkipped;
 
     // Prefetch statistics
     Statistic<uint64_t>* statPrefetchRequest;
@@ -152,6 +152,8 @@ void Cache::createCoherenceManager(Params &params) {
     coherenceParams.insert("associativity", params.find<std::string>("associativity", "-1"));
     coherenceParams.insert("lines", params.find<std::string>("lines", "0"));
     coherenceParams.insert("replacement_policy", params.find<std::string>("replacement_policy", "lru"));
+    coherenceParams.insert("array_layout", params.find<std::string>("array_layout", "default"));
+    coherenceParams.insert("specialized_replacement", params.find<std::string>("specialized_replacement", "false"));
     coherenceParams.insert("dlines", params.find<std::string>("noninclusive_directory_entries", "0"));
     coherenceParams.insert("dassoc", params.find<std::string>("noninclusive_directory_associativity", "0"));
     coherenceParams.insert("drpolicy", params.find<std::string>("noninclusive_directory_repl", "lru"));
@@ -640,7 +642,12 @@ uint64_t Cache::createMSHR(Params &params, uint64_t accessLatency, bool L1) {
     if (mshrSize == 1 || mshrSize == 0)
         out_->fatal(CALL_INFO, -1, "Invalid param: mshr_num_entries - MSHR requires at least 2 entries to avoid deadlock. You specified %d\n", mshrSize);
 
-    mshr_ = loadComponentExtension<MSHR>(dbg_, mshrSize, getName(), DEBUG_ADDR);
+    std::string mshrStorage = params.find<std::string>("mshr_storage", "map");
+    to_lower(mshrStorage);
+    if (mshrStorage != "map" && mshrStorage != "flat")
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: mshr_storage - valid options are 'map' or 'flat'. You specified '%s'.\n", getName().c_str(), mshrStorage.c_str());
+
+    mshr_ = loadComponentExtension<MSHR>(dbg_, mshrSize, getName(), DEBUG_ADDR, mshrStorage == "flat");
 
     if (mshrLatency > 0 && found)
         return mshrLatency;
@@ -728,6 +735,20 @@ void Cache::createClock(Params &params) {
     timestamp_ = 0;
     lastActiveClockCycle_ = 0;
 
+    // Skip cycles where the cache is only waiting to send events
+    skipIdle_ = params.find<bool>("clock_skip_idle", false);
+    skipping_ = false;
+    skipSelfLink_ = nullptr;
+    if (skipIdle_)
+        skipSelfLink_ = configureSelfLink("skipwakeup", defaultTimeBase_, new Event::Handler<Cache>(this, &Cache::skipWakeup));
+
+    // Host-time profiling
+    profiler_.enable(params.find<bool>("host_profile", false));
+    profEvent_ = profiler_.addHandler("handleEvent");
+    profPrefetch_ = profiler_.addHandler("processPrefetchEvent");
+    profClock_ = profiler_.addHandler("clockTick");
+    profProcess_ = profiler_.addHandler("processEvent");
+
     // Deadlock timeout
     timeout_ = params.find<SimTime_t>("maxRequestDelay", 0);
     if (timeout_ > 0) {
@@ -794,4 +815,5 @@ void Cache::registerStatistics() {
 
     statMSHROccupancy               = registerStatistic<uint64_t>("MSHR_occupancy");
     statBankConflicts               = registerStatistic<uint64_t>("Bank_conflicts");
+    statCyclesSkipped               = registerStatistic<uint64_t>("Cycles_skipped");
 }
@@ -36,7 +36,8 @@ class Output;
 namespace MemHierarchy {
 
     enum NotifyAccessType{ READ, WRITE, EVICT, PREFETCH };
-    enum NotifyResultType{ HIT, MISS, NA };
+    /* DROPPED: a prefetch the cache did not accept because of max_outstanding_prefetch or drop_prefetch_mshr_level (access type PREFETCH) */
+    enum NotifyResultType{ HIT, MISS, NA, DROPPED };
 
 class CacheListenerNotification {
 public:
@@ -143,10 +143,9 @@ public:
         // Cache Array
         uint64_t lines = params.find<uint64_t>("lines");
         uint64_t assoc = params.find<uint64_t>("associativity");
-        ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, true);
         HashFunction * ht = createHashFunction(params);
 
-        cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<PrivateCacheLine>(lines, assoc, ht, params, true);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         stat_eventState[(int)Command::GetS][I] = registerStatistic<uint64_t>("stateEvent_GetS_I");
@@ -203,10 +203,9 @@ public:
         // Cache Array
         uint64_t lines = params.find<uint64_t>("lines", 0);
         uint64_t assoc = params.find<uint64_t>("associativity", 0);
-        ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, true);
         HashFunction * ht = createHashFunction(params);
 
-        cacheArray_ = new CacheArray<L1CacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<L1CacheLine>(lines, assoc, ht, params, true);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         // Register statistics
@@ -227,9 +227,8 @@ public:
         uint64_t lines = params.find<uint64_t>("lines");
         uint64_t assoc = params.find<uint64_t>("associativity");
 
-        ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = createCacheArray<PrivateCacheLine>(lines, assoc, ht, params, false);
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         stat_evict[I] =      registerStatistic<uint64_t>("evict_I");
@@ -275,16 +275,14 @@ public:
         uint64_t lines = params.find<uint64_t>("lines");
         uint64_t assoc = params.find<uint64_t>("associativity");
 
-        ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        dataArray_ = new CacheArray<DataLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        dataArray_ = createCacheArray<DataLine>(lines, assoc, ht, params, false);
         dataArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         uint64_t dLines = params.find<uint64_t>("dlines");
         uint64_t dAssoc = params.find<uint64_t>("dassoc");
         params.insert("replacement_policy", params.find<std::string>("drpolicy", "lru"));
-        ReplacementPolicy *drmgr = createReplacementPolicy(dLines, dAssoc, params, false, 1);
-        dirArray_ = new CacheArray<DirectoryLine>(debug, dLines, dAssoc, lineSize_, drmgr, ht);
+        dirArray_ = createCacheArray<DirectoryLine>(dLines, dAssoc, ht, params, false, 1);
         dirArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         /* Statistics */
@@ -18,6 +18,8 @@
 
 #include "coherencemgr/coherenceController.h"
 
+#include <limits>
+
 using namespace SST;
 using namespace SST::MemHierarchy;
 
@@ -394,6 +396,16 @@ bool CoherenceController::checkIdle() {
     return outgoingEventQueueDown_.empty() && outgoingEventQueueUp_.empty();
 }
 
+/* The queue fronts hold the earliest sendable events since an event never passes the one ahead of it */
+uint64_t CoherenceController::getNextDeliveryTime() {
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    if (!outgoingEventQueueDown_.empty())
+        next = outgoingEventQueueDown_.front().deliveryTime;
+    if (!outgoingEventQueueUp_.empty())
+        next = std::min(next, outgoingEventQueueUp_.front().deliveryTime);
+    return next;
+}
+
 
 /* Forward an event using memory address to locate a destination. */
 void CoherenceController::forwardByAddress(MemEventBase * event) {
@@ -32,6 +32,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/hash.h"
+#include "sst/elements/memHierarchy/cacheArray.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -110,6 +111,9 @@ public:
     /* Check whether the event queues are empty/subcomponent is doing anything */
     bool checkIdle();
 
+    /* Earliest delivery time in the outgoing queues (UINT64_MAX if empty) */
+    uint64_t getNextDeliveryTime();
+
     /* Get which bank an address maps to (call through to cache array) */
     virtual Addr getBank(Addr addr) = 0;
 
@@ -253,6 +257,34 @@ protected:
     ReplacementPolicy * createReplacementPolicy(uint64_t lines, uint64_t assoc, Params& params, bool L1, int slotnum = 0);
     HashFunction * createHashFunction(Params& params);
 
+    /* Create a cache array with the layout given by the 'array_layout' parameter and a replacement policy
+     * from the 'replacement' slot or 'replacement_policy' parameter (see createReplacementPolicy).
+     * If 'specialized_replacement' is set and the policy has a built-in version for this line type,
+     * the array implements the policy itself and no ReplacementPolicy is loaded. */
+    template <class T>
+    CacheArray<T> * createCacheArray(uint64_t lines, uint64_t assoc, HashFunction* ht, Params& params, bool L1, int slotnum = 0) {
+        std::string layout = params.find<std::string>("array_layout", "default");
+        to_lower(layout);
+        if (layout != "default" && layout != "dense")
+            output->fatal(CALL_INFO, -1, "%s, Invalid param: array_layout - supported layouts are 'default' and 'dense'. You specified '%s'.\n", getName().c_str(), layout.c_str());
+
+        SubComponentSlotInfo* rslots = getSubComponentSlotInfo("replacement");
+        if (params.find<bool>("specialized_replacement", false) && !(rslots && rslots->isPopulated(slotnum))) {
+            std::string policy = params.find<std::string>("replacement_policy", "lru");
+            to_lower(policy);
+            CacheArray<T> * array = nullptr;
+            if (policy == "lru")
+                array = SpecializedLRUArray<T>::create(debug, lines, assoc, lineSize_, ht, !L1);
+            if (array)
+                return array;
+        }
+
+        ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, L1, slotnum);
+        if (layout == "dense")
+            return new DenseCacheArray<T>(debug, lines, assoc, lineSize_, rmgr, ht);
+        return new CacheArray<T>(debug, lines, assoc, lineSize_, rmgr, ht);
+    }
+
     /*********************************************************************************
      * Data members
      *********************************************************************************/
@@ -47,6 +47,11 @@ using namespace SST::MemHierarchy;
 CoherentMemController::CoherentMemController(ComponentId_t id, Params &params) : MemController(id, params) {
     directory_ = false; /* Updated during init */
     timestamp_ = 0;
+
+    skipIdle_ = params.find<bool>("clock_skip_idle", false);
+    skipSelfLink_ = nullptr;
+    if (skipIdle_)
+        skipSelfLink_ = configureSelfLink("skipwakeup", clockTimeBase_, new Event::Handler<CoherentMemController>(this, &CoherentMemController::skipWakeup));
 }
 
 /**
@@ -99,21 +104,21 @@ void CoherentMemController::processInitEvent(MemEventInit* me) {
  * msgQueue holds events generated in CoherentMemController
  *   such as shootdowns and nack retries
  * Other events are issued immediately from handleMemResponse(...)
- * 'timestamp_' is used to delay events in the queue and does not need to be sync'd with 'cycle' when the clock is reenabled
+ * 'timestamp_' is used to delay events in the queue and is re-sync'd with the clock cycle when the clock is reenabled
  */
 bool CoherentMemController::clock(Cycle_t cycle) {
     timestamp_++;
 
     bool debug = false;
-    while (!msgQueue_.empty() && msgQueue_.begin()->first < timestamp_) {
-        MemEventBase * sendEv = msgQueue_.begin()->second;
+    while (msgQueue_.ready(timestamp_ - 1)) {
+        MemEventBase * sendEv = msgQueue_.front();
 
         if (is_debug_event(sendEv)) {
             Debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
                     getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), sendEv->getVerboseString(dlevel).c_str());
         }
         link_->send(sendEv);
-        msgQueue_.erase(msgQueue_.begin());
+        msgQueue_.pop();
     }
 
     /* Unclock if nothing is in clocked queues anywhere (link, backend, here) */
@@ -128,9 +133,35 @@ bool CoherentMemController::clock(Cycle_t cycle) {
         return true;
     }
 
+    /* If only msgQueue_ is waiting, turn off until the cycle before its next event is due.
+     * An event at time t is sent by the tick that moves timestamp_ to t+1 */
+    if (skipIdle_ && unclockLink && unclockBack) {
+        uint64_t next = msgQueue_.nextTime();
+        if (next > timestamp_ + 1) {
+            memBackendConvertor_->turnClockOff();
+            clockOn_ = false;
+            skipSelfLink_->send(next - timestamp_, nullptr);
+            return true;
+        }
+    }
+
     return false;
 }
 
+Cycle_t CoherentMemController::turnClockOn() {
+    Cycle_t cycle = MemController::turnClockOn();
+    timestamp_ = cycle;
+    return cycle;
+}
+
+/* Handler for skipSelfLink_. An earlier event may already have turned the clock back on */
+void CoherentMemController::skipWakeup(SST::Event * ev) {
+    if (!clockOn_) {
+        Cycle_t cycle = turnClockOn();
+        memBackendConvertor_->turnClockOn(cycle);
+    }
+}
+
 
 /*
  * Link handler, overrides MemController's
@@ -459,7 +490,7 @@ void CoherentMemController::handleNack(MemEvent * ev) {
         uint64_t backoff = (0x1 << retries);
         nackedEvent->incrementRetries();
 
-        msgQueue_.insert(std::make_pair(timestamp_ + backoff, nackedEvent));
+        msgQueue_.insert(timestamp_ + backoff, nackedEvent);
     } else {
         delete nackedEvent;
     }
@@ -514,7 +545,7 @@ bool CoherentMemController::doShootdown(Addr addr, MemEventBase * ev) {
         inv->copyMetadata(ev);
         inv->setDst(ev->getSrc());
 
-        msgQueue_.insert(std::make_pair(timestamp_, inv)); /* Send on next clock. TODO timing needed? */
+        msgQueue_.insert(timestamp_, inv); /* Send on next clock. TODO timing needed? */
         return true;
     }
     return false;
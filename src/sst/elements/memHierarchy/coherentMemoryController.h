@@ -30,6 +30,7 @@
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
 #include "sst/elements/memHierarchy/membackend/backing.h"
 
 namespace SST {
@@ -41,7 +42,8 @@ public:
     SST_ELI_REGISTER_COMPONENT(CoherentMemController, "memHierarchy", "CoherentMemController", SST_ELI_ELEMENT_VERSION(1,0,0),
             "Coherent memory controller, supports cache shootdowns and interfaces to a main memory model for timing", COMPONENT_CATEGORY_MEMORY)
 
-    SST_ELI_DOCUMENT_PARAMS( MEMCONTROLLER_ELI_PARAMS )
+    SST_ELI_DOCUMENT_PARAMS( MEMCONTROLLER_ELI_PARAMS,
+            {"clock_skip_idle", "(bool) When the only pending work is shootdowns or nack retries waiting out their delay, turn the clock off and wake up with a self event when the next one is due instead of ticking every cycle. Timing is identical to the always-clocked mode.", "false"} )
 
     SST_ELI_DOCUMENT_PORTS( MEMCONTROLLER_ELI_PORTS )
 
@@ -66,6 +68,8 @@ protected:
 
     virtual bool clock(Cycle_t cycle);
 
+    virtual Cycle_t turnClockOn();
+
 private:
 
     CoherentMemController();
@@ -81,6 +85,9 @@ private:
 
     bool doShootdown(Addr addr, MemEventBase * ev);
 
+    // Turn the clock back on after skipping idle cycles
+    void skipWakeup(SST::Event * ev);
+
     void finishMemReq(SST::Event::id_type id, uint32_t flags);
     void finishCustomReq(SST::Event::id_type id, uint32_t flags);
 
@@ -93,7 +100,9 @@ private:
 
     // Outgoing event handling
     Cycle_t timestamp_;
-    std::multimap<uint64_t, MemEventBase*> msgQueue_;
+    TimingWheel<MemEventBase*> msgQueue_;
+    bool skipIdle_;             // Whether to turn the clock off while msgQueue_ waits on a future delivery time
+    Link* skipSelfLink_;        // Wakes the clock when the next msgQueue_ event is due
 
     // Caching information
     bool directory_; /* Whether directory is above us, i.e., whether a PutM indicates block is no longer cached or not */
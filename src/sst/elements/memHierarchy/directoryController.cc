@@ -299,8 +299,15 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
     if (!memLink)
         memLink = cpuLink;
 
-    // TODO implement the cache properly using the cacheArray
     entryCacheMaxSize = params.find<uint64_t>("entry_cache_size", 32768);
+    entryCacheAssoc = params.find<uint64_t>("entry_cache_associativity", 0);
+    if (entryCacheAssoc == 0 || entryCacheAssoc > entryCacheMaxSize)
+        entryCacheAssoc = entryCacheMaxSize;
+    entryCacheSets = entryCacheMaxSize ? entryCacheMaxSize / entryCacheAssoc : 0;
+    if (entryCacheMaxSize && (entryCacheMaxSize % entryCacheAssoc) != 0)
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): entry_cache_size must be a multiple of entry_cache_associativity. Got %" PRIu64 " and %" PRIu64 "\n",
+                getName().c_str(), entryCacheMaxSize, entryCacheAssoc);
+    entryCache.resize(entryCacheSets);
     entryCacheSize = 0;
     entrySize = 4; // Bytes, TODO parameterize
 
@@ -311,11 +318,26 @@ DirectoryController::DirectoryController(ComponentId_t id, Params &params) :
 
     int mshrSize    = params.find<int>("mshr_num_entries",-1);
     if (mshrSize == 0) dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_num_entries - must be at least 1 or else negative to indicate an unlimited size MSHR\n", getName().c_str());
-    mshr                = loadComponentExtension<MSHR>(&dbg, mshrSize, getName(), DEBUG_ADDR);
+    string mshrStorage  = params.find<std::string>("mshr_storage", "map");
+    to_lower(mshrStorage);
+    if (mshrStorage != "map" && mshrStorage != "flat")
+        dbg.fatal(CALL_INFO, -1, "Invalid param(%s): mshr_storage - must be 'map' or 'flat'. You specified: %s\n", getName().c_str(), mshrStorage.c_str());
+    mshr                = loadComponentExtension<MSHR>(&dbg, mshrSize, getName(), DEBUG_ADDR, mshrStorage == "flat");
+
+    /* Host-time profiling */
+    profiler.enable(params.find<bool>("host_profile", false));
+    profPacket = profiler.addHandler("handlePacket");
+    profClock = profiler.addHandler("clock");
+    profProcess = profiler.addHandler("processPacket");
 
     /* Get latencies */
     accessLatency   = params.find<uint64_t>("access_latency_cycles", 0);
     mshrLatency     = params.find<uint64_t>("mshr_latency_cycles", 0);
+
+    /* Size the send queues to cover the usual delivery delays */
+    size_t queueSlots = std::max(accessLatency, mshrLatency) + 2;
+    cpuMsgQueue = TimingWheel<MemEventBase*>(queueSlots);
+    memMsgQueue = TimingWheel<MemMsg>(queueSlots);
 }
 
 
@@ -331,6 +353,7 @@ DirectoryController::~DirectoryController(){
 
 void DirectoryController::handlePacket(SST::Event *event){
     MemEventBase *evb = static_cast<MemEventBase*>(event);
+    HostProfiler::Scope prof(profiler, profPacket, evb->getCmd());
     evb->setDeliveryTime(getCurrentSimTimeNano());
     if (!clockOn) {
         turnClockOn();
@@ -362,6 +385,7 @@ void DirectoryController::handlePacket(SST::Event *event){
  *  Called each cycle. Handle any waiting events in the queue.
  */
 bool DirectoryController::clock(SST::Cycle_t cycle){
+    HostProfiler::Scope prof(profiler, profClock);
     timestamp = cycle;
     stat_MSHROccupancy->addData(mshr->getSize());
 
@@ -428,6 +452,7 @@ bool DirectoryController::clock(SST::Cycle_t cycle){
 
 
 bool DirectoryController::processPacket(MemEvent * ev, bool replay) {
+    HostProfiler::Scope prof(profiler, profProcess, ev->getCmd());
     bool dbgevent = false;
     if (is_debug_event(ev)) {
         fflush(stdout);
@@ -601,7 +626,7 @@ void DirectoryController::printStatus(Output &statusOut) {
 
     statusOut.output("  Directory entries:\n");
     for (std::unordered_map<Addr, DirEntry*>::iterator it = directory.begin(); it != directory.end(); it++) {
-        statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString().c_str());
+        statusOut.output("    0x%" PRIx64 " %s\n", it->first, it->second->getString(endpointNames).c_str());
     }
     statusOut.output("End MemHierarchy::DirectoryController\n\n");
 }
@@ -705,11 +730,19 @@ void DirectoryController::init(unsigned int phase) {
 
 void DirectoryController::finish(void){
     cpuLink->finish();
+    profiler.print(out, getName());
 }
 
 
 
 void DirectoryController::setup(void){
+    /* Assign sharer IDs to the known sources in name order so that sharers are visited in the same order as before */
+    std::set<std::string> sources;
+    for (auto& src : *(cpuLink->getSources()))
+        sources.insert(src.name);
+    for (auto& name : sources)
+        getEndpointID(name);
+
     cpuLink->setup();
     if (cpuLink != memLink)
         memLink->setup();
@@ -736,7 +769,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -762,7 +795,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
                         mshr->clearData(addr);
                     } else {
                         entry->setState(S);
-                        entry->addSharer(event->getSrc());
+                        entry->addSharer(getEndpointID(event->getSrc()));
                         sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                     }
                     if (is_debug_event(event)) {
@@ -785,7 +818,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
         case S:
             if (mshr->hasData(addr)) { // saved from earlier request
                 if (incoherentSrc.find(event->getSrc()) == incoherentSrc.end()) {
-                    entry->addSharer(event->getSrc());
+                    entry->addSharer(getEndpointID(event->getSrc()));
                 }
                 sendDataResponse(event, entry, mshr->getData(addr), Command::GetSResp);
                 if (is_debug_event(event)) {
@@ -822,7 +855,7 @@ bool DirectoryController::handleGetS(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -848,7 +881,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -892,12 +925,12 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
             // Upgrade request and no other sharers -> respond & M
             // Upgrade request and other sharers -> invalidate other sharers & S_Inv
             // Otherwise need data & invalidate sharers -> invalidate other sharers, request data from Memory, SM_Inv
-            if (entry->isSharer(event->getSrc())) { // Don't need data
+            if (entry->isSharer(getEndpointID(event->getSrc()))) { // Don't need data
                 if (entry->getSharerCount() == 1) { // Also don't need to invalidate
                     if (mshr->hasData(addr))
                         mshr->clearData(addr);
                     entry->setState(M);
-                    entry->removeSharer(event->getSrc());
+                    entry->removeSharer(getEndpointID(event->getSrc()));
                     entry->setOwner(event->getSrc());
                     sendResponse(event);
                     if (is_debug_event(event)) {
@@ -951,7 +984,7 @@ bool DirectoryController::handleGetX(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     if (status == MemEventStatus::Reject)
@@ -976,7 +1009,7 @@ bool DirectoryController::handleWrite(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1041,7 +1074,7 @@ bool DirectoryController::handleWrite(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     if (status == MemEventStatus::Reject)
@@ -1064,7 +1097,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1090,7 +1123,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
                     entry->removeOwner();
-                    entry->addSharer(event->getSrc());
+                    entry->addSharer(getEndpointID(event->getSrc()));
                     mshr->setData(addr, event->getPayload(), event->getDirty());
                     event->setEvict(false);
                 } else if (entry->hasOwner()) {
@@ -1105,7 +1138,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_Inv:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(getEndpointID(event->getSrc()));
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 event->setEvict(false);
                 entry->setState(S_Inv);
@@ -1114,7 +1147,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
         case M_InvX:
             if (event->getEvict()) {
                 entry->removeOwner();
-                entry->addSharer(event->getSrc());
+                entry->addSharer(getEndpointID(event->getSrc()));
                 mshr->setData(addr, event->getPayload(), event->getDirty());
                 entry->setState(S);
                 mshr->decrementAcksNeeded(addr);
@@ -1132,7 +1165,7 @@ bool DirectoryController::handleFlushLine(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -1153,7 +1186,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1171,7 +1204,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
         case S:
             if (status == MemEventStatus::OK) {
                 if (event->getEvict()) {
-                    entry->removeSharer(event->getSrc());
+                    entry->removeSharer(getEndpointID(event->getSrc()));
                     event->setEvict(false);
                 }
 
@@ -1203,7 +1236,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_D:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrc()));
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(IS);
@@ -1211,7 +1244,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_B:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrc()));
                 event->setEvict(false);
                 if (!entry->hasSharers())
                     entry->setState(I);
@@ -1233,7 +1266,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SD_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrc()));
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1245,7 +1278,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case SM_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrc()));
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1256,7 +1289,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case S_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrc()));
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1268,7 +1301,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
             break;
         case M_Inv:
             if (event->getEvict()) {
-                entry->removeSharer(event->getSrc());
+                entry->removeSharer(getEndpointID(event->getSrc()));
                 event->setEvict(false);
                 responses.find(addr)->second.erase(event->getSrc());
                 if (responses.find(addr)->second.empty()) responses.erase(addr);
@@ -1288,7 +1321,7 @@ bool DirectoryController::handleFlushLineInv(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -1307,7 +1340,7 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1315,7 +1348,7 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
     if (!inMSHR)
         stat_cacheHits->addData(1);
 
-    entry->removeSharer(event->getSrc());
+    entry->removeSharer(getEndpointID(event->getSrc()));
     sendAckPut(event);
 
     if (responses.find(addr) != responses.end() && responses.find(addr)->second.find(event->getSrc()) != responses.find(addr)->second.end()) {
@@ -1366,7 +1399,7 @@ bool DirectoryController::handlePutS(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     if (update)
@@ -1389,7 +1422,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1398,7 +1431,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
         stat_cacheHits->addData(1);
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(getEndpointID(event->getSrc()));
 
     sendAckPut(event);
 
@@ -1429,7 +1462,7 @@ bool DirectoryController::handlePutX(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     cleanUpAfterRequest(event, inMSHR);
@@ -1451,7 +1484,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1484,7 +1517,7 @@ bool DirectoryController::handlePutE(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     cleanUpAfterRequest(event, inMSHR);
@@ -1506,7 +1539,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1540,7 +1573,7 @@ bool DirectoryController::handlePutM(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     cleanUpAfterRequest(event, inMSHR);
@@ -1564,7 +1597,7 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1654,7 +1687,7 @@ bool DirectoryController::handleFetchInv(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     if (status == MemEventStatus::Reject)
@@ -1678,7 +1711,7 @@ bool DirectoryController::handleForceInv(MemEvent * event, bool inMSHR) {
         bool ret = retrieveDirEntry(entry, event, inMSHR); 
         if (is_debug_addr(addr)) {
             eventDI.newst = entry->getState();
-            eventDI.verboseline = entry->getString();
+            eventDI.verboseline = entry->getString(endpointNames);
         }
         return ret;
     }
@@ -1763,7 +1796,7 @@ bool DirectoryController::handleForceInv(MemEvent * event, bool inMSHR) {
         sendNACK(event);
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -1788,7 +1821,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
     }
     if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
         entry->setState(S);
-        entry->addSharer(reqEv->getSrc());
+        entry->addSharer(getEndpointID(reqEv->getSrc()));
     } else if (state == IS) {
         entry->setState(I);
     } else {
@@ -1801,7 +1834,7 @@ bool DirectoryController::handleGetSResp(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -1832,7 +1865,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
         case S_D:
             entry->setState(S);
             if (incoherentSrc.find(reqEv->getSrc()) == incoherentSrc.end()) {
-                entry->addSharer(reqEv->getSrc());
+                entry->addSharer(getEndpointID(reqEv->getSrc()));
             }
             sendDataResponse(reqEv, entry, event->getPayload(), Command::GetSResp);
             mshr->setData(addr, event->getPayload(), false); // So subsequent GetS can get data
@@ -1851,7 +1884,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
             mshr->setData(addr, event->getPayload(), false); // Save data for when the invalidations finish
             if (is_debug_addr(addr)) {
                 eventDI.newst = entry->getState();
-                eventDI.verboseline = entry->getString();
+                eventDI.verboseline = entry->getString(endpointNames);
             }
             delete event;
             return true;
@@ -1863,7 +1896,7 @@ bool DirectoryController::handleGetXResp(MemEvent * event, bool inMSHR) {
     cleanUpAfterResponse(event, inMSHR);
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -1891,7 +1924,7 @@ bool DirectoryController::handleWriteResp(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -1924,7 +1957,7 @@ bool DirectoryController::handleFlushLineResp(MemEvent * event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     sendResponse(reqEv, event->getFlags(), event->getMemFlags());
@@ -1942,7 +1975,7 @@ bool DirectoryController::handleAckPut(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     cleanUpAfterResponse(event, inMSHR);
@@ -1958,8 +1991,8 @@ bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
     if (is_debug_addr(addr))
         eventDI.prefill(event->getID(), Command::AckInv, false, addr, state);
 
-    if (entry->isSharer(event->getSrc()))
-        entry->removeSharer(event->getSrc());
+    if (entry->isSharer(getEndpointID(event->getSrc())))
+        entry->removeSharer(getEndpointID(event->getSrc()));
     else
         entry->removeOwner();
 
@@ -2000,7 +2033,7 @@ bool DirectoryController::handleAckInv(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -2025,7 +2058,7 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
     mshr->setData(addr, event->getPayload(), event->getDirty());       // Save data for retry
 
     entry->removeOwner();
-    entry->addSharer(event->getSrc());
+    entry->addSharer(getEndpointID(event->getSrc()));
     entry->setState(S);
     retryBuffer.push_back(static_cast<MemEvent*>(mshr->getFrontEvent(addr)));
 
@@ -2033,7 +2066,7 @@ bool DirectoryController::handleFetchXResp(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -2070,7 +2103,7 @@ bool DirectoryController::handleFetchResp(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -2116,7 +2149,7 @@ bool DirectoryController::handleNACK(MemEvent* event, bool inMSHR) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
 
     return true;
@@ -2155,7 +2188,7 @@ bool DirectoryController::handleDirEntryResponse(MemEvent* event) {
 
     if (is_debug_addr(addr)) {
         eventDI.newst = entry->getState();
-        eventDI.verboseline = entry->getString();
+        eventDI.verboseline = entry->getString(endpointNames);
     }
     return true;
 }
@@ -2170,13 +2203,22 @@ DirectoryController::DirEntry* DirectoryController::getDirEntry(Addr addr) {
     if (directory.end() == i) {
         directory[addr] = new DirEntry(addr);
         i = directory.find(addr);
-        i->second->cacheIter = entryCache.end();
         i->second->setCached(true);
 
     }
     return i->second;
 }
 
+uint32_t DirectoryController::getEndpointID(const std::string& name) {
+    std::unordered_map<std::string, uint32_t>::iterator it = endpointIDs.find(name);
+    if (it != endpointIDs.end())
+        return it->second;
+    uint32_t id = endpointNames.size();
+    endpointNames.push_back(name);
+    endpointIDs.insert(std::make_pair(name, id));
+    return id;
+}
+
 bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR) {
     MemEventStatus status = inMSHR ? MemEventStatus::OK : allocateMSHR(event, false);
     if (status == MemEventStatus::Reject)
@@ -2212,7 +2254,7 @@ bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, boo
     uint64_t deliveryTime = timestamp + accessLatency;
 
     // Bypass destination lookup 
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 
     return true;
 }
@@ -2274,37 +2316,41 @@ void DirectoryController::cleanUpAfterResponse(MemEvent * event, bool inMSHR) {
     }
 }
 
-void DirectoryController::updateCache(DirEntry * entry) { // TODO replace with a proper cache!
+void DirectoryController::updateCache(DirEntry * entry) {
     if (0 == entryCacheMaxSize) {
         sendEntryToMemory(entry);
-    } else {
-        if (entry->cacheIter != entryCache.end()) {
-            entryCache.erase(entry->cacheIter);
-            --entryCacheSize;
-            entry->cacheIter = entryCache.end();
-        }
+        return;
+    }
 
-        if (entry->getState() == I) {
-            directory.erase(entry->getBaseAddr());
-            delete entry;
-            return;
-        } else  {
-            entryCache.push_front(entry);
-            entry->cacheIter = entryCache.begin();
-            ++entryCacheSize;
-
-            while (entryCacheSize > entryCacheMaxSize) {
-                DirEntry * oldEntry = entryCache.back();
-                if (mshr->exists(oldEntry->getBaseAddr()))
-                    break;
+    std::list<DirEntry*>& set = entryCache[(entry->getBaseAddr() / lineSize) % entryCacheSets];
+    if (entry->inEntryCache) {
+        set.erase(entry->cacheIter);
+        --entryCacheSize;
+        entry->inEntryCache = false;
+    }
 
-                entryCache.pop_back();
-                --entryCacheSize;
-                oldEntry->cacheIter = entryCache.end();
-                oldEntry->setCached(false);
-                sendEntryToMemory(oldEntry);
-            }
-        }
+    if (entry->getState() == I) {
+        directory.erase(entry->getBaseAddr());
+        delete entry;
+        return;
+    }
+
+    set.push_front(entry);
+    entry->cacheIter = set.begin();
+    entry->inEntryCache = true;
+    ++entryCacheSize;
+
+    /* Evict least recently used entries until the set fits or its LRU entry is in use */
+    while (set.size() > entryCacheAssoc) {
+        DirEntry * oldEntry = set.back();
+        if (mshr->exists(oldEntry->getBaseAddr()))
+            break;
+
+        set.pop_back();
+        --entryCacheSize;
+        oldEntry->inEntryCache = false;
+        oldEntry->setCached(false);
+        sendEntryToMemory(oldEntry);
     }
 }
 
@@ -2316,7 +2362,7 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
 
     uint64_t deliveryTime = timestamp + accessLatency;
     me->setDst(memLink->getTargetDestination(0));
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 }
 
 /****************************
@@ -2376,10 +2422,11 @@ void DirectoryController::issueFetch(MemEvent* event, DirEntry* entry, Command c
 void DirectoryController::issueInvalidations(MemEvent* event, DirEntry* entry, Command cmd) {
     std::string rqstr = (event->getSrc());
 
-    for (set<std::string>::iterator it = entry->getSharers()->begin(); it != entry->getSharers()->end(); it++) {
-        if (*it == rqstr) continue;
-        issueInvalidation(*it, event, entry, cmd);
-    }
+    uint32_t rqstrID = getEndpointID(rqstr);
+    entry->forEachSharer([&](uint32_t id) {
+        if (id != rqstrID)
+            issueInvalidation(endpointNames[id], event, entry, cmd);
+    });
 }
 
 void DirectoryController::issueInvalidation(std::string dst, MemEvent* event, DirEntry* entry, Command cmd) {
@@ -2490,8 +2537,8 @@ void DirectoryController::sendNACK(MemEvent * event) {
 void DirectoryController::sendOutgoingEvents() {
 
     bool debugLine = false;
-    while (!cpuMsgQueue.empty() && cpuMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = cpuMsgQueue.begin()->second;
+    while (cpuMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = cpuMsgQueue.front();
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
@@ -2506,18 +2553,18 @@ void DirectoryController::sendOutgoingEvents() {
         }
         stat_eventSent[(int)ev->getCmd()]->addData(1);
         cpuLink->send(ev);
-        cpuMsgQueue.erase(cpuMsgQueue.begin());
+        cpuMsgQueue.pop();
     }
 
-    while (!memMsgQueue.empty() && memMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = memMsgQueue.begin()->second.event;
+    while (memMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = memMsgQueue.front().event;
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
                     getCurrentSimCycle(), timestamp, getName().c_str(), ev->getBriefString().c_str());
         }
 
-        if (memMsgQueue.begin()->second.dirAccess) {
+        if (memMsgQueue.front().dirAccess) {
             if (ev->getCmd() == Command::GetS)
                 stat_dirEntryReads->addData(1);
             else
@@ -2526,7 +2573,7 @@ void DirectoryController::sendOutgoingEvents() {
             stat_eventSent[(int)ev->getCmd()]->addData(1);
         }
         memLink->send(ev);
-        memMsgQueue.erase(memMsgQueue.begin());
+        memMsgQueue.pop();
     }
 
 }
@@ -2538,12 +2585,12 @@ void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool d
     std::string dst = memLink->findTargetDestination(ev->getRoutingAddress());
     if (dst != "") { /* Common case */
         ev->setDst(dst);
-        memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
+        memMsgQueue.insert(ts, MemMsg(ev, dirAccess));
     } else {
         dst = cpuLink->findTargetDestination(ev->getRoutingAddress());
         if (dst != "") {
             ev->setDst(dst);
-            cpuMsgQueue.insert(std::make_pair(ts, ev));
+            cpuMsgQueue.insert(ts, ev);
         } else {
             std::string availableDests = "cpulink:\n" + cpuLink->getAvailableDestinationsAsString();
             if (cpuLink != memLink) availableDests = availableDests + "memlink:\n" + memLink->getAvailableDestinationsAsString();
@@ -2558,9 +2605,9 @@ void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool d
  */
 void DirectoryController::forwardByDestination(MemEventBase* ev, Cycle_t ts, bool dirAccess) {
     if (cpuLink->isReachable(ev->getDst())) {
-        cpuMsgQueue.insert(std::make_pair(ts, ev));
+        cpuMsgQueue.insert(ts, ev);
     } else if (memLink->isReachable(ev->getDst())) {
-        memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
+        memMsgQueue.insert(ts, MemMsg(ev, dirAccess));
     } else {
         out.fatal(CALL_INFO, -1, "%s, Error: Destination %s appears unreachable on both links. Event: %s\n",
                 getName().c_str(), ev->getDst().c_str(), ev->getVerboseString(dlevel).c_str());
@@ -37,6 +37,8 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 using namespace std;
 
@@ -51,6 +53,7 @@ public:
     SST_ELI_DOCUMENT_PARAMS(
             {"clock",                   "Clock rate of controller.", "1GHz"},
             {"entry_cache_size",        "Size (in # of entries) the controller will cache.", "0"},
+            {"entry_cache_associativity", "Associativity of the entry cache. 0 for fully associative.", "0"},
             {"debug",                   "Where to send debug output. 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},
             {"debug_level",             "Debugging level: 0 to 10. Must configure sst-core with '--enable-debug'. 1=info, 2-10=debug output", "0"},
             {"debug_addr",              "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},
@@ -58,6 +61,7 @@ public:
             {"cache_line_size",         "Size of a cache line [aka cache block] in bytes.", "64"},
             {"coherence_protocol",      "Coherence protocol.  Supported --MESI, MSI--", "MESI"},
             {"mshr_num_entries",        "Number of MSHRs. Set to -1 for almost unlimited number.", "-1"},
+            {"mshr_storage",            "MSHR storage layout. Options: map[ordered map], flat[open-addressed table with pooled entries]", "map"},
             {"net_memory_name",         "For directories connected to a memory over the network: name of the memory this directory owns", ""},
             {"access_latency_cycles",   "Latency of directory access in cycles", "0"},
             {"mshr_latency_cycles",     "Latency of mshr access in cycles", "0"},
@@ -65,6 +69,7 @@ public:
             {"mem_addr_start",          "Starting memory address for the chunk of memory that this directory controller addresses.", "0"},
             {"addr_range_start",        "Lowest address handled by this directory.", "0"},
             {"addr_range_end",          "Highest address handled by this directory.", "uint64_t-1"},
+            {"host_profile",            "(bool) Measure host time spent in the event and clock handlers, per handler and per command, and print a 'HostProfile:' summary at the end of simulation.", "false"},
             {"interleave_size",         "Size of interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
             {"interleave_step",         "Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 directories, set size=8B, step=24B", "0B"},
             {"node",					"Node number in multinode environment"},
@@ -151,6 +156,12 @@ private:
     Output dbg;
     std::set<Addr> DEBUG_ADDR;
 
+    /* Host-time profile */
+    HostProfiler profiler;
+    unsigned profPacket;    // handlePacket()
+    unsigned profClock;     // clock()
+    unsigned profProcess;   // processPacket(), within clock()
+
     uint32_t    cacheLineSize;
 
     /* Range of addresses supported by this directory */
@@ -293,10 +304,12 @@ private:
 
     struct DirEntry {
 	bool                cached;         // whether block is cached or not
+        bool                inEntryCache;   // whether entry occupies a way in the entry cache
+        std::list<DirEntry*>::iterator cacheIter; // position in its entry cache set, valid if inEntryCache
         Addr                addr;           // block address
         State               state;          // state
-        std::list<DirEntry*>::iterator cacheIter;
-	std::set<std::string> sharers;      // set of sharers for block
+        std::vector<uint64_t> sharers;      // bit-vector of sharers for block, indexed by endpoint ID
+        uint32_t            sharerCount;    // number of bits set in sharers
         std::string         owner;          // Owner of block
 
         DirEntry(Addr a) {
@@ -304,26 +317,27 @@ private:
             addr = a;
             state = I;
             cached = false;
+            inEntryCache = false;
         }
 
         void clearEntry(){
             cached = true;
             addr = 0;
-            sharers.clear();
+            clearSharers();
             owner = "";
         }
 
-        std::string getString() {
+        std::string getString(std::vector<std::string>& names) {
             std::ostringstream str;
             str << "State: " << StateString[state];
             str << " Sharers: [";
             bool comma = false;
-            for (std::set<std::string>::iterator it = sharers.begin(); it != sharers.end(); it++) {
+            forEachSharer([&](uint32_t id) {
                 if (comma)
                     str << ",";
-                str << *it;
+                str << names[id];
                 comma = true;
-            }
+            });
             str << "] Owner: " << owner;
             str << " Cached: " << (cached ? "y" : "n");
             return str.str();
@@ -335,19 +349,39 @@ private:
 
         Addr getBaseAddr() { return addr; }
 
-        size_t getSharerCount() { return sharers.size(); }
+        size_t getSharerCount() { return sharerCount; }
 
-        void clearSharers() { sharers.clear(); }
+        void clearSharers() { sharers.clear(); sharerCount = 0; }
 
-        void addSharer(std::string shr) { sharers.insert(shr); }
+        void addSharer(uint32_t id) {
+            if (id / 64 >= sharers.size())
+                sharers.resize(id / 64 + 1, 0);
+            uint64_t bit = 1ull << (id % 64);
+            if (!(sharers[id / 64] & bit)) {
+                sharers[id / 64] |= bit;
+                sharerCount++;
+            }
+        }
 
-        bool isSharer(std::string shr) { return sharers.find(shr) != sharers.end(); }
+        bool isSharer(uint32_t id) { return id / 64 < sharers.size() && (sharers[id / 64] & (1ull << (id % 64))); }
 
-        bool hasSharers() { return !(sharers.empty()); }
+        bool hasSharers() { return sharerCount != 0; }
 
-        std::set<std::string>* getSharers() { return &sharers; }
+        /* Call f(id) for each sharer in ID order */
+        template <typename F>
+        void forEachSharer(F f) {
+            for (size_t w = 0; w < sharers.size(); w++) {
+                for (uint64_t bits = sharers[w]; bits; bits &= bits - 1)
+                    f((uint32_t)(w * 64 + __builtin_ctzll(bits)));
+            }
+        }
 
-        void removeSharer(std::string shr) { sharers.erase(shr); }
+        void removeSharer(uint32_t id) {
+            if (isSharer(id)) {
+                sharers[id / 64] &= ~(1ull << (id % 64));
+                sharerCount--;
+            }
+        }
 
         std::string getOwner() { return owner; }
 
@@ -366,6 +400,7 @@ private:
     void printDebugInfo();
 
     DirEntry* getDirEntry(Addr addr); // find entry in the master list
+    uint32_t getEndpointID(const std::string& name); // ID of an endpoint in sharer bit-vectors, assigned on first use
     bool retrieveDirEntry(DirEntry* entry, MemEvent* event, bool inMSHR); // Simulate fetching entry from memory
 
     MemEventStatus allocateMSHR(MemEvent* event, bool fwdReq, int pos = -1);
@@ -407,13 +442,21 @@ private:
     void forwardByDestination(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
     void forwardByAddress(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
 
-    std::multimap<uint64_t,MemEventBase*>   cpuMsgQueue;
-    std::multimap<uint64_t,MemMsg>   memMsgQueue;
+    TimingWheel<MemEventBase*>  cpuMsgQueue;
+    TimingWheel<MemMsg>         memMsgQueue;
+
+    /* Sharer endpoint IDs */
+    std::vector<std::string> endpointNames;
+    std::unordered_map<std::string, uint32_t> endpointIDs;
 
+    /* Entry cache: set-associative, each set ordered MRU first. A set can temporarily hold more
+     * than entryCacheAssoc entries if its LRU entry has an MSHR entry */
     uint64_t    entryCacheMaxSize;
     uint64_t    entryCacheSize;
+    uint64_t    entryCacheAssoc;
+    uint64_t    entryCacheSets;
     uint32_t    entrySize;
-    std::list<DirEntry*> entryCache;
+    std::vector<std::list<DirEntry*> > entryCache;
 
     uint64_t lineSize;
 
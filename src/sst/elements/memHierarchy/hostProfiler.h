@@ -0,0 +1,117 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_HOSTPROFILER_H
+#define MEMHIERARCHY_HOSTPROFILER_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sst/core/output.h>
+
+#include "sst/elements/memHierarchy/memTypes.h"
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Host-time profile of a component's event and clock handlers
+ *
+ * Counts calls and host nanoseconds per handler and per Command. Components
+ * register their handlers once, then wrap each handler body in a Scope:
+ *   HostProfiler::Scope prof(profiler_, profClock_);
+ *   HostProfiler::Scope prof(profiler_, profEvent_, event->getCmd());
+ * Times are inclusive, so a handler called from another handler (e.g., the
+ * backend convertor under the memory controller) is counted in both.
+ *
+ * Profiling is off unless enabled with the component's 'host_profile' parameter;
+ * a disabled Scope costs one predictable branch. Building with
+ * MEMH_NO_HOST_PROFILE removes the instrumentation entirely.
+ *
+ * At finish(), print() writes one line per (handler, command) pair that was
+ * called, in a fixed format so that profiles from many components can be
+ * merged with a script (runBenchmarks.py groups them by component type):
+ *   HostProfile: <component> <handler> <command|-> <calls> <ns>
+ */
+class HostProfiler {
+public:
+    HostProfiler() : enabled_(false) { }
+
+    void enable(bool enable) { enabled_ = enable; }
+
+#ifdef MEMH_NO_HOST_PROFILE
+    bool enabled() const { return false; }
+#else
+    bool enabled() const { return enabled_; }
+#endif
+
+    /* Register a handler, returning the id to use with Scope */
+    unsigned addHandler(const std::string& name) {
+        handlers_.emplace_back(name);
+        return handlers_.size() - 1;
+    }
+
+    void record(unsigned handler, Command cmd, uint64_t ns) {
+        Handler& h = handlers_[handler];
+        h.calls[(int)cmd]++;
+        h.ns[(int)cmd] += ns;
+    }
+
+    void print(Output& out, const std::string& component) const {
+        if (!enabled())
+            return;
+        for (const Handler& h : handlers_) {
+            for (int i = 0; i <= (int)Command::LAST_CMD; i++) {
+                if (h.calls[i] == 0) continue;
+                out.output("HostProfile: %s %s %s %" PRIu64 " %" PRIu64 "\n", component.c_str(), h.name.c_str(),
+                        i == (int)Command::LAST_CMD ? "-" : CommandString[i], h.calls[i], h.ns[i]);
+            }
+        }
+    }
+
+    class Scope {
+    public:
+        /* LAST_CMD means the call is not for a particular command (e.g., a clock tick) */
+        Scope(HostProfiler& profiler, unsigned handler, Command cmd = Command::LAST_CMD) : profiler_(profiler), handler_(handler), cmd_(cmd) {
+            if (profiler_.enabled())
+                start_ = std::chrono::steady_clock::now();
+        }
+        ~Scope() {
+            if (profiler_.enabled())
+                profiler_.record(handler_, cmd_, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+        }
+        /* For handlers that only learn the command part way through */
+        void setCommand(Command cmd) { cmd_ = cmd; }
+    private:
+        HostProfiler& profiler_;
+        unsigned handler_;
+        Command cmd_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+private:
+    struct Handler {
+        Handler(const std::string& n) : name(n), calls((int)Command::LAST_CMD + 1, 0), ns((int)Command::LAST_CMD + 1, 0) { }
+        std::string name;
+        std::vector<uint64_t> calls;
+        std::vector<uint64_t> ns;
+    };
+
+    bool enabled_;
+    std::vector<Handler> handlers_;
+};
+
+}}
+
+#endif /* MEMHIERARCHY_HOSTPROFILER_H */
@@ -86,6 +86,45 @@ public:
 
 
 
+    /** Copy an event; the payload copy reuses a pooled buffer */
+    MemEvent(const MemEvent& ev) : MemEventBase(ev), size_(ev.size_), addr_(ev.addr_), baseAddr_(ev.baseAddr_), addrGlobal_(ev.addrGlobal_),
+        NACKedEvent_(ev.NACKedEvent_), retries_(ev.retries_), prefetch_(ev.prefetch_), dirty_(ev.dirty_), isEvict_(ev.isEvict_),
+        instPtr_(ev.instPtr_), vAddr_(ev.vAddr_) {
+        if (!ev.payload_.empty()) {
+            acquirePayload(ev.payload_.size());
+            payload_ = ev.payload_;
+        }
+    }
+
+    /** Return the payload buffer to the pool */
+    ~MemEvent() {
+        releasePayload();
+    }
+
+    /** Events are recycled through a per-thread free list instead of malloc/free */
+    static void* operator new(size_t size) {
+        if (size == sizeof(MemEvent) && eventPool().head) {
+            EventPool& pool = eventPool();
+            PoolBlock* block = pool.head;
+            pool.head = block->next;
+            pool.count--;
+            return block;
+        }
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) {
+        EventPool& pool = eventPool();
+        if (size == sizeof(MemEvent) && pool.count < EVENT_POOL_LIMIT) {
+            PoolBlock* block = static_cast<PoolBlock*>(ptr);
+            block->next = pool.head;
+            pool.head = block;
+            pool.count++;
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
     /** Create a new MemEvent instance, pre-configured to act as a NACK response */
     MemEvent* makeNACKResponse(MemEvent* NACKedEvent) {
         MemEvent *me      = new MemEvent(*this);
@@ -197,7 +236,10 @@ public:
     /** @return  the data payload. */
     dataVec& getPayload(void) {
         /* Lazily allocate space for payload */
-        if ( payload_.size() < size_ )  payload_.resize(size_);
+        if ( payload_.size() < size_ ) {
+            acquirePayload(size_);
+            payload_.resize(size_);
+        }
         return payload_;
     }
 
@@ -207,6 +249,7 @@ public:
      */
     void setPayload(std::vector<uint8_t>& data) {
         setSize(data.size());
+        acquirePayload(data.size());
         payload_ = data;
     }
 
@@ -216,16 +259,14 @@ public:
      */
     void setPayload(uint32_t size, uint8_t* data) {
         setSize(size);
-        payload_.resize(size);
-        for ( uint32_t i = 0 ; i < size ; i++ ) {
-            payload_[i] = data[i];
-        }
+        acquirePayload(size);
+        payload_.assign(data, data + size);
     }
 
     void setZeroPayload(uint32_t size) {
         setSize(size);
-        payload_.clear();
-        payload_.resize(size, 0);
+        acquirePayload(size);
+        payload_.assign(size, 0);
     }
 
     size_t getPayloadSize() override {
@@ -325,6 +366,55 @@ private:
 
     MemEvent() : MemEventBase() {} // For serialization only
 
+    /*
+     * Pooling
+     * Freed events are kept on an intrusive per-thread list. Payload buffers are kept
+     * separately, with their capacity, so that a recycled event carrying data (typically
+     * a cache line) does not have to allocate. Larger buffers (e.g., DMA) are freed normally.
+     * Neither pool is ever destroyed so events can safely be deleted during teardown.
+     */
+    static const size_t EVENT_POOL_LIMIT = 65536;
+    static const size_t PAYLOAD_POOL_LIMIT = 65536;
+    static const size_t PAYLOAD_POOL_MAX_BYTES = 4096;
+
+    struct PoolBlock { PoolBlock* next; };
+    struct EventPool {
+        PoolBlock* head;
+        size_t count;
+    };
+
+    static EventPool& eventPool() {
+        static thread_local EventPool pool = { nullptr, 0 };
+        return pool;
+    }
+
+    static std::vector<dataVec>& payloadPool() {
+        static thread_local std::vector<dataVec>* pool = new std::vector<dataVec>();
+        return *pool;
+    }
+
+    /* Give an event that has no payload buffer a pooled one */
+    void acquirePayload(size_t size) {
+        if (payload_.capacity() != 0 || size > PAYLOAD_POOL_MAX_BYTES)
+            return;
+        std::vector<dataVec>& pool = payloadPool();
+        if (pool.empty())
+            return;
+        payload_.swap(pool.back());
+        pool.pop_back();
+    }
+
+    void releasePayload() {
+        if (payload_.capacity() == 0 || payload_.capacity() > PAYLOAD_POOL_MAX_BYTES)
+            return;
+        std::vector<dataVec>& pool = payloadPool();
+        if (pool.size() < PAYLOAD_POOL_LIMIT) {
+            payload_.clear();
+            pool.emplace_back();
+            pool.back().swap(payload_);
+        }
+    }
+
 public:
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
         MemEventBase::serialize_order(ser);
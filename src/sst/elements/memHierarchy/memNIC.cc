@@ -57,6 +57,11 @@ MemNIC::MemNIC(ComponentId_t id, Params &params, TimeConverter* tc) : MemNICBase
     // Packet size
     packetHeaderBytes = extractPacketHeaderSize(params, "min_packet_size");
 
+    // Coalescing
+    batchMaxBits = 8 * extractPacketHeaderSize(params, "batch_max_size", "0B");
+    batchHeaderBits = 8 * extractPacketHeaderSize(params, "batch_header_size", "2B");
+    stat_coalesced = batchMaxBits ? registerStatistic<uint64_t>("events_coalesced") : nullptr;
+
     clockHandler = new Clock::Handler<MemNIC>(this, &MemNIC::clock);
     clockTC = registerClock(tc, clockHandler);
 }
@@ -83,15 +88,15 @@ bool MemNIC::clock(SimTime_t cycle) {
 bool MemNIC::recvNotify(int) {
     MemRtrEvent * mre = doRecv(link_control);
     if (mre) {
-        MemEventBase* ev = mre->takeEvent();
-        delete mre;
-        if (ev) {
+        // A coalesced request carries several events, deliver them in send order
+        while (MemEventBase* ev = mre->takeEvent()) {
             if (is_debug_event(ev)) {
                 dbg.debug(_L5_, "E: %-40" PRIu64 "  %-20s NIC:Recv      (%s)\n", 
                     getCurrentSimCycle(), getName().c_str(), ev->getBriefString().c_str());
             }
             (*recvHandler)(ev);
         }
+        delete mre;
     }
     return true;
 }
@@ -99,10 +104,14 @@ bool MemNIC::recvNotify(int) {
 
 /* Send event to memNIC */
 void MemNIC::send(MemEventBase *ev) {
+    uint64_t dest = lookupNetworkAddress(ev->getDst());
+    if (coalesce(ev, dest))
+        return;
+
     SimpleNetwork::Request *req = new SimpleNetwork::Request();
     MemRtrEvent * mre = new MemRtrEvent(ev);
     req->src = info.addr;
-    req->dest = lookupNetworkAddress(ev->getDst());
+    req->dest = dest;
     req->size_in_bits = getSizeInBits(ev);
     req->vn = 0;
 
@@ -121,6 +130,40 @@ void MemNIC::send(MemEventBase *ev) {
 }
 
 
+/*
+ * Coalesce an event into the request at the back of the send queue if it is going to the same
+ * destination and the combined request fits in batchMaxBits. The event moves into the request
+ * as-is so its payload is not copied. Only requests that are already waiting are extended so
+ * coalescing never delays an event that could have been sent on its own.
+ */
+bool MemNIC::coalesce(MemEventBase * ev, uint64_t dest) {
+    if (batchMaxBits == 0 || sendQueue.empty())
+        return false;
+
+    SimpleNetwork::Request * req = sendQueue.back();
+    size_t bits = batchHeaderBits + 8 * ev->getPayloadSize();
+    if (req->dest != dest || req->size_in_bits + bits > batchMaxBits)
+        return false;
+
+    MemRtrBatchEvent * batch = dynamic_cast<MemRtrBatchEvent*>(req->inspectPayload());
+    if (!batch) {
+        MemRtrEvent * mre = static_cast<MemRtrEvent*>(req->takePayload());
+        batch = new MemRtrBatchEvent(mre->takeEvent());
+        delete mre;
+        req->givePayload(batch);
+    }
+
+    if (is_debug_event(ev)) {
+        dbg.debug(_L5_, "N: %-40" PRI_NID "  %-20s Coalesce      Dst: %" PRI_NID ", bits: %zu, (%s)\n",
+            getCurrentSimCycle(), getName().c_str(), dest, bits, ev->getBriefString().c_str());
+    }
+
+    batch->addEvent(ev);
+    req->size_in_bits += bits;
+    stat_coalesced->addData(1);
+    return true;
+}
+
 /** Helper functions **/
 
 /* Calculate size in bits of an event */
@@ -138,6 +181,9 @@ void MemNIC::printStatus(Output &out) {
     while (!sendQueue.empty()) {
         MemEventBase * ev = static_cast<MemRtrEvent*>(sendQueue.front()->inspectPayload())->inspectEvent();
         out.output("      %s\n", ev->getVerboseString(out.getVerboseLevel()).c_str());
+        MemRtrBatchEvent * batch = dynamic_cast<MemRtrBatchEvent*>(sendQueue.front()->inspectPayload());
+        if (batch && batch->getNumEvents() > 1)
+            out.output("        (+%zu coalesced events)\n", batch->getNumEvents() - 1);
         tmpQ.push(sendQueue.front());
         sendQueue.pop();
     }
@@ -151,11 +197,10 @@ void MemNIC::emergencyShutdownDebug(Output &out) {
     out.output(" Draining link control...\n");
     MemRtrEvent * mre = doRecv(link_control);
     while (mre != nullptr) {
-        MemEventBase * ev = mre->takeEvent();
-        delete mre;
-        if (ev) {
+        while (MemEventBase * ev = mre->takeEvent()) {
             out.output("      Undelivered message: %s\n", ev->getVerboseString(out.getVerboseLevel()).c_str());
         }
+        delete mre;
         mre = doRecv(link_control);
     }
 }
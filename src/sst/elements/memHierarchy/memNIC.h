@@ -50,6 +50,8 @@ public:
 /* Element Library Info */
 #define MEMNIC_ELI_PARAMS MEMNICBASE_ELI_PARAMS, \
         { "min_packet_size",             "(string) Size of a packet without a payload (e.g., control message size)", "8B"},\
+        { "batch_max_size",              "(string) While events are waiting to be sent, coalesce events to the same destination into one network request of at most this size. 0B disables coalescing. Should not exceed the output buffer size. Receiving NICs must be MemNICs.", "0B"},\
+        { "batch_header_size",           "(string) Size added to a coalesced request for each event after the first, in addition to the event's payload", "2B"},\
         { "network_bw",                  "(string) Network bandwidth. Not used if linkcontrol subcomponent slot is filled.", "80GiB/s" },\
         { "network_input_buffer_size",   "(string) Size of input buffer. Not used if linkcontrol subcomponent slot is filled", "1KiB"},\
         { "network_output_buffer_size",  "(string) Size of output buffer. Not used if linkcontrol subcomponent slot is filled.", "1KiB"},\
@@ -64,6 +66,9 @@ public:
 
     SST_ELI_DOCUMENT_PORTS( {"port", "Link to network", { "memHierarchy.MemRtrEvent" } } )
 
+    SST_ELI_DOCUMENT_STATISTICS(
+            { "events_coalesced", "Number of events added to a request already waiting to be sent (batch_max_size). Only registered if coalescing is on.", "count", 2} )
+
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( { "linkcontrol", "Network interface"} )
 
 /* Begin class definition */
@@ -101,6 +106,12 @@ private:
 
     // Other parameters
     size_t packetHeaderBytes;
+    size_t batchMaxBits;        // Largest coalesced request, 0 if coalescing is off
+    size_t batchHeaderBits;     // Size of each event after the first in a coalesced request
+    Statistic<uint64_t>* stat_coalesced;
+
+    /* Try to add an event to the last request waiting in the send queue */
+    bool coalesce(MemEventBase * ev, uint64_t dest);
 
     // Handlers and network
     SST::Interfaces::SimpleNetwork *link_control;
@@ -79,7 +79,8 @@ class MemNICBase : public MemLinkBase {
                     event = ev;
                 }
 
-                MemEventBase* takeEvent() {
+                /* Returns nullptr once all carried events have been taken */
+                virtual MemEventBase* takeEvent() {
                     MemEventBase* tmp = event;
                     event = nullptr;
                     return tmp;
@@ -103,6 +104,61 @@ class MemNICBase : public MemLinkBase {
                 ImplementSerializable(SST::MemHierarchy::MemNICBase::MemRtrEvent);
         };
 
+        /* Several events to the same destination sent as one network request */
+        class MemRtrBatchEvent : public MemRtrEvent {
+            protected:
+                std::vector<MemEventBase*> events; // Events after the first, in send order
+                size_t next;
+            public:
+                MemRtrBatchEvent() : MemRtrEvent(), next(0) { }
+                MemRtrBatchEvent(MemEventBase * ev) : MemRtrEvent(ev), next(0) { }
+                ~MemRtrBatchEvent() {
+                    for (size_t i = next; i < events.size(); i++)
+                        delete events[i];
+                }
+
+                virtual Event* clone(void) override {
+                    MemRtrBatchEvent *mre = new MemRtrBatchEvent(*this);
+                    mre->event = (this->event != nullptr) ? this->event->clone() : nullptr;
+                    mre->events.clear();
+                    mre->next = 0;
+                    for (size_t i = next; i < events.size(); i++)
+                        mre->events.push_back(events[i]->clone());
+                    return mre;
+                }
+
+                void addEvent(MemEventBase* ev) {
+                    events.push_back(ev);
+                }
+
+                virtual MemEventBase* takeEvent() override {
+                    if (event)
+                        return MemRtrEvent::takeEvent();
+                    if (next < events.size())
+                        return events[next++];
+                    return nullptr;
+                }
+
+                size_t getNumEvents() const {
+                    return (event ? 1 : 0) + events.size() - next;
+                }
+
+                virtual std::string toString() const override {
+                    std::string str = event ? event->toString() : "";
+                    for (size_t i = next; i < events.size(); i++)
+                        str += "; " + events[i]->toString();
+                    return str;
+                }
+
+                void serialize_order(SST::Core::Serialization::serializer &ser) override {
+                    MemRtrEvent::serialize_order(ser);
+                    ser & events;
+                    ser & next;
+                }
+
+                ImplementSerializable(SST::MemHierarchy::MemNICBase::MemRtrBatchEvent);
+        };
+
         class InitMemRtrEvent : public MemRtrEvent {
             public:
                 EndpointInfo info;
@@ -447,11 +503,15 @@ class MemNICBase : public MemLinkBase {
         }
 
         // Lookup the network address for a given endpoint
+        // Back-to-back sends usually go to the same endpoint so remember the last one
         virtual uint64_t lookupNetworkAddress(const std::string &dst) const {
+            if (lastLookup && lastLookup->first == dst)
+                return lastLookup->second;
             std::unordered_map<std::string,uint64_t>::const_iterator it = networkAddressMap.find(dst);
             if (it == networkAddressMap.end()) {
                 dbg.fatal(CALL_INFO, -1, "%s (MemNICBase), Network address for destination '%s' not found in networkAddressMap.\n", getName().c_str(), dst.c_str());
             }
+            lastLookup = &(*it);
             return it->second;
         }
 
@@ -524,6 +584,7 @@ class MemNICBase : public MemLinkBase {
 
         // Data structures
         std::unordered_map<std::string,uint64_t> networkAddressMap; // Map of name -> address for each network endpoint
+        mutable const std::pair<const std::string,uint64_t>* lastLookup; // Last entry found by lookupNetworkAddress(), stable across rehash
         std::set<EndpointInfo> sourceEndpointInfo;
         std::set<EndpointInfo> destEndpointInfo;
         std::set<EndpointInfo> endpointInfo;
@@ -587,6 +648,7 @@ class MemNICBase : public MemLinkBase {
                     destIDs.insert(info.id + 1);
             }
             initMsgSent = false;
+            lastLookup = nullptr;
 
             dbg.debug(_L10_, "%s memNICBase info is: Name: %s, group: %" PRIu32 "\n",
                     getName().c_str(), info.name.c_str(), info.id);
@@ -19,6 +19,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <cstring>
+#include <set>
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
@@ -31,15 +34,20 @@ public:
     virtual ~Backing() { }
 
     virtual void set( Addr addr, uint8_t value ) = 0;
-    virtual void set( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void set( Addr addr, size_t size, const uint8_t* data ) = 0;
+    void set( Addr addr, size_t size, std::vector<uint8_t>& data) { set( addr, size, data.data() ); }
 
     virtual uint8_t get( Addr addr) = 0;
-    virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+    virtual void get( Addr addr, size_t size, uint8_t* data ) = 0;
+    void get( Addr addr, size_t size, std::vector<uint8_t>& data) { get( addr, size, data.data() ); }
     virtual void dump( FILE* ) {};
 };
 
 class BackingMMAP : public Backing {
 public:
+    using Backing::set;
+    using Backing::get;
+
     BackingMMAP(std::string memoryFile, size_t size, size_t offset = 0) : Backing(), m_fd(-1), m_size(size), m_offset(offset) {
         int flags = MAP_SHARED;
         if ( ! memoryFile.empty() ) {
@@ -68,30 +76,98 @@ public:
         m_buffer[addr - m_offset ] = value;
     }
 
-    void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            m_buffer[addr + i] = data[i];
+    void set( Addr addr, size_t size, const uint8_t* data ) {
+        memcpy( m_buffer + addr - m_offset, data, size );
+    }
+
+    uint8_t get( Addr addr ) {
+        return m_buffer[addr - m_offset];
+    }
+
+    void get( Addr addr, size_t size, uint8_t* data ) {
+        memcpy( data, m_buffer + addr - m_offset, size );
+    }
+
+private:
+    uint8_t* m_buffer;
+    int m_fd;
+    size_t m_size;
+    size_t m_offset;
+};
+
+/*
+ * Copy-on-write view of a read-only base image
+ * The image is mapped MAP_PRIVATE so any number of backings (e.g., one per rank) share its
+ * page cache pages and each only allocates the pages it writes. The image is never modified.
+ * Memory beyond the end of the image reads as zero.
+ */
+class BackingCOW : public Backing {
+public:
+    using Backing::set;
+    using Backing::get;
+
+    BackingCOW(std::string imageFile, size_t size, size_t offset = 0) : Backing(), m_fd(-1), m_size(size), m_offset(offset) {
+        m_fd = open(imageFile.c_str(), O_RDONLY);
+        if ( m_fd < 0 ) {
+            throw 1;
+        }
+        struct stat sb;
+        if ( fstat(m_fd, &sb) != 0 ) {
+            close( m_fd );
+            throw 1;
+        }
+
+        /* Reserve the full range as anonymous memory, then map the image over the start of it */
+        m_buffer = (uint8_t*)mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_NORESERVE, -1, 0);
+        if ( m_buffer == MAP_FAILED ) {
+            close( m_fd );
+            throw 2;
+        }
+        size_t imageSize = std::min((size_t)sb.st_size, size);
+        if ( imageSize > 0 ) {
+            void* image = mmap(m_buffer, imageSize, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_FIXED, m_fd, 0);
+            if ( image == MAP_FAILED ) {
+                munmap( m_buffer, m_size );
+                close( m_fd );
+                throw 2;
+            }
+        }
+    }
+
+    ~BackingCOW() {
+        munmap( m_buffer, m_size );
+        close( m_fd );
+    }
+
+    void set( Addr addr, uint8_t value ) {
+        m_buffer[addr - m_offset ] = value;
+    }
+
+    void set( Addr addr, size_t size, const uint8_t* data ) {
+        memcpy( m_buffer + addr - m_offset, data, size );
     }
 
     uint8_t get( Addr addr ) {
         return m_buffer[addr - m_offset];
     }
 
-    void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+    void get( Addr addr, size_t size, uint8_t* data ) {
+        memcpy( data, m_buffer + addr - m_offset, size );
     }
 
 private:
     uint8_t* m_buffer;
     int m_fd;
-    int m_size;
+    size_t m_size;
     size_t m_offset;
 };
 
 #define CHECKPOINT_DBG 0
 class BackingMalloc : public Backing {
 public:
+    using Backing::set;
+    using Backing::get;
+
     BackingMalloc(size_t size, bool init = false ) : m_init(init) {
         m_allocUnit = size;
         /* Alloc unit needs to be pwr-2 */
@@ -153,66 +229,37 @@ public:
         m_buffer[bAddr][offset] = value;
     }
 
-    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
-        /* Account for size exceeding alloc unit size */
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
-
-#if CHECKPOINT_DBG 
-        printf("%s() addr=%#lx size=%zu ",__func__,addr,size);
-#endif
-        while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
+    /* Copy a range, a page (alloc unit) at a time */
+    void set( Addr addr, size_t size, const uint8_t* data ) {
 #if CHECKPOINT_DBG 
-            printf("%#x ",data[dataOffset]);
+        printf("%s() addr=%#lx size=%zu\n",__func__,addr,size);
 #endif
-            offset++;
-            dataOffset++;
-
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+        size_t done = 0;
+        while (done != size) {
+            Addr bAddr = addr >> m_shift;
+            Addr offset = addr - (bAddr << m_shift);
+            size_t chunk = std::min(size - done, (size_t)(m_allocUnit - offset));
+            allocIfNeeded(bAddr);
+            memcpy(m_buffer[bAddr] + offset, data + done, chunk);
+            done += chunk;
+            addr += chunk;
         }
-#if CHECKPOINT_DBG 
-        printf("\n");
-#endif
     }
 
-    void get (Addr addr, size_t size, std::vector<uint8_t> &data) {
+    void get( Addr addr, size_t size, uint8_t* data ) {
 #if CHECKPOINT_DBG 
-        printf("%s() addr=%#lx size=%zu ",__func__,addr,size);
+        printf("%s() addr=%#lx size=%zu\n",__func__,addr,size);
 #endif
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        size_t dataOffset = 0;
-
-        allocIfNeeded(bAddr);
-        assert( data.size() == size );
-
-        assert( m_buffer.find(bAddr) != m_buffer.end() ); 
-        auto buf = m_buffer[bAddr];
-        while (dataOffset != size) {
-            
-            data[dataOffset] = buf[offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
-        }
-#if CHECKPOINT_DBG 
-        for ( auto i = 0; i < size; i++ ) {
-            printf("%x ",data[i]);
+        size_t done = 0;
+        while (done != size) {
+            Addr bAddr = addr >> m_shift;
+            Addr offset = addr - (bAddr << m_shift);
+            size_t chunk = std::min(size - done, (size_t)(m_allocUnit - offset));
+            allocIfNeeded(bAddr);
+            memcpy(data + done, m_buffer[bAddr] + offset, chunk);
+            done += chunk;
+            addr += chunk;
         }
-        printf("\n");
-#endif
     }
 
     uint8_t get( Addr addr ) {
@@ -265,6 +312,246 @@ private:
     bool m_init;
 };
 
+/*
+ * Sparse backing store organized as a two-level page directory
+ * Pages are allocated (zero-filled) on first write; reads of unallocated pages return zero.
+ * Range accesses are copied a page at a time with memcpy.
+ *
+ * Checkpoints use a binary format:
+ *   PagedCheckpointHeader
+ *   parent checkpoint path (parentLength bytes, may be empty)
+ *   page numbers (numPages x uint64_t)
+ *   padding up to dataOffset (page aligned)
+ *   page data (numPages x pageSize bytes)
+ * A checkpoint only contains the pages written since the backing was restored from its parent
+ * (or since the previous dump); restore() loads the parent chain first. Restored pages are
+ * mmap'd privately from the checkpoint file rather than copied.
+ */
+class BackingPaged : public Backing {
+public:
+    using Backing::set;
+    using Backing::get;
+
+    struct PagedCheckpointHeader {
+        char     magic[8];
+        uint32_t version;
+        uint32_t pageShift;
+        uint64_t numPages;
+        uint64_t parentLength;
+        uint64_t dataOffset;
+    };
+
+    BackingPaged(size_t pageSize) : Backing() {
+        if (!isPowerOfTwo(pageSize)) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingPaged: Error - page size must be a power of two. Got: %zu\n", pageSize);
+        }
+        m_pageSize = pageSize;
+        m_shift = log2Of(pageSize);
+    }
+
+    ~BackingPaged() {
+        for (Leaf* leaf : m_directory) {
+            if (!leaf) continue;
+            for (unsigned int i = 0; i < LEAF_PAGES; i++) {
+                if (leaf->pages[i] && (leaf->owned[i / 64] & (1ull << (i % 64))))
+                    free(leaf->pages[i]);
+            }
+            delete leaf;
+        }
+        for (auto& map : m_mappings)
+            munmap(map.first, map.second);
+    }
+
+    void set( Addr addr, uint8_t value ) {
+        writablePage(addr >> m_shift)[addr & (m_pageSize - 1)] = value;
+    }
+
+    void set( Addr addr, size_t size, const uint8_t* data ) {
+        size_t done = 0;
+        while (done != size) {
+            Addr offset = addr & (m_pageSize - 1);
+            size_t chunk = std::min(size - done, (size_t)(m_pageSize - offset));
+            memcpy(writablePage(addr >> m_shift) + offset, data + done, chunk);
+            done += chunk;
+            addr += chunk;
+        }
+    }
+
+    uint8_t get( Addr addr ) {
+        uint8_t* page = findPage(addr >> m_shift);
+        return page ? page[addr & (m_pageSize - 1)] : 0;
+    }
+
+    void get( Addr addr, size_t size, uint8_t* data ) {
+        size_t done = 0;
+        while (done != size) {
+            Addr offset = addr & (m_pageSize - 1);
+            size_t chunk = std::min(size - done, (size_t)(m_pageSize - offset));
+            uint8_t* page = findPage(addr >> m_shift);
+            if (page)
+                memcpy(data + done, page + offset, chunk);
+            else
+                memset(data + done, 0, chunk);
+            done += chunk;
+            addr += chunk;
+        }
+    }
+
+    /* Write the pages dirtied since the last restore/dump to fp and mark them clean */
+    void dump( FILE* fp ) {
+        std::vector<uint64_t> dirty;
+        for (size_t l = 0; l < m_directory.size(); l++) {
+            Leaf* leaf = m_directory[l];
+            if (!leaf) continue;
+            for (unsigned int w = 0; w < LEAF_PAGES / 64; w++) {
+                for (uint64_t bits = leaf->dirty[w]; bits; bits &= bits - 1)
+                    dirty.push_back((l << LEAF_SHIFT) + w * 64 + __builtin_ctzll(bits));
+            }
+        }
+
+        PagedCheckpointHeader header;
+        memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+        header.version = CHECKPOINT_VERSION;
+        header.pageShift = m_shift;
+        header.numPages = dirty.size();
+        header.parentLength = m_parent.size();
+        uint64_t indexEnd = sizeof(header) + m_parent.size() + dirty.size() * sizeof(uint64_t);
+        header.dataOffset = (indexEnd + CHECKPOINT_ALIGN - 1) & ~(uint64_t)(CHECKPOINT_ALIGN - 1);
+
+        bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+        ok = ok && fwrite(m_parent.data(), 1, m_parent.size(), fp) == m_parent.size();
+        ok = ok && fwrite(dirty.data(), sizeof(uint64_t), dirty.size(), fp) == dirty.size();
+        std::vector<uint8_t> pad(header.dataOffset - indexEnd, 0);
+        ok = ok && fwrite(pad.data(), 1, pad.size(), fp) == pad.size();
+        for (size_t i = 0; ok && i < dirty.size(); i++)
+            ok = fwrite(findPage(dirty[i]), 1, m_pageSize, fp) == m_pageSize;
+        if (!ok) {
+            Output out("", 1, 0, Output::STDOUT);
+            out.fatal(CALL_INFO, -1, "BackingPaged: Error - failed to write checkpoint.\n");
+        }
+
+        for (Leaf* leaf : m_directory) {
+            if (leaf) memset(leaf->dirty, 0, sizeof(leaf->dirty));
+        }
+    }
+
+    /* Set the checkpoint that the next dump() is relative to */
+    void setParent(const std::string& filename) { m_parent = filename; }
+
+    /* Restore a checkpoint written by dump() along with its parents. Restored pages are clean. */
+    void restore(const std::string& filename) {
+        std::set<std::pair<dev_t,ino_t> > chain;
+        restore(filename, chain);
+    }
+
+private:
+    /* 'chain' holds the files already opened below the checkpoint being restored so a parent loop is caught */
+    void restore(const std::string& filename, std::set<std::pair<dev_t,ino_t> >& chain) {
+        Output out("", 1, 0, Output::STDOUT);
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            out.fatal(CALL_INFO, -1, "BackingPaged: Error - unable to open checkpoint '%s'.\n", filename.c_str());
+
+        struct stat sb;
+        PagedCheckpointHeader header;
+        if (fstat(fd, &sb) != 0 || pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+                memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0 || header.version != CHECKPOINT_VERSION)
+            out.fatal(CALL_INFO, -1, "BackingPaged: Error - '%s' is not a paged checkpoint.\n", filename.c_str());
+        if (!chain.insert(std::make_pair(sb.st_dev, sb.st_ino)).second)
+            out.fatal(CALL_INFO, -1, "BackingPaged: Error - checkpoint '%s' appears twice in its own parent chain.\n", filename.c_str());
+        if (header.pageShift != m_shift)
+            out.fatal(CALL_INFO, -1, "BackingPaged: Error - checkpoint '%s' has page size %" PRIu64 " but the backing uses %zu.\n",
+                    filename.c_str(), (uint64_t)1 << header.pageShift, m_pageSize);
+        if (header.dataOffset + header.numPages * m_pageSize > (uint64_t)sb.st_size)
+            out.fatal(CALL_INFO, -1, "BackingPaged: Error - checkpoint '%s' is truncated.\n", filename.c_str());
+
+        if (header.parentLength) {
+            std::string parent(header.parentLength, '\0');
+            if (pread(fd, &parent[0], header.parentLength, sizeof(header)) != (ssize_t)header.parentLength)
+                out.fatal(CALL_INFO, -1, "BackingPaged: Error - checkpoint '%s' is truncated.\n", filename.c_str());
+            restore(parent, chain);
+        }
+
+        if (header.numPages) {
+            uint8_t* base = (uint8_t*)mmap(NULL, sb.st_size, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED)
+                out.fatal(CALL_INFO, -1, "BackingPaged: Error - unable to mmap checkpoint '%s'.\n", filename.c_str());
+            m_mappings.push_back(std::make_pair(base, (size_t)sb.st_size));
+
+            // The index follows the parent path so it is not necessarily 8-byte aligned
+            uint8_t* index = base + sizeof(header) + header.parentLength;
+            for (uint64_t i = 0; i < header.numPages; i++) {
+                uint64_t page;
+                memcpy(&page, index + i * sizeof(uint64_t), sizeof(page));
+                mapPage(page, base + header.dataOffset + i * m_pageSize);
+            }
+        }
+        close(fd);
+        m_parent = filename;
+    }
+
+    static constexpr unsigned int LEAF_SHIFT = 10;
+    static constexpr unsigned int LEAF_PAGES = 1 << LEAF_SHIFT;
+    static constexpr size_t CHECKPOINT_ALIGN = 4096;
+    static constexpr uint32_t CHECKPOINT_VERSION = 1;
+    static constexpr const char* CHECKPOINT_MAGIC = "SSTMEMPG";
+
+    struct Leaf {
+        uint8_t* pages[LEAF_PAGES] = {};
+        uint64_t dirty[LEAF_PAGES / 64] = {};
+        uint64_t owned[LEAF_PAGES / 64] = {}; // Allocated here rather than mapped from a checkpoint
+    };
+
+    uint8_t* findPage(Addr page) {
+        Addr l = page >> LEAF_SHIFT;
+        if (l >= m_directory.size() || !m_directory[l])
+            return nullptr;
+        return m_directory[l]->pages[page & (LEAF_PAGES - 1)];
+    }
+
+    Leaf* getLeaf(Addr page) {
+        Addr l = page >> LEAF_SHIFT;
+        if (l >= m_directory.size())
+            m_directory.resize(l + 1, nullptr);
+        if (!m_directory[l])
+            m_directory[l] = new Leaf();
+        return m_directory[l];
+    }
+
+    uint8_t* writablePage(Addr page) {
+        Leaf* leaf = getLeaf(page);
+        unsigned int i = page & (LEAF_PAGES - 1);
+        if (!leaf->pages[i]) {
+            leaf->pages[i] = (uint8_t*) calloc(1, m_pageSize);
+            if (!leaf->pages[i]) {
+                Output out("", 1, 0, Output::STDOUT);
+                out.fatal(CALL_INFO, -1, "BackingPaged: Error - malloc failed.\n");
+            }
+            leaf->owned[i / 64] |= (1ull << (i % 64));
+        }
+        leaf->dirty[i / 64] |= (1ull << (i % 64));
+        return leaf->pages[i];
+    }
+
+    void mapPage(Addr page, uint8_t* data) {
+        Leaf* leaf = getLeaf(page);
+        unsigned int i = page & (LEAF_PAGES - 1);
+        uint64_t bit = 1ull << (i % 64);
+        if (leaf->owned[i / 64] & bit)
+            free(leaf->pages[i]);
+        leaf->pages[i] = data;
+        leaf->owned[i / 64] &= ~bit;
+        leaf->dirty[i / 64] &= ~bit;
+    }
+
+    std::vector<Leaf*> m_directory;
+    std::vector<std::pair<uint8_t*, size_t> > m_mappings;
+    std::string m_parent;
+    size_t m_pageSize;
+    unsigned int m_shift;
+};
+
 }
 }
 }
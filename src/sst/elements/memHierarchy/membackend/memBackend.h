@@ -88,6 +88,9 @@ public:
     /* Called by parent's clock() function */
     virtual bool clock(Cycle_t UNUSED(cycle)) { return true; }
 
+    /* Called when the parent turns its clock back on; 'cycle' is the cycle before the next clock() call */
+    virtual void clockOn(Cycle_t UNUSED(cycle)) { }
+
     /* Interface to parent */
     virtual size_t getMemSize() { return m_memSize; }
     virtual uint32_t getRequestWidth() { return m_reqWidth; }
@@ -31,7 +31,7 @@ using namespace SST::MemHierarchy;
 
 
 MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBackend* backend, uint32_t request_width) :
-    SubComponent(id), m_cycleCount(0), m_reqId(0), m_backend(backend)
+    SubComponent(id), m_cycleCount(0), m_backend(backend)
 {
     m_dbg.init("",
             params.find<uint32_t>("debug_level", 0),
@@ -65,7 +65,20 @@ MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBa
     stat_cyclesAttemptIssueButRejected = registerStatistic<uint64_t>( "cycles_attempted_issue_but_rejected" );
     stat_totalCycles = registerStatistic<uint64_t>( "total_cycles" );;
 
+    stat_waitingIssue       = registerStatistic<uint64_t>("requests_waiting_issue");
+    stat_inBackend          = registerStatistic<uint64_t>("requests_in_backend");
+    stat_waitingFlushes     = registerStatistic<uint64_t>("flushes_waiting");
+
+    m_pendingRequests.push_back(nullptr); // ID 0 is unused
+    m_numPending = 0;
+    m_waitingFlushes = 0;
+
     m_clockOn = true; /* Maybe parent should set this */
+
+    m_profiler.enable(params.find<bool>("host_profile", false));
+    m_profEvent = m_profiler.addHandler("convertor.handleMemEvent");
+    m_profClock = m_profiler.addHandler("convertor.clock");
+    m_profResponse = m_profiler.addHandler("convertor.doResponse");
 }
 
 void MemBackendConvertor::setCallbackHandlers( std::function<void(Event::id_type,uint32_t)> responseCB, std::function<Cycle_t()> clockenable ) {
@@ -74,6 +87,7 @@ void MemBackendConvertor::setCallbackHandlers( std::function<void(Event::id_type
 }
 
 void MemBackendConvertor::handleMemEvent(  MemEvent* ev ) {
+    HostProfiler::Scope prof(m_profiler, m_profEvent, ev->getCmd());
 
     ev->setDeliveryTime(m_cycleCount);
 
@@ -95,6 +109,7 @@ void MemBackendConvertor::handleCustomEvent( Interfaces::StandardMem::CustomData
 }
 
 bool MemBackendConvertor::clock(Cycle_t cycle) {
+    HostProfiler::Scope prof(m_profiler, m_profClock);
     m_cycleCount++;
 
     int reqsThisCycle = 0;
@@ -127,7 +142,7 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
     if (cycleWithIssue)
         stat_cyclesWithIssue->addData(1);
 
-    stat_outstandingReqs->addData( m_pendingRequests.size() );
+    doOccupancyStats(1);
 
     bool unclock = !m_clockBackend;
     if (m_clockBackend)
@@ -148,9 +163,10 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
  */
 void MemBackendConvertor::turnClockOn(Cycle_t cycle) {
     Cycle_t cyclesOff = cycle - m_cycleCount;
-    stat_outstandingReqs->addDataNTimes( cyclesOff, m_pendingRequests.size() );
+    doOccupancyStats(cyclesOff);
     m_cycleCount = cycle;
     m_clockOn = true;
+    m_backend->clockOn(cycle);
 }
 
 /*
@@ -161,6 +177,7 @@ void MemBackendConvertor::turnClockOff() {
 }
 
 void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
+    HostProfiler::Scope prof(m_profiler, m_profResponse);
 
     /* If clock is not on, turn it back on */
     if (!m_clockOn) {
@@ -171,7 +188,7 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
     uint32_t id = BaseReq::getBaseId(reqId);
     MemEvent* resp = NULL;
 
-    if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+    if ( id >= m_pendingRequests.size() || m_pendingRequests[id] == nullptr ) {
         m_dbg.fatal(CALL_INFO, -1, "memory request not found; id=%" PRId32 "\n", id);
     }
 
@@ -180,14 +197,16 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
     req->decrement( );
 
     if ( req->isDone() ) {
-        m_pendingRequests.erase(id);
+        releaseReqId(id);
 
         if (!req->isMemEv()) {
             CustomReq* creq = static_cast<CustomReq*>(req);
             sendResponse(creq->getEvId(), flags);
         } else {
 
-            MemEvent* event = static_cast<MemReq*>(req)->getMemEvent();
+            MemReq* mreq = static_cast<MemReq*>(req);
+            MemEvent* event = mreq->getMemEvent();
+            prof.setCommand(event->getCmd());
 
             Debug(_L10_,"doResponse req is done. %s\n", event->getBriefString().c_str());
 
@@ -196,23 +215,25 @@ void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
             doResponseStat( event->getCmd(), latency );
 
             if (!flags) flags = event->getFlags();
-            SST::Event::id_type evID = event->getID();
             sendResponse(event->getID(), flags); // Needs to occur before a flush is completed since flush is dependent
 
             // TODO clock responses
             // Check for flushes that are waiting on this event to finish
-            if (m_dependentRequests.find(evID) != m_dependentRequests.end()) {
-                std::set<MemEvent*, memEventCmp> flushes = m_dependentRequests.find(evID)->second;
-
-                for (std::set<MemEvent*, memEventCmp>::iterator it = flushes.begin(); it != flushes.end(); it++) {
-                    (m_waitingFlushes.find(*it)->second).erase(evID);
-                    if ((m_waitingFlushes.find(*it)->second).empty()) {
-                        MemEvent * flush = *it;
-                        sendResponse(flush->getID(), flush->getFlags());
-                        m_waitingFlushes.erase(flush);
+            std::vector<FlushWait*>& flushes = mreq->getFlushes();
+            if (!flushes.empty()) {
+                std::vector<MemEvent*> done;
+                for (std::vector<FlushWait*>::iterator it = flushes.begin(); it != flushes.end(); it++) {
+                    if (--((*it)->waitCount) == 0) {
+                        done.push_back((*it)->flush);
+                        delete *it;
                     }
                 }
-                m_dependentRequests.erase(evID);
+                // Respond in event ID order when several flushes finish at once
+                std::sort(done.begin(), done.end(), memEventCmp());
+                for (std::vector<MemEvent*>::iterator it = done.begin(); it != done.end(); it++) {
+                    sendResponse((*it)->getID(), (*it)->getFlags());
+                    m_waitingFlushes--;
+                }
             }
         }
         delete req;
@@ -232,11 +253,15 @@ void MemBackendConvertor::finish(Cycle_t endCycle) {
     // stat_outstandingReqs may vary slightly in parallel & serial
     if (endCycle > m_cycleCount) {
         Cycle_t cyclesOff = endCycle - m_cycleCount;
-        stat_outstandingReqs->addDataNTimes( cyclesOff, m_pendingRequests.size() );
+        doOccupancyStats(cyclesOff);
         m_cycleCount = endCycle;
     }
     stat_totalCycles->addData(m_cycleCount);
     m_backend->finish();
+    if (m_profiler.enabled()) {
+        Output out("", 1, 0, Output::STDOUT);
+        m_profiler.print(out, getName());
+    }
 }
 
 size_t MemBackendConvertor::getMemSize() {
@@ -23,6 +23,7 @@
 
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -40,7 +41,8 @@ class MemBackendConvertor : public SubComponent {
 /* ELI definitions for subclasses */
 #define MEMBACKENDCONVERTOR_ELI_PARAMS {"debug_level",     "(uint) Debugging level: 0 (no output) to 10 (all output). Output also requires that SST Core be compiled with '--enable-debug'", "0"},\
             {"debug_mask",      "(uint) Mask on debug_level", "0"},\
-            {"debug_location",  "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE", "0"}
+            {"debug_location",  "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE", "0"},\
+            {"host_profile",    "(bool) Measure host time spent in the event, clock and response handlers and print a 'HostProfile:' summary at the end of simulation. Set by the memory controller's 'host_profile'.", "false"}
 
 #define MEMBACKENDCONVERTOR_ELI_STATS { "cycles_with_issue",                  "Total cycles with successful issue to back end",   "cycles",   1 },\
             { "cycles_attempted_issue_but_rejected","Total cycles where an attempt to issue to backend was rejected (indicates backend full)", "cycles", 1 },\
@@ -51,6 +53,9 @@ class MemBackendConvertor : public SubComponent {
             { "requests_received_PutM",             "Number of PutM (write) requests received",         "requests", 1 },\
             { "requests_received_Write",            "Number of Write (write) requests received",         "requests", 1 },\
             { "outstanding_requests",               "Total number of outstanding requests each cycle",  "requests", 1 },\
+            { "requests_waiting_issue",             "Number of requests waiting to be issued to the backend each cycle (frontend queue occupancy)", "requests", 2 },\
+            { "requests_in_backend",                "Number of fully issued requests waiting on the backend each cycle (backend occupancy)", "requests", 2 },\
+            { "flushes_waiting",                    "Number of flushes waiting on earlier requests to the same line each cycle", "requests", 2 },\
             { "latency_GetS",                       "Total latency of handled GetS requests",           "cycles",   1 },\
             { "latency_GetSX",                      "Total latency of handled GetSX requests",          "cycles",   1 },\
             { "latency_GetX",                       "Total latency of handled GetX requests",           "cycles",   1 },\
@@ -111,6 +116,12 @@ class MemBackendConvertor : public SubComponent {
 
     };
 
+    /* A flush waiting on earlier requests to the same line. Responded to when waitCount reaches 0 */
+    struct FlushWait {
+        MemEvent* flush;
+        uint32_t waitCount;
+    };
+
     class MemReq : public BaseReq {
       public:
         MemReq( MemEvent* event, uint32_t reqId ) : BaseReq(reqId, BaseReq::ReqType::MEM),
@@ -147,10 +158,14 @@ class MemBackendConvertor : public SubComponent {
             return BaseReq::getString() + str.str();
         }
 
+        void addFlush(FlushWait* flush) { m_flushes.push_back(flush); }
+        std::vector<FlushWait*>& getFlushes() { return m_flushes; }
+
       private:
         MemEvent*   m_event;
         uint32_t    m_offset;
         uint32_t    m_numReq;
+        std::vector<FlushWait*> m_flushes; // Flushes waiting on this request
     };
 
   public:
@@ -168,7 +183,7 @@ class MemBackendConvertor : public SubComponent {
 
     virtual const std::string getRequestor( ReqId reqId ) {
         uint32_t id = BaseReq::getBaseId(reqId);
-        if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
+        if ( id >= m_pendingRequests.size() || m_pendingRequests[id] == nullptr ) {
             m_dbg.fatal(CALL_INFO, -1, "memory request not found\n");
         }
 
@@ -199,32 +214,32 @@ class MemBackendConvertor : public SubComponent {
   private:
     virtual bool issue(BaseReq*) = 0;
 
+    HostProfiler m_profiler;
+    unsigned m_profEvent;       // handleMemEvent()
+    unsigned m_profClock;       // clock()
+    unsigned m_profResponse;    // doResponse()
+
 
 
 
     bool setupMemReq( MemEvent* ev ) {
         if ( Command::FlushLine == ev->getCmd() || Command::FlushLineInv == ev->getCmd() ) {
-            // TODO optimize if this becomes a problem, it is slow
-            std::set<SST::Event::id_type> dependsOn;
+            // Flush waits for any request to the same line that has not been issued yet
+            FlushWait * wait = nullptr;
             for (std::deque<BaseReq*>::iterator it = m_requestQueue.begin(); it != m_requestQueue.end(); it++) {
                 if (!(*it)->isMemEv())
                     continue;
                 MemReq * mr = static_cast<MemReq*>(*it);
                 if (mr->baseAddr() == ev->getBaseAddr()) {
-                    MemEvent * req = mr->getMemEvent();
-                    dependsOn.insert(req->getID());
-                    if (m_dependentRequests.find(req->getID()) == m_dependentRequests.end()) {
-                        std::set<MemEvent*, memEventCmp> flushSet;
-                        flushSet.insert(ev);
-                        m_dependentRequests.insert(std::make_pair(req->getID(), flushSet));
-                    } else {
-                        (m_dependentRequests.find(req->getID())->second).insert(ev);
-                    }
+                    if (!wait)
+                        wait = new FlushWait{ev, 0};
+                    wait->waitCount++;
+                    mr->addFlush(wait);
                 }
             }
 
-            if (dependsOn.empty()) return false;
-            m_waitingFlushes.insert(std::make_pair(ev, dependsOn));
+            if (!wait) return false;
+            m_waitingFlushes++;
             return true;
         }
 
@@ -293,18 +308,44 @@ class MemBackendConvertor : public SubComponent {
     std::function<Cycle_t()> m_enableClock; // Re-enable parent's clock
     std::function<void(Event::id_type id, uint32_t)> m_notifyResponse; // notify parent of response
 
-    uint32_t genReqId( ) { return ++m_reqId; }
+    /*
+     * Request IDs index m_pendingRequests directly. IDs of completed requests are reused
+     * so the table stays as large as the peak number of outstanding requests.
+     * The caller must fill the slot for the returned ID. ID 0 is never used.
+     */
+    uint32_t genReqId( ) {
+        m_numPending++;
+        if (!m_freeReqIds.empty()) {
+            uint32_t id = m_freeReqIds.back();
+            m_freeReqIds.pop_back();
+            return id;
+        }
+        m_pendingRequests.push_back(nullptr);
+        return m_pendingRequests.size() - 1;
+    }
+
+    void releaseReqId( uint32_t id ) {
+        m_pendingRequests[id] = nullptr;
+        m_freeReqIds.push_back(id);
+        m_numPending--;
+    }
 
-    uint32_t m_reqId;
+    void doOccupancyStats( uint64_t count ) {
+        stat_outstandingReqs->addDataNTimes( count, m_numPending );
+        stat_waitingIssue->addDataNTimes( count, m_requestQueue.size() );
+        stat_inBackend->addDataNTimes( count, m_numPending - m_requestQueue.size() );
+        stat_waitingFlushes->addDataNTimes( count, m_waitingFlushes );
+    }
 
-    typedef std::map<uint32_t,BaseReq*> PendingRequests;
+    typedef std::vector<BaseReq*> PendingRequests;
 
     std::deque<BaseReq*>    m_requestQueue;
-    PendingRequests         m_pendingRequests;
+    PendingRequests         m_pendingRequests;  // Indexed by request ID, nullptr if the ID is free
+    std::vector<uint32_t>   m_freeReqIds;
+    size_t                  m_numPending;
     uint32_t                m_frontendRequestWidth;
 
-    std::map<MemEvent*, std::set<SST::Event::id_type> > m_waitingFlushes; // Set of request IDs for each flush
-    std::map<SST::Event::id_type, std::set<MemEvent*, memEventCmp> > m_dependentRequests; // Reverse map, set of flushes for each request ID, for faster lookup
+    uint64_t m_waitingFlushes; // Number of flushes waiting on earlier requests
 
     Statistic<uint64_t>* stat_GetSLatency;
     Statistic<uint64_t>* stat_GetSXLatency;
@@ -322,6 +363,9 @@ class MemBackendConvertor : public SubComponent {
     Statistic<uint64_t>* stat_cyclesAttemptIssueButRejected;
     Statistic<uint64_t>* stat_totalCycles;
     Statistic<uint64_t>* stat_outstandingReqs;
+    Statistic<uint64_t>* stat_waitingIssue;
+    Statistic<uint64_t>* stat_inBackend;
+    Statistic<uint64_t>* stat_waitingFlushes;
 
 };
 
@@ -76,6 +76,28 @@ RequestReorderRow::RequestReorderRow(ComponentId_t id, Params &params) : SimpleM
         reorderCount.push_back(maxReqsPerRow);  // No requests reordered to this row
     }
 
+    std::string schedulerName = params.find<std::string>("scheduler", "");
+    if (!schedulerName.empty()) {
+        Params schedulerParams = params.get_scoped_params("scheduler");
+        for (unsigned int i = 0; i < banks; i++) {
+            TimingDRAM_NS::TransactionQ* scheduler = loadAnonymousSubComponent<TimingDRAM_NS::TransactionQ>(schedulerName, "scheduler", i, ComponentInfo::INSERT_STATS, schedulerParams);
+            if (!scheduler) {
+                output->fatal(CALL_INFO, -1, "Invalid param(%s): scheduler - unable to load '%s'.\n", getName().c_str(), schedulerName.c_str());
+            }
+            schedulers.push_back(scheduler);
+            selected.push_back(nullptr);
+        }
+    }
+    currentCycle = 0;
+
+}
+
+/* The scheduler subcomponents are deleted by the core and free the transactions still queued in them */
+RequestReorderRow::~RequestReorderRow() {
+    for (std::vector<Transaction*>::iterator it = selected.begin(); it != selected.end(); it++)
+        delete *it;
+    for (std::vector< std::list<Req>* >::iterator it = requestQueue.begin(); it != requestQueue.end(); it++)
+        delete *it;
 }
 
 bool RequestReorderRow::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned numBytes ) {
@@ -84,17 +106,52 @@ bool RequestReorderRow::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
 #endif
     int bank = (addr >> lineOffset) & bankMask;
 
+    if (!schedulers.empty()) {
+        schedulers[bank]->push(new Transaction(currentCycle, id, addr, isWrite, numBytes, bank, addr >> rowOffset));
+        return true;
+    }
+
     requestQueue[bank]->push_back(Req(id,addr,isWrite,numBytes));
     return true;
 }
 
+/*
+ * Issue the request each bank's scheduler selects, up to requestsPerCycle.
+ * A request that the backend refuses stays selected and is retried next cycle.
+ */
+void RequestReorderRow::issueScheduled() {
+    int reqsIssuedThisCycle = 0;
+    unsigned int bank = nextBank;
+    for (unsigned int i = 0; i < banks; i++) {
+        if (!selected[bank] && !schedulers[bank]->empty())
+            selected[bank] = schedulers[bank]->pop(lastRow[bank]);
+
+        Transaction* trans = selected[bank];
+        if (trans && backend->issueRequest(trans->id, trans->addr, trans->isWrite, trans->numBytes)) {
+            reqsIssuedThisCycle++;
+            nextBank = (bank + 1) % banks;
+            lastRow[bank] = trans->row;
+            selected[bank] = nullptr;
+            delete trans;
+
+            if (reqsIssuedThisCycle == reqsPerCycle) {
+                break;  // Can't issue any more
+            }
+        }
+        bank = (bank + 1) % banks;
+    }
+}
+
 /*
  * Issue as many requests as we can up to requestsPerCycle
  * by searching up to searchWindowSize requests
  */
 bool RequestReorderRow::clock(Cycle_t cycle) {
 
-    if (!requestQueue.empty()) {
+    currentCycle = cycle;
+    if (!schedulers.empty()) {
+        issueScheduled();
+    } else if (!requestQueue.empty()) {
 
         int reqsIssuedThisCycle = 0;
         int reqsSearchedThisCycle = 0;
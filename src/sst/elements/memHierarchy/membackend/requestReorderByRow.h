@@ -18,6 +18,7 @@
 #define _H_SST_MEMH_REQUEST_REORDER_ROW_BACKEND
 
 #include "sst/elements/memHierarchy/membackend/memBackend.h"
+#include "sst/elements/memHierarchy/membackend/timingTransaction.h"
 #include <list>
 #include <vector>
 
@@ -37,14 +38,17 @@ public:
             {"banks",                       "Number of banks", "8"},
             {"bank_interleave_granularity", "Granularity of interleaving in bytes (B), generally a cache line. Must be a power of 2.", "64B"},
             {"row_size",                    "Size of a row in bytes (B). Must be a power of 2.", "8KiB"},
-            {"reorder_limit",               "Maximum number of request to reorder to a rwo before changing rows.", "1"},
+            {"reorder_limit",               "Maximum number of request to reorder to a rwo before changing rows. Not used if 'scheduler' is set.", "1"},
+            {"scheduler",                   "Per-bank transaction queue used to pick requests, e.g. memHierarchy.frfcfsTransactionQ. If not set, requests are reordered using 'reorder_limit'.", ""},
             {"backend",                     "Backend memory system.", "memHierarchy.simpleDRAM"} )
 
-    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"backend", "Backend memory model.", "SST::MemHierarchy::SimpleMemBackend"} )
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS( {"backend", "Backend memory model.", "SST::MemHierarchy::SimpleMemBackend"},
+            {"scheduler", "Per-bank transaction queues, loaded anonymously from the 'scheduler' parameter", "SST::MemHierarchy::TimingDRAM_NS::TransactionQ"} )
 
 /* Begin class definition */
     RequestReorderRow();
     RequestReorderRow(ComponentId_t id, Params &params);
+    ~RequestReorderRow();
 
     virtual bool issueRequest( ReqId, Addr, bool isWrite, unsigned numBytes );
     void setup();
@@ -53,6 +57,8 @@ public:
 
 private:
 
+    void issueScheduled();
+
     void handleMemReponse( ReqId id ) {
         SimpleMemBackend::handleMemResponse( id );
     }
@@ -77,6 +83,12 @@ private:
     std::vector<unsigned int> reorderCount;
     std::vector<unsigned int> lastRow;
 
+    // Used instead of requestQueue/reorderCount if a scheduler is configured
+    typedef TimingDRAM_NS::Transaction Transaction;
+    std::vector<TimingDRAM_NS::TransactionQ*> schedulers;
+    std::vector<Transaction*> selected;     // Request picked by the bank's scheduler but not yet accepted by the backend
+    Cycle_t currentCycle;
+
 };
 
 }
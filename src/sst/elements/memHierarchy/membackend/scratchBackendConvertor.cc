@@ -30,7 +30,7 @@ using namespace SST::MemHierarchy;
 #endif
 
 ScratchBackendConvertor::ScratchBackendConvertor(ComponentId_t id, Params& params ) :
-    SubComponent(id), m_reqId(0)
+    SubComponent(id), m_reqId(0), m_clockSkip(false)
 { 
     m_dbg.init("",
             params.find<uint32_t>("debug_level", 0),
@@ -114,7 +114,8 @@ bool ScratchBackendConvertor::clock(Cycle_t cycle) {
 
     bool unclock = m_backend->clock(cycle);
 
-    return false;
+    /* OK to unclock if skipping is enabled, nothing is waiting to issue, and the backend does not need the clock */
+    return m_clockSkip && unclock && m_requestQueue.empty();
 }
 
 
@@ -77,6 +77,15 @@ public:
     virtual bool clock( Cycle_t cycle );
     virtual void handleMemEvent(  MemEvent* );
 
+    /* Let clock() report idle so the parent may turn its clock off. Off by default. */
+    void setClockSkip( bool skip ) { m_clockSkip = skip; }
+
+    /* Account for cycles the parent's clock was off */
+    void skipCycles( Cycle_t cycles ) {
+        m_cycleCount += cycles;
+        stat_totalCycles->addDataNTimes(cycles, 1);
+    }
+
     virtual const std::string& getRequestor( ReqId reqId ) {
         uint32_t id = MemReq::getBaseId(reqId);
         if ( m_pendingRequests.find( id ) == m_pendingRequests.end() ) {
@@ -164,6 +173,7 @@ public:
     Output      m_dbg;
 
     uint64_t m_cycleCount;
+    bool     m_clockSkip;
 
     uint32_t genReqId( ) { return ++m_reqId; }
 
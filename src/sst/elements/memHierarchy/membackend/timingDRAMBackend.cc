@@ -22,7 +22,7 @@ bool TimingDRAM::Channel::m_printConfig = true;
 bool TimingDRAM::Rank::m_printConfig = true;
 bool TimingDRAM::Bank::m_printConfig = true;
 
-TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0) { 
+TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0), m_lastClock(0) { 
 
     int dram_id = params.find<int>("id", -1);
     assert( dram_id != -1 );
@@ -45,6 +45,7 @@ TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id,
     }
 
     int numChannels = params.find<int>("channels", 1);
+    m_eventDriven = params.find<bool>("eventDriven", false);
 
     if (m_printConfig)
         m_printConfig = params.find<bool>("printconfig", true);
@@ -59,7 +60,7 @@ TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id,
     tmpParams = params.get_scoped_params("channel" );
     for ( unsigned i=0; i < numChannels; i++ ) {
         using std::placeholders::_1;
-        m_channels.push_back(loadComponentExtension<Channel>( std::bind(&TimingDRAM::handleResponse, this, _1), tmpParams, dram_id, i, output, m_mapper ));
+        m_channels.push_back(loadComponentExtension<Channel>( std::bind(&TimingDRAM::handleResponse, this, _1), tmpParams, dram_id, i, output, m_mapper, m_eventDriven ));
     }
 }
 
@@ -77,22 +78,45 @@ bool TimingDRAM::issueRequest( ReqId id, Addr addr, bool isWrite, unsigned numBy
     return ret;
 }
 
+/* In eventDriven mode the convertor issues new requests before it calls clock(), so catch m_cycle
+ * up as soon as the clock is turned back on; otherwise those requests get a stale createTime. */
+void TimingDRAM::clockOn(Cycle_t cycle)
+{
+    if ( m_eventDriven && m_lastClock != 0 && cycle > m_lastClock ) {
+        m_cycle += cycle - m_lastClock;
+        m_lastClock = cycle;
+    }
+}
+
 bool TimingDRAM::clock(Cycle_t cycle)
 {
+    /* In eventDriven mode the controller may have turned the clock off while idle.
+     * Advance by the cycles that passed so m_cycle matches an always-on clock. */
+    if ( m_eventDriven && m_lastClock != 0 )
+        m_cycle += cycle - m_lastClock - 1;
+    m_lastClock = cycle;
+
     output->verbose(CALL_INFO, 5, DBG_MASK, "cycle %" PRIu64 "\n",m_cycle);
     for ( unsigned i = 0; i < m_channels.size(); i++ ) {
         m_channels[i]->clock(m_cycle);
     }
     ++m_cycle;
-    return false;
+
+    if ( ! m_eventDriven )
+        return false;
+    for ( unsigned i = 0; i < m_channels.size(); i++ ) {
+        if ( ! m_channels[i]->isIdle() )
+            return false;
+    }
+    return true;
 }
 
 //==================================================================================
 // Channel
 //==================================================================================
 
-TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handler, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_nextRankUp(0), m_dataBusAvailCycle(0)
+TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handler, Params& params, unsigned mc, unsigned myNum, Output* output, AddrMapper* mapper, bool eventDriven ) :
+    ComponentExtension(id), m_responseHandler(handler), m_output( output ), m_mapper( mapper ), m_eventDriven(eventDriven), m_wakeCycle(0), m_nextRankUp(0), m_dataBusAvailCycle(0)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Channel:@p():@l:mc=" << mc << ":chan=" << myNum << ": ";
@@ -121,16 +145,17 @@ TimingDRAM::Channel::Channel( ComponentId_t id, std::function<void(ReqId)> handl
 
 void TimingDRAM::Channel::clock( SimTime_t cycle )
 {
+    if ( m_eventDriven && cycle < m_wakeCycle )
+        return;
+
     if (is_debug)
         m_output->verbosePrefix(prefix(),CALL_INFO, 5, DBG_MASK, "cycle %" PRIu64 "\n",cycle);
 
-    std::list<Cmd*>::iterator iter = m_issuedCmds.begin();
-
-    /* Check all outstanding commands to see if anything is finished */
-    while ( iter != m_issuedCmds.end() ) {
-        if ( (*iter)->isDone(cycle) ) {
-            Cmd* cmd = (*iter);
-
+    /* Check all outstanding commands to see if anything is finished, keeping the rest in issue order */
+    size_t kept = 0;
+    for ( size_t i = 0; i < m_issuedCmds.size(); i++ ) {
+        Cmd* cmd = m_issuedCmds[i];
+        if ( cmd->isDone(cycle) ) {
             if (is_debug)
                 m_output->verbosePrefix(prefix(),CALL_INFO, 2, DBG_MASK, "cycle=%" PRIu64 " retire %s for rank=%d bank=%d row=%d\n",
                         cycle, cmd->getName().c_str(), cmd->getRank(), cmd->getBank(), cmd->getRow());
@@ -139,12 +164,12 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
                 m_retiredTrans.push(cmd->getTrans());
             }
 
-            delete (*iter);
-            iter = m_issuedCmds.erase(iter);
+            delete cmd;
         } else {
-            ++iter;
+            m_issuedCmds[kept++] = cmd;
         }
     }
+    m_issuedCmds.resize(kept);
 
     /* Return a response if possible */
     if ( ! m_retiredTrans.empty() ) {
@@ -170,6 +195,32 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
 
         m_issuedCmds.push_back(cmd);
     }
+
+    if ( m_eventDriven )
+        m_wakeCycle = cmd ? cycle + 1 : nextWakeCycle( cycle );
+}
+
+/*
+ * Earliest cycle after 'cycle' at which clock() could do anything: a command retires,
+ * a response is waiting to be returned, or some bank could create or issue a command.
+ * Cycles before that would only repeat checks that fail, so they can be skipped.
+ */
+SimTime_t TimingDRAM::Channel::nextWakeCycle( SimTime_t cycle )
+{
+    if ( ! m_retiredTrans.empty() )
+        return cycle + 1;
+
+    SimTime_t next = std::numeric_limits<SimTime_t>::max();
+    for ( size_t i = 0; i < m_issuedCmds.size(); i++ ) {
+        next = std::min( next, m_issuedCmds[i]->getFiniTime() );
+    }
+
+    for ( unsigned i = 0; i < m_ranks.size(); i++ ) {
+        if ( m_ranks[i]->hasActiveBanks() )
+            next = std::min( next, m_ranks[i]->nextIssueCycle( cycle, m_dataBusAvailCycle ) );
+    }
+
+    return std::max( next, cycle + 1 );
 }
 
 TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle )
@@ -205,7 +256,7 @@ TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBus
 //==================================================================================
 
 TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned chan, unsigned myNum, Output* output, AddrMapper* mapper ) :
-    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0)
+    ComponentExtension(id), m_output( output ), m_mapper( mapper ), m_nextBankUp(0), m_numActive(0)
 {
     std::ostringstream tmp;
     tmp << "@t:TimingDRAM:Rank:@p():@l:mc=" << mc << ":chan=" << chan << ":rank=" << myNum <<": ";
@@ -226,6 +277,7 @@ TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned
     for ( unsigned i=0; i<banks; i++ ) {
         m_banks.push_back( loadComponentExtension<Bank>( tmpParams, mc, chan, myNum, i, output ) );
     }
+    m_banksActive.resize( (banks + 63) / 64, 0 );
 }
 
 TimingDRAM::Cmd* TimingDRAM::Rank::popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle )
@@ -235,11 +287,11 @@ TimingDRAM::Cmd* TimingDRAM::Rank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
 
     unsigned current = m_nextBankUp;
     for ( unsigned i = 0; i < m_banks.size(); i++ ) {
-        if (m_banksActive.find(current) != m_banksActive.end()) {
+        if (isActive(current)) {
             Cmd* cmd = m_banks[current]->popCmd( cycle, dataBusAvailCycle );
 
             if (m_banks[current]->isIdle())
-                m_banksActive.erase(current);
+                clearActive(current);
 
             if ( cmd ) {
                 if ( current == m_nextBankUp ) {
@@ -258,6 +310,16 @@ TimingDRAM::Cmd* TimingDRAM::Rank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
     return nullptr;
 }
 
+SimTime_t TimingDRAM::Rank::nextIssueCycle( SimTime_t cycle, SimTime_t dataBusAvailCycle )
+{
+    SimTime_t next = std::numeric_limits<SimTime_t>::max();
+    for ( unsigned i = 0; i < m_banks.size(); i++ ) {
+        if ( isActive(i) )
+            next = std::min( next, m_banks[i]->nextIssueCycle( cycle, dataBusAvailCycle ) );
+    }
+    return next;
+}
+
 //==================================================================================
 // Bank
 //==================================================================================
@@ -314,6 +376,22 @@ TimingDRAM::Cmd* TimingDRAM::Bank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
     return cmd;
 }
 
+/*
+ * Earliest cycle at which popCmd() could change this bank's state.
+ * update() pops a transaction whenever one is queued and consults the page policy every
+ * cycle while an open row could be closed, so both of those mean the bank must be visited next cycle.
+ */
+SimTime_t TimingDRAM::Bank::nextIssueCycle( SimTime_t cycle, SimTime_t dataBusAvailCycle )
+{
+    if ( ! m_transQ->empty() )
+        return cycle + 1;
+    if ( nullptr == m_lastCmd && m_row != -1 && m_pagePolicy->canClose() )
+        return cycle + 1;
+    if ( m_cmdQ.empty() )
+        return std::numeric_limits<SimTime_t>::max();
+    return m_cmdQ.front()->earliestIssue( dataBusAvailCycle );
+}
+
 void TimingDRAM::Bank::update( SimTime_t current )
 {
     if ( nullptr == m_lastCmd && m_row != -1 && m_pagePolicy->shouldClose( current ) ) {
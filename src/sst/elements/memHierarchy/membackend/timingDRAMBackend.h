@@ -14,6 +14,7 @@
 #define _H_SST_MEMH_TIMING_DRAM_BACKEND
 
 #include <queue>
+#include <limits>
 
 #include <sst/core/componentExtension.h>
 
@@ -42,6 +43,7 @@ public:
             {"printconfig", "Print configuration at start", "true"},
             {"addrMapper", "Address map subcomponent", "memHierarchy.simpleAddrMapper"},
             {"channels", "Number of channels", "1"},
+            {"eventDriven", "Only evaluate a channel in cycles where a command can retire or issue, and let the memory controller turn its clock off while all channels are idle. Results are identical to the default mode.", "false"},
             {"channel.numRanks", "Number of ranks per channel", "1"},
             {"channel.transaction_Q_size", "Size of transaction queue", "32"},
             {"channel.rank.numBanks", "Number of banks per rank", "8"},
@@ -50,7 +52,7 @@ public:
             {"channel.rank.bank.RCD", "Row access latency in cycles", "11"},
             {"channel.rank.bank.TRP", "Precharge delay in cycles", "11"},
             {"channel.rank.bank.dataCycles", "", "4"},
-            {"channel.rank.bank.transactionQ", "Transaction queue model (subcomponent)", "memHierarchy.fifoTransactionQ"},
+            {"channel.rank.bank.transactionQ", "Transaction queue model (subcomponent): memHierarchy.fifoTransactionQ, memHierarchy.reorderTransactionQ or memHierarchy.frfcfsTransactionQ", "memHierarchy.fifoTransactionQ"},
             {"channel.rank.bank.pagePolicy", "Policy subcomponent for managing row buffer", "memHierarchy.simplePagePolicy"})
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -103,6 +105,8 @@ private:
             return (m_row == -1 || !m_pagePolicy->canClose()) && m_cmdQ.empty() && m_transQ->empty();
         }
 
+        SimTime_t nextIssueCycle( SimTime_t cycle, SimTime_t dataBusAvailCycle );
+
         unsigned getRank() { return m_rank; }
         unsigned getBank() { return m_bank; }
 
@@ -134,17 +138,6 @@ private:
         Cmd( Bank* bank, Op op, unsigned cycles, unsigned row = -1, unsigned dataCycles = 0, Transaction* trans  = NULL  ) :
             m_bank(bank), m_op(op), m_cycles(cycles), m_row(row), m_dataCycles(dataCycles), m_trans(trans)
         {
-            switch( m_op ) {
-              case PRE:
-                m_name = "PRE";
-                break;
-              case ACT:
-                m_name = "ACT";
-                break;
-              case COL:
-                m_name = "COL";
-                break;
-            }
             if (is_debug)
                 m_bank->verbose(__LINE__,__FUNCTION__,"new %s for rank=%d bank=%d row=%d\n",
                         getName().c_str(), getRank(), getBank(), getRow());
@@ -154,6 +147,24 @@ private:
             m_bank->clearLastCmd();
         }
 
+        /* Commands are created and retired every few cycles; recycle their storage */
+        static void* operator new(size_t size) {
+            CmdBlock*& head = freeList();
+            if (head) {
+                CmdBlock* block = head;
+                head = block->next;
+                return block;
+            }
+            return ::operator new(size);
+        }
+
+        static void operator delete(void* ptr) {
+            CmdBlock*& head = freeList();
+            CmdBlock* block = static_cast<CmdBlock*>(ptr);
+            block->next = head;
+            head = block;
+        }
+
         SimTime_t issue() {
 
             m_bank->setLastCmd(this);
@@ -202,6 +213,23 @@ private:
             return ret;
         }
 
+        /* Earliest cycle at which canIssue() can succeed given the current bank and bus state.
+         * Returns MAX if the command must wait for the bank's last command to retire. */
+        SimTime_t earliestIssue( SimTime_t dataBusAvailCycle ) {
+            SimTime_t earliest = 0;
+            Cmd* lastCmd = m_bank->getLastCmd();
+            if ( lastCmd ) {
+                if ( m_op != COL || lastCmd->m_op != COL )
+                    return std::numeric_limits<SimTime_t>::max();
+                earliest = lastCmd->m_issueTime + m_dataCycles;
+            }
+            if ( dataBusAvailCycle > m_cycles )
+                earliest = std::max( earliest, dataBusAvailCycle - m_cycles );
+            return earliest;
+        }
+
+        SimTime_t getFiniTime() { return m_finiTime; }
+
         bool isDone( SimTime_t now ) {
 
             if (is_debug)
@@ -210,15 +238,23 @@ private:
         }
 
         // these are used for debugging
-        std::string& getName()  { return m_name; }
+        const std::string& getName() {
+            static const std::string names[] = { "PRE", "ACT", "COL" };
+            return names[m_op];
+        }
         unsigned getRank()      { return m_bank->getRank(); }
         unsigned getBank()      { return m_bank->getBank(); }
         unsigned getRow()       { return m_row; }
         Transaction* getTrans() { return m_trans; }
       private:
 
+        struct CmdBlock { CmdBlock* next; };
+        static CmdBlock*& freeList() {
+            static thread_local CmdBlock* head = nullptr;
+            return head;
+        }
+
         Bank*           m_bank;
-        std::string     m_name;
         unsigned        m_cycles;
         unsigned        m_row;
         unsigned        m_dataCycles;
@@ -249,11 +285,21 @@ private:
 
             m_banks[bank]->pushTrans( trans );
 
-            m_banksActive.insert(bank);
+            setActive(bank);
         }
 
         bool hasActiveBanks() {
-            return !m_banksActive.empty();
+            return m_numActive != 0;
+        }
+
+        SimTime_t nextIssueCycle( SimTime_t cycle, SimTime_t dataBusAvailCycle );
+
+        bool isIdle() {
+            for ( unsigned i = 0; i < m_banks.size(); i++ ) {
+                if ( isActive(i) && ! m_banks[i]->isIdle() )
+                    return false;
+            }
+            return true;
         }
 
       private:
@@ -263,9 +309,24 @@ private:
         AddrMapper*     m_mapper;
         std::string     m_pre;
 
+        bool isActive( unsigned bank ) {
+            return m_banksActive[bank >> 6] & (1ull << (bank & 63));
+        }
+        void setActive( unsigned bank ) {
+            if (!isActive(bank)) {
+                m_banksActive[bank >> 6] |= (1ull << (bank & 63));
+                m_numActive++;
+            }
+        }
+        void clearActive( unsigned bank ) {
+            m_banksActive[bank >> 6] &= ~(1ull << (bank & 63));
+            m_numActive--;
+        }
+
         unsigned            m_nextBankUp;
         std::vector<Bank*>  m_banks;
-        std::set<unsigned>  m_banksActive;
+        std::vector<uint64_t> m_banksActive; // Bit per bank with work queued
+        unsigned            m_numActive;
     };
 
     class Channel : public ComponentExtension {
@@ -275,7 +336,7 @@ private:
       public:
         static const uint64_t DBG_MASK = (1 << 1);
 
-        Channel( ComponentId_t, std::function<void(ReqId)>, Params&, unsigned mc, unsigned chan, Output*, AddrMapper* );
+        Channel( ComponentId_t, std::function<void(ReqId)>, Params&, unsigned mc, unsigned chan, Output*, AddrMapper*, bool eventDriven );
 
         bool issue( SimTime_t createTime, ReqId id, Addr addr, bool isWrite, unsigned numBytes ) {
 
@@ -292,18 +353,34 @@ private:
                                                 m_mapper->getRow(addr) );
             m_pendingCount++;
             m_ranks[ rank ]->pushTrans( trans );
+            m_wakeCycle = 0;
             return true;
         }
 
         void clock(SimTime_t );
 
+        /* Nothing queued or in flight and no bank waiting to close a row */
+        bool isIdle() {
+            if ( m_pendingCount != 0 || ! m_issuedCmds.empty() )
+                return false;
+            for ( unsigned i = 0; i < m_ranks.size(); i++ ) {
+                if ( ! m_ranks[i]->isIdle() )
+                    return false;
+            }
+            return true;
+        }
+
       private:
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
+        SimTime_t nextWakeCycle( SimTime_t cycle );
         const char* prefix() { return m_pre.c_str(); }
         Output*             m_output;
         AddrMapper*         m_mapper;
         std::string         m_pre;
 
+        bool                m_eventDriven;
+        SimTime_t           m_wakeCycle;    // eventDriven: the channel cannot change state before this cycle
+
         unsigned            m_nextRankUp;
         std::vector<Rank*>  m_ranks;
 
@@ -311,7 +388,7 @@ private:
         unsigned            m_maxPendingTrans;
         unsigned            m_pendingCount;
 
-        std::list<Cmd*>     m_issuedCmds;
+        std::vector<Cmd*>   m_issuedCmds;   // In issue order
         std::queue<Transaction*> m_retiredTrans;
 
         std::function<void(ReqId)> m_responseHandler;
@@ -328,12 +405,15 @@ public:
         handleMemResponse( id );
     }
     virtual bool clock(Cycle_t cycle);
+    virtual void clockOn(Cycle_t cycle);
     virtual void finish() {}
 
 private:
     std::vector<Channel*> m_channels;
     AddrMapper* m_mapper;
     SimTime_t   m_cycle;
+    bool        m_eventDriven;
+    Cycle_t     m_lastClock;    // eventDriven: cycle of the previous clock() call
 
 };
 
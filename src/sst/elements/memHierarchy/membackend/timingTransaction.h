@@ -15,6 +15,11 @@
 
 #include <sst/core/subcomponent.h>
 
+#include <list>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+
 namespace SST {
 namespace MemHierarchy {
 namespace TimingDRAM_NS {
@@ -51,6 +56,12 @@ class TransactionQ : public SST::SubComponent {
 /* Begin class definition */
     TransactionQ( ComponentId_t id, Params& params ) : SubComponent( id )  {}
 
+    // Transactions still queued at the end of simulation belong to the queue
+    virtual ~TransactionQ() {
+        for ( std::list<Transaction*>::iterator it = m_transQ.begin(); it != m_transQ.end(); it++ )
+            delete *it;
+    }
+
     virtual void push( Transaction* trans ) {
         m_transQ.push_back( trans );
     }
@@ -133,6 +144,170 @@ class ReorderTransactionQ : public TransactionQ {
     unsigned  windowCycles;
 };
 
+/*
+ * First-ready, first-come-first-served queue
+ *
+ * Requests that hit the open row are served before older requests to other rows.
+ * Requests are indexed by row so that selecting a row hit or the oldest request is
+ * constant time regardless of queue depth.
+ *
+ * Optional extensions:
+ *  - Write drain: reads are served ahead of writes until 'write_high_watermark' writes are
+ *    queued, then writes are drained until no more than 'write_low_watermark' remain.
+ *  - Blacklisting (after BLISS): a row that is served 'blacklist_threshold' times in a row
+ *    loses its row-hit priority until the blacklist is cleared, which happens every
+ *    'blacklist_clear_interval' requests. Transactions carry no source, so rows stand in
+ *    for the applications that BLISS tracks.
+ */
+class FRFCFSTransactionQ : public TransactionQ {
+
+  public:
+/* Element Library Info */
+    SST_ELI_REGISTER_SUBCOMPONENT(FRFCFSTransactionQ, "memHierarchy", "frfcfsTransactionQ", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "first-ready first-come-first-served transaction queue with optional write drain and row blacklisting", SST::MemHierarchy::TimingDRAM_NS::TransactionQ)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"write_high_watermark", "Number of queued writes that starts a write drain. While not draining, reads are served before writes. 0 disables write draining and serves reads and writes in a single order.", "0"},
+            {"write_low_watermark", "Number of queued writes at which a write drain ends", "0"},
+            {"blacklist_threshold", "Number of consecutive requests served from one row before the row loses row-hit priority. 0 disables blacklisting.", "0"},
+            {"blacklist_clear_interval", "Number of requests served between clearing the blacklist", "1000"} )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"row_hits", "Requests served ahead of older requests because they hit the open row", "count", 1},
+            {"write_drains", "Number of write drains started", "count", 1},
+            {"rows_blacklisted", "Number of times a row was blacklisted", "count", 2} )
+
+/* Begin class definition */
+
+    FRFCFSTransactionQ( ComponentId_t id, Params& params ) : TransactionQ( id, params ), m_draining(false),
+        m_streakRow(-1), m_streak(0), m_servedSinceClear(0) {
+        m_writeHigh = params.find<unsigned>("write_high_watermark", 0);
+        m_writeLow = params.find<unsigned>("write_low_watermark", 0);
+        m_blacklistThreshold = params.find<unsigned>("blacklist_threshold", 0);
+        m_blacklistInterval = params.find<unsigned>("blacklist_clear_interval", 1000);
+
+        if ( m_writeHigh != 0 && m_writeLow >= m_writeHigh ) {
+            getSimulationOutput().fatal(CALL_INFO, -1, "Invalid param(%s): write_low_watermark - must be less than write_high_watermark (%u). You specified %u.\n",
+                    getName().c_str(), m_writeHigh, m_writeLow);
+        }
+
+        stat_rowHits = registerStatistic<uint64_t>("row_hits");
+        stat_writeDrains = registerStatistic<uint64_t>("write_drains");
+        stat_blacklisted = registerStatistic<uint64_t>("rows_blacklisted");
+    }
+
+    ~FRFCFSTransactionQ() {
+        for ( std::list<Transaction*>::iterator it = m_reads.order.begin(); it != m_reads.order.end(); it++ )
+            delete *it;
+        for ( std::list<Transaction*>::iterator it = m_writes.order.begin(); it != m_writes.order.end(); it++ )
+            delete *it;
+    }
+
+    virtual void push( Transaction* trans ) {
+        Queue& queue = ( m_writeHigh != 0 && trans->isWrite ) ? m_writes : m_reads;
+        queue.order.push_back( trans );
+        queue.rows[trans->row].push_back( std::prev( queue.order.end() ) );
+
+        if ( m_writeHigh != 0 && ! m_draining && m_writes.order.size() >= m_writeHigh ) {
+            m_draining = true;
+            stat_writeDrains->addData(1);
+        }
+    }
+
+    virtual Transaction* pop( unsigned row ) {
+        Transaction* trans;
+        if ( m_draining || m_reads.order.empty() ) {
+            trans = select( m_writes, m_reads, row );
+        } else {
+            trans = select( m_reads, m_writes, row );
+        }
+
+        if ( trans ) {
+            if ( m_draining && m_writes.order.size() <= m_writeLow )
+                m_draining = false;
+            if ( m_blacklistThreshold != 0 )
+                updateBlacklist( trans->row );
+        }
+        return trans;
+    }
+
+    virtual bool empty() {
+        return m_reads.order.empty() && m_writes.order.empty();
+    }
+
+  private:
+
+    /* Requests in arrival order, plus each row's requests in arrival order */
+    struct Queue {
+        std::list<Transaction*> order;
+        std::unordered_map<unsigned, std::deque<std::list<Transaction*>::iterator> > rows;
+    };
+
+    /* Row hit in 'first', else the oldest request in 'first'; 'second' is only used if 'first' is empty.
+     * With write draining off all requests are in m_reads so this is plain FR-FCFS. */
+    Transaction* select( Queue& first, Queue& second, unsigned row ) {
+        Queue& queue = first.order.empty() ? second : first;
+        if ( queue.order.empty() )
+            return nullptr;
+
+        if ( m_blacklist.find(row) == m_blacklist.end() ) {
+            auto hit = queue.rows.find(row);
+            if ( hit != queue.rows.end() ) {
+                std::list<Transaction*>::iterator it = hit->second.front();
+                hit->second.pop_front();
+                if ( hit->second.empty() )
+                    queue.rows.erase(hit);
+                if ( it != queue.order.begin() )
+                    stat_rowHits->addData(1);
+                Transaction* trans = *it;
+                queue.order.erase(it);
+                return trans;
+            }
+        }
+
+        /* Oldest request; it is also the oldest request to its row */
+        Transaction* trans = queue.order.front();
+        auto rowQ = queue.rows.find(trans->row);
+        rowQ->second.pop_front();
+        if ( rowQ->second.empty() )
+            queue.rows.erase(rowQ);
+        queue.order.pop_front();
+        return trans;
+    }
+
+    void updateBlacklist( unsigned row ) {
+        if ( row == m_streakRow ) {
+            if ( ++m_streak == m_blacklistThreshold && m_blacklist.insert(row).second )
+                stat_blacklisted->addData(1);
+        } else {
+            m_streakRow = row;
+            m_streak = 1;
+        }
+        if ( ++m_servedSinceClear >= m_blacklistInterval ) {
+            m_blacklist.clear();
+            m_servedSinceClear = 0;
+        }
+    }
+
+    Queue       m_reads;    // All requests if write draining is off
+    Queue       m_writes;
+
+    unsigned    m_writeHigh;
+    unsigned    m_writeLow;
+    bool        m_draining;
+
+    unsigned    m_blacklistThreshold;
+    unsigned    m_blacklistInterval;
+    unsigned    m_streakRow;
+    unsigned    m_streak;
+    unsigned    m_servedSinceClear;
+    std::unordered_set<unsigned> m_blacklist;
+
+    Statistic<uint64_t>* stat_rowHits;
+    Statistic<uint64_t>* stat_writeDrains;
+    Statistic<uint64_t>* stat_blacklisted;
+};
+
 }
 }
 }
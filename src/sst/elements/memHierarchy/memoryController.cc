@@ -61,6 +61,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     fixupParams( params, "backend.", "backendConvertor.backend." );
     fixupParams( params, "request_width", "backendConvertor.request_width" );
     fixupParams( params, "max_requests_per_cycle", "backendConvertor.backend.max_requests_per_cycle" );
+    fixupParam( params, "host_profile", "backendConvertor.host_profile" );
 
     uint32_t requestWidth = params.find<uint32_t>("backendConvertor.request_width", 64);
 
@@ -122,6 +123,11 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     clockTimeBase_ = registerClock(clockfreq, clockHandler_);
     clockOn_ = true;
 
+    profiler_.enable(params.find<bool>("host_profile", false));
+    profEvent_ = profiler_.addHandler("handleEvent");
+    profClock_ = profiler_.addHandler("clock");
+    profResponse_ = profiler_.addHandler("handleMemResponse");
+
 
     string link_lat         = params.find<std::string>("direct_link_latency", "10 ns");
 
@@ -283,8 +289,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "paged" && backingType != "cow") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'paged', 'cow', or 'mmap'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -335,6 +341,42 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         } else {
             backing_ = new Backend::BackingMalloc(sizeBytes,initBacking);
         }
+    } else if (backingType == "cow") {
+        std::string memoryFile = params.find<std::string>("memory_file", NO_STRING_DEFINED );
+        if ( 0 == memoryFile.compare( NO_STRING_DEFINED ) ) {
+            out.fatal(CALL_INFO, -1, "%s, Error - 'cow' backing requires a base image. Set the memory_file parameter.\n", getName().c_str());
+        }
+        try {
+            backing_ = new Backend::BackingCOW( memoryFile, memBackendConvertor_->getMemSize() );
+        }
+        catch ( int e ) {
+            if (e == 1)
+                out.fatal(CALL_INFO, -1, "%s, Error - unable to open memory_file. You specified '%s'.\n", getName().c_str(), memoryFile.c_str());
+            else
+                out.fatal(CALL_INFO, -1, "%s, Error - Could not MMAP backing store from file %s\n", getName().c_str(), memoryFile.c_str());
+        }
+    } else if (backingType == "paged") {
+        std::string pageSize = params.find<std::string>("backing_page_size", "4KiB");
+        UnitAlgebra page_ua(pageSize);
+        if (!page_ua.hasUnits("B")) {
+            out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing_page_size. Must have units of bytes (B). SI ok. You specified: %s\n",
+                    getName().c_str(), pageSize.c_str());
+        }
+        Backend::BackingPaged* paged = new Backend::BackingPaged(page_ua.getRoundedValue());
+        std::string parent = params.find<std::string>("checkpoint_parent", "");
+        if ( CHECKPOINT_LOAD == checkpoint_ ) {
+            stringstream filename;
+            filename << checkpointDir_ << "/" << getName();
+            paged->restore(filename.str());
+        } else if ( !parent.empty() ) {
+            stringstream filename;
+            filename << checkpointDir_ << "/" << getName();
+            if ( CHECKPOINT_SAVE == checkpoint_ && parent == filename.str() )
+                out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: checkpoint_parent. Must differ from the checkpoint being saved (%s).\n",
+                        getName().c_str(), parent.c_str());
+            paged->restore(parent);
+        }
+        backing_ = paged;
     }
 
     /* Custom command handler */
@@ -353,13 +395,14 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
 }
 
 void MemController::handleEvent(SST::Event* event) {
+    MemEventBase *meb = static_cast<MemEventBase*>(event);
+    HostProfiler::Scope prof(profiler_, profEvent_, meb->getCmd());
+
     if (!clockOn_) {
         Cycle_t cycle = turnClockOn();
         memBackendConvertor_->turnClockOn(cycle);
     }
 
-    MemEventBase *meb = static_cast<MemEventBase*>(event);
-
     if (is_debug_event(meb)) {
         Debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:New     (%s)\n",
                     getCurrentSimCycle(), getNextClockCycle(clockTimeBase_) - 1, getName().c_str(), meb->getVerboseString(dlevel).c_str());
@@ -469,6 +512,7 @@ void MemController::handleEvent(SST::Event* event) {
 }
 
 bool MemController::clock(Cycle_t cycle) {
+    HostProfiler::Scope prof(profiler_, profClock_);
     bool unclockLink = true;
     if (clockLink_) {
         unclockLink = link_->clock();
@@ -514,6 +558,7 @@ void MemController::handleCustomEvent(MemEventBase * ev) {
 
 
 void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
+    HostProfiler::Scope prof(profiler_, profResponse_);
 
     std::map<SST::Event::id_type,MemEventBase*>::iterator it = outstandingEvents_.find(id);
     if (it == outstandingEvents_.end())
@@ -521,6 +566,7 @@ void MemController::handleMemResponse( Event::id_type id, uint32_t flags ) {
 
     MemEventBase * evb = it->second;
     outstandingEvents_.erase(it);
+    prof.setCommand(evb->getCmd());
 
     if (is_debug_event(evb)) {
         Debug(_L4_, "B: %-20" PRIu64 " %-20" PRIu64 " %-20s Bkend:Recv    (<%" PRIu64 ",%" PRIu32 ">)\n",
@@ -603,6 +649,7 @@ void MemController::finish(void) {
     cycle--;
     memBackendConvertor_->finish(cycle);
     link_->finish();
+    profiler_.print(out, getName());
     if ( CHECKPOINT_SAVE ==  checkpoint_ ) {
         stringstream filename;
         filename << checkpointDir_ << "/" << getName();
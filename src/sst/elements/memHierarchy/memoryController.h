@@ -26,6 +26,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/membackend/backing.h"
 #include "sst/elements/memHierarchy/customcmd/customCmdMemory.h"
+#include "sst/elements/memHierarchy/hostProfiler.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -50,14 +51,17 @@ public:
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},\
             {"listenercount",       "(uint) Counts the number of listeners attached to this controller, these are modules for tracing or components like prefetchers", "0"},\
             {"listener%(listenercount)d", "(string) Loads a listener module into the controller", ""},\
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'paged' - sparse page directory with binary incremental checkpoints, 'cow' - copy-on-write view of the read-only image in memory_file (shareable by many controllers), or 'mmap'", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
-            {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_page_size",   "(string) For 'paged' backing stores, page size. Must be a power of two.", "4KiB"},\
+            {"checkpoint_parent",   "(string) For 'paged' backing stores, checkpoint file to restore at startup. A checkpoint saved by this simulation then only contains pages written since the restore.", ""},\
+            {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state. With 'cow' backing, the base image (never modified)", "N/A"},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
             {"interleave_step",     "(string) Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
-            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""}
+            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""},\
+            {"host_profile",        "(bool) Measure host time spent in the event and clock handlers of the controller and backend convertor, per handler and per command, and print a 'HostProfile:' summary at the end of simulation.", "false"}
 
     SST_ELI_DOCUMENT_PARAMS( MEMCONTROLLER_ELI_PARAMS )
 
@@ -88,7 +92,7 @@ public:
 
     virtual void handleMemResponse( SST::Event::id_type id, uint32_t flags );
 
-    SST::Cycle_t turnClockOn();
+    virtual SST::Cycle_t turnClockOn();
 
     /* For updating memory values. CustomMemoryCommand should call this */
     void writeData(Addr addr, std::vector<uint8_t>* data);
@@ -125,6 +129,11 @@ protected:
     std::set<Addr> DEBUG_ADDR;
     int dlevel;
 
+    HostProfiler profiler_;
+    unsigned profEvent_;    // handleEvent()
+    unsigned profClock_;    // clock()
+    unsigned profResponse_; // handleMemResponse()
+
     MemBackendConvertor*    memBackendConvertor_;
     Backend::Backing*       backing_;
 
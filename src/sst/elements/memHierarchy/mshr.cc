@@ -17,11 +17,12 @@
 #include "mshr.h"
 
 #include <algorithm>
+#include <iterator>
 
 using namespace SST;
 using namespace SST::MemHierarchy;
 
-MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr) :
+MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std::set<Addr> debugAddr, bool flat) :
     ComponentExtension(cid)
 {
     d_ = debug;
@@ -34,8 +35,120 @@ MSHR::MSHR(ComponentId_t cid, Output* debug, int maxSize, string cacheName, std:
     d2_->init("", 10, 0, (Output::output_location_t)1);
 
     DEBUG_ADDR = debugAddr;
+
+    flat_ = flat;
+    table_ = flat ? new MSHRTable(maxSize) : nullptr;
+    oldest_ = nullptr;
+    newest_ = nullptr;
+}
+
+MSHR::~MSHR() {
+    if (table_)
+        delete table_;
+    for (std::vector<std::list<Addr>*>::iterator it = evictPool_.begin(); it != evictPool_.end(); it++)
+        delete *it;
+}
+
+/**************************************************************************
+ * Storage helpers
+ **************************************************************************/
+
+MSHRRegister* MSHR::findRegister(Addr addr) {
+    if (flat_)
+        return table_->find(addr);
+    MSHRBlock::iterator it = mshr_.find(addr);
+    return (it == mshr_.end()) ? nullptr : &(it->second);
+}
+
+MSHRRegister* MSHR::getRegister(Addr addr) {
+    if (flat_)
+        return table_->insert(addr);
+    return &(mshr_[addr]);
 }
 
+void MSHR::eraseRegister(Addr addr) {
+    if (flat_)
+        table_->erase(addr);
+    else
+        mshr_.erase(addr);
+}
+
+std::list<MSHREntry>::iterator MSHR::insertEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator pos, const MSHREntry& entry) {
+    if (!flat_)
+        return reg->entries.insert(pos, entry);
+
+    std::list<MSHREntry>::iterator it;
+    if (entryPool_.empty()) {
+        it = reg->entries.insert(pos, entry);
+    } else {
+        reg->entries.splice(pos, entryPool_, entryPool_.begin());
+        it = std::prev(pos);
+        *it = entry;
+    }
+    if (it->getType() == MSHREntryType::Event)
+        ageLink(&(*it));
+    return it;
+}
+
+void MSHR::eraseEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator entry) {
+    if (!flat_) {
+        reg->entries.erase(entry);
+        return;
+    }
+
+    if (entry->getType() == MSHREntryType::Event) {
+        ageUnlink(&(*entry));
+    } else if (entry->getType() == MSHREntryType::Evict) {
+        entry->evictPtrs->clear();
+        evictPool_.push_back(entry->evictPtrs);
+        entry->evictPtrs = nullptr;
+    }
+    entryPool_.splice(entryPool_.begin(), reg->entries, entry);
+}
+
+MSHREntry MSHR::makeEvictEntry(Addr newAddr) {
+    if (!flat_)
+        return MSHREntry(newAddr, getCurrentSimCycle());
+
+    std::list<Addr>* ptrs;
+    if (evictPool_.empty()) {
+        ptrs = new std::list<Addr>;
+    } else {
+        ptrs = evictPool_.back();
+        evictPool_.pop_back();
+    }
+    ptrs->push_back(newAddr);
+    return MSHREntry(ptrs, getCurrentSimCycle());
+}
+
+/* Entries are always inserted at the current time so the age list stays ordered by appending */
+void MSHR::ageLink(MSHREntry* entry) {
+    entry->newer = nullptr;
+    entry->older = newest_;
+    if (newest_)
+        newest_->newer = entry;
+    else
+        oldest_ = entry;
+    newest_ = entry;
+}
+
+void MSHR::ageUnlink(MSHREntry* entry) {
+    if (entry->older)
+        entry->older->newer = entry->newer;
+    else
+        oldest_ = entry->newer;
+    if (entry->newer)
+        entry->newer->older = entry->older;
+    else
+        newest_ = entry->older;
+    entry->older = nullptr;
+    entry->newer = nullptr;
+}
+
+/**************************************************************************
+ * MSHR API
+ **************************************************************************/
+
 int MSHR::getMaxSize() {
     return maxSize_;
 }
@@ -45,44 +158,47 @@ int MSHR::getSize() {
 }
 
 unsigned int MSHR::getSize(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr)
         return 0;
     else
-        return mshr_.find(addr)->second.entries.size();
+        return reg->entries.size();
 }
 
 bool MSHR::exists(Addr addr) {
-    return mshr_.find(addr) != mshr_.end();
+    return findRegister(addr) != nullptr;
 }
 
 MSHREntry MSHR::getEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
-        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, mshr_.find(addr)->second.entries.size());
+    if (reg->entries.size() <= index) {
+        d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntry(0x%" PRIx64 ", %zu). Entry list size is %zu.\n", ownerName_.c_str(), addr, index, reg->entries.size());
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    std::list<MSHREntry>::iterator it = reg->entries.begin();
     std::advance(it, index);
     return *it;
 }
 
 MSHREntry MSHR::getFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front();
+    return reg->entries.front();
 }
 
 void MSHR::removeEntry(Addr addr, size_t index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEntry(0x%" PRIx64 ", %zu). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
@@ -96,22 +212,22 @@ void MSHR::removeEntry(Addr addr, size_t index) {
     if (is_debug_addr(addr))
         printDebug(10, "Remove", addr, (*entry).getString().c_str());
 
-    reg->entries.erase(entry);
+    eraseEntry(reg, entry);
     if (reg->entries.empty()) {
         if (is_debug_addr(addr))
             printDebug(10, "Erase", addr, "");
             //d_->debug(_L10_, "M: %-41" PRIu64 " %-20s Erase        0x%-16" PRIx64 " %-10d\n",
             //        getCurrentSimCycle(), ownerName_.c_str(), addr, size_);
             //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
+        eraseRegister(addr);
     }
 }
 
 void MSHR::removeFront(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeFront(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
@@ -119,31 +235,32 @@ void MSHR::removeFront(Addr addr) {
    // if (is_debug_addr(addr))
    //     d_->debug(_L10_, "    MSHR::removeFront(0x%" PRIx64 ", %s)\n", addr, reg->entries.front().getString().c_str());
 
-    if (getFrontType(addr) == MSHREntryType::Event)
+    if (reg->entries.front().getType() == MSHREntryType::Event)
         size_--;
 
     if (is_debug_addr(addr))
         printDebug(10, "RemFr", addr, (reg->entries.front()).getString().c_str());
 
-    reg->entries.pop_front();
+    eraseEntry(reg, reg->entries.begin());
     if (reg->entries.empty()) {
         if (is_debug_addr(addr))
             printDebug(10, "Erase", addr, "");
             //d_->debug(_L10_, "    MSHR: erasing 0x%" PRIx64 " from MSHR\n", addr);
-        mshr_.erase(addr);
+        eraseRegister(addr);
     }
 }
 
 MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
     //if (is_debug_addr(addr))
     //    d_->debug(_L20_, "    MSHR::getEntryType(0x%" PRIx64 ", %zu)\n", addr, index);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    if (mshr_.find(addr)->second.entries.size() <= index) {
+    if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEntryType(0x%" PRIx64 ", %zu). Entry list is shoerter than index.\n", ownerName_.c_str(), addr, index);
     }
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    std::list<MSHREntry>::iterator it = reg->entries.begin();
     std::advance(it, index);
     return it->getType();
 }
@@ -151,23 +268,24 @@ MSHREntryType MSHR::getEntryType(Addr addr, size_t index) {
 MSHREntryType MSHR::getFrontType(Addr addr) {
     //if (is_debug_addr(addr))
     //    d_->debug(_L20_, "    MSHR::getFrontType(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getFrontType(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front().getType();
+    return reg->entries.front().getType();
 }
 
 MemEventBase* MSHR::getEntryEvent(Addr addr, size_t index) {
     //if (is_debug_addr(addr))
     //    d_->debug(_L20_, "    MSHR::getEntryEvent(0x%" PRIx64 ", %zu)\n", addr, index);
-
-    if (mshr_.find(addr) == mshr_.end() || mshr_.find(addr)->second.entries.size() <= index)
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr || reg->entries.size() <= index)
         return nullptr;
 
-    std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+    std::list<MSHREntry>::iterator it = reg->entries.begin();
     std::advance(it, index);
     if (it->getType() != MSHREntryType::Event)
         return nullptr;
@@ -181,17 +299,17 @@ MemEventBase* MSHR::getFrontEvent(Addr addr) {
     if (getFrontType(addr) != MSHREntryType::Event) {
         return nullptr;
     }
-    return mshr_.find(addr)->second.entries.front().getEvent();
+    return findRegister(addr)->entries.front().getEvent();
 }
 
 MemEventBase* MSHR::getFirstEventEntry(Addr addr, Command cmd) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getFirstEventEntry(0x%" PRIx64 ", %s)\n", addr, CommandString[(int)cmd]);
-
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr)
         return nullptr;
 
-    for (std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin(); it != mshr_.find(addr)->second.entries.end(); it++) {
+    for (std::list<MSHREntry>::iterator it = reg->entries.begin(); it != reg->entries.end(); it++) {
         if (it->getType() == MSHREntryType::Event && it->getEvent()->getCmd() == cmd)
             return it->getEvent();
     }
@@ -202,7 +320,7 @@ std::list<Addr>* MSHR::getEvictPointers(Addr addr) {
     if (getFrontType(addr) != MSHREntryType::Evict)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getEvictPointers(0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr);
 
-    return mshr_.find(addr)->second.entries.front().getPointers();
+    return findRegister(addr)->entries.front().getPointers();
 }
 
 // Return whether we should retry a new event or not
@@ -216,16 +334,18 @@ bool MSHR::removeEvictPointer(Addr addr, Addr addrPtr) {
         printDebug(10, "RemPtr", addr, reason.str());
     }
 
+    MSHRRegister* reg = findRegister(addr);
+
     // Sometimes we insert a WB before the Evict & then remove the Evict pointer, othertimes the Evict is front
     if (getFrontType(addr) == MSHREntryType::Evict) {
-        MSHREntry * entry = &(mshr_.find(addr)->second.entries.front());
+        MSHREntry * entry = &(reg->entries.front());
         entry->getPointers()->remove(addrPtr);
         if (entry->getPointers()->empty()) {
             removeFront(addr);
             return true;
         }
     } else {
-        std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+        std::list<MSHREntry>::iterator it = reg->entries.begin();
         it++;
         if (it->getType() != MSHREntryType::Evict)
             d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removeEvictPointer(0x%" PRIx64 ", 0x%" PRIx64 "). Entry type is not Evict.\n", ownerName_.c_str(), addr, addrPtr);
@@ -243,7 +363,7 @@ bool MSHR::pendingWriteback(Addr addr) {
 
 bool MSHR::pendingWritebackIsDowngrade(Addr addr) {
     if (pendingWriteback(addr))
-        return mshr_.find(addr)->second.entries.front().getDowngrade();
+        return findRegister(addr)->entries.front().getDowngrade();
     return false;
 }
 
@@ -260,11 +380,11 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
     // Success
     size_++;
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
+        reg = getRegister(addr);
+        insertEntry(reg, reg->entries.end(), MSHREntry(event, stallEvict, getCurrentSimCycle()));
 
-        mshr_.insert(std::make_pair(addr, reg));
         if (is_debug_addr(addr)) {
             stringstream reason;
             reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=0";
@@ -274,18 +394,18 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
 
         return 0;
     } else {
-        if (pos == -1 || pos > mshr_.find(addr)->second.entries.size()) {
-            mshr_.find(addr)->second.entries.push_back(MSHREntry(event, stallEvict, getCurrentSimCycle()));
+        if (pos == -1 || pos > reg->entries.size()) {
+            insertEntry(reg, reg->entries.end(), MSHREntry(event, stallEvict, getCurrentSimCycle()));
             if (is_debug_addr(addr)) {
                 stringstream reason;
-                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries.size() - 1);
+                reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (reg->entries.size() - 1);
                 printDebug(10, "InsEv", addr, reason.str());
             }
-            return (mshr_.find(addr)->second.entries.size() - 1);
+            return (reg->entries.size() - 1);
         } else {
-            std::list<MSHREntry>::iterator it = mshr_.find(addr)->second.entries.begin();
+            std::list<MSHREntry>::iterator it = reg->entries.begin();
             std::advance(it, pos);
-            mshr_.find(addr)->second.entries.insert(it, MSHREntry(event, stallEvict, getCurrentSimCycle()));
+            insertEntry(reg, it, MSHREntry(event, stallEvict, getCurrentSimCycle()));
             if (is_debug_addr(addr)) {
                 stringstream reason;
                 reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << pos;
@@ -304,9 +424,10 @@ int MSHR::insertEvent(Addr addr, MemEventBase* event, int pos, bool fwdRequest,
  *      -1 = conflict, not inserted
  */
 int MSHR::insertEventIfConflict(Addr addr, MemEventBase* event) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr)
         return 0;
-    
+
     if (size_ == maxSize_-1) { /* Assuming fwdEvent == false */
         if (is_debug_addr(addr)) {
             stringstream reason;
@@ -316,30 +437,39 @@ int MSHR::insertEventIfConflict(Addr addr, MemEventBase* event) {
         return -1;
     }
     size_++;
-    mshr_.find(addr)->second.entries.push_back(MSHREntry(event, false, getCurrentSimCycle()));
+    insertEntry(reg, reg->entries.end(), MSHREntry(event, false, getCurrentSimCycle()));
     if (is_debug_addr(addr)) {
         stringstream reason;
-        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (mshr_.find(addr)->second.entries.size() - 1);
+        reason << "<" << event->getID().first << "," << event->getID().second << ">, pos=" << (reg->entries.size() - 1);
         printDebug(10, "InsEv", addr, reason.str());
     }
-    return (mshr_.find(addr)->second.entries.size() - 1);
+    return (reg->entries.size() - 1);
 }
 
 MemEventBase* MSHR::swapFrontEvent(Addr addr, MemEventBase* event) {
     if (is_debug_addr(addr))
         printDebug(10, "SwpEv", addr, "");
 
-    if (mshr_.find(addr)->second.entries.empty())
+    MSHRRegister* reg = findRegister(addr);
+    if (reg->entries.empty())
         return nullptr;
 
-    return  mshr_.find(addr)->second.entries.front().swapEvent(event, getCurrentSimCycle());
+    MSHREntry* entry = &(reg->entries.front());
+    MemEventBase* oldEvent = entry->swapEvent(event, getCurrentSimCycle());
+
+    // Start time was reset so the entry is now the newest
+    if (flat_ && entry->getType() == MSHREntryType::Event) {
+        ageUnlink(entry);
+        ageLink(entry);
+    }
+    return oldEvent;
 }
 
 void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister * reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Address doesn't exist in MSHR.\n", ownerName_.c_str(), addr, index);
     }
-    MSHRRegister * reg = &(mshr_.find(addr)->second);
     if (reg->entries.size() <= index) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::moveEntryToFront(0x%" PRIx64 ", %u). Entry list is shorter than requested index.\n", ownerName_.c_str(), addr, index);
     }
@@ -347,31 +477,24 @@ void MSHR::moveEntryToFront(Addr addr, unsigned int index) {
     std::list<MSHREntry>::iterator entry = reg->entries.begin();
     std::advance(entry, index);
 
-    MSHREntry tmpEntry = *entry;
-
     if (is_debug_addr(addr))
         printDebug(10, "MvEnt", addr, entry->getString());
-    reg->entries.erase(entry);
-    reg->entries.push_front(tmpEntry);
+
+    // Relink in place so the entry keeps its address (and its age list position)
+    reg->entries.splice(reg->entries.begin(), reg->entries, entry);
 }
 
 bool MSHR::insertWriteback(Addr addr, bool downgrade) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L10_, "    MSHR::insertWriteback(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr)) {
         stringstream reason;
         reason << "Downgrade: " << (downgrade ? "T" : "F");
         printDebug(10, "InsWB", addr, reason.str());
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(downgrade, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(addr, reg));
-    } else {
-        mshr_.find(addr)->second.entries.push_front(MSHREntry(downgrade, getCurrentSimCycle()));
-    }
+    MSHRRegister* reg = getRegister(addr);
+    insertEntry(reg, reg->entries.begin(), MSHREntry(downgrade, getCurrentSimCycle()));
 
     return true;
 }
@@ -380,24 +503,18 @@ bool MSHR::insertWriteback(Addr addr, bool downgrade) {
 bool MSHR::insertEviction(Addr oldAddr, Addr newAddr) {
 //    if (is_debug_addr(oldAddr) || is_debug_addr(newAddr))
 //        d_->debug(_L10_, "    MSHR::insertEviction(0x%" PRIx64 ", 0x%" PRIx64 ")\n", oldAddr, newAddr);
-
     if (is_debug_addr(oldAddr) || is_debug_addr(newAddr)) {
         stringstream reason;
         reason << "to 0x" << std::hex << newAddr;
         printDebug(10, "InsPtr", oldAddr, reason.str());
     }
 
-    if (mshr_.find(oldAddr) == mshr_.end()) {  // No MSHR entry for oldAddr
-        MSHRRegister reg;
-        reg.entries.push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        mshr_.insert(std::make_pair(oldAddr, reg));
-    } else {
-        list<MSHREntry>* entries = &(mshr_.find(oldAddr)->second.entries);
-        if (!entries->empty() && entries->back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
-            entries->back().getPointers()->push_back(newAddr);
-        } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
-            entries->push_back(MSHREntry(newAddr, getCurrentSimCycle()));
-        }
+    MSHRRegister* reg = getRegister(oldAddr);
+    list<MSHREntry>* entries = &(reg->entries);
+    if (!entries->empty() && entries->back().getType() == MSHREntryType::Evict) { // MSHR entry for oldAddr is an Evict
+        entries->back().getPointers()->push_back(newAddr);
+    } else { // MSHR entry for oldAddr is not an Evict (or no entry exists)
+        insertEntry(reg, entries->end(), makeEvictEntry(newAddr));
     }
     return true;
 }
@@ -406,27 +523,30 @@ void MSHR::addPendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "IncRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::addPendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.addPendingRetry();
+    reg->addPendingRetry();
 }
 
 void MSHR::removePendingRetry(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "DecRetry", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::removePendingRetry(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.removePendingRetry();
+    reg->removePendingRetry();
 }
 
 uint32_t MSHR::getPendingRetries(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr)
         return 0;
 
-    return mshr_.find(addr)->second.getPendingRetries();
+    return reg->getPendingRetries();
 }
 
 
@@ -436,23 +556,22 @@ void MSHR::setInProgress(Addr addr, bool value) {
     if (is_debug_addr(addr))
         printDebug(20, "InProg", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setInProgress(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setInProgress(value);
+    reg->entries.front().setInProgress(value);
 }
 
 bool MSHR::getInProgress(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr || reg->entries.empty()) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        return false;
-    }
-    return mshr_.find(addr)->second.entries.front().getInProgress();
+    return reg->entries.front().getInProgress();
 }
 
 void MSHR::setStalledForEvict(Addr addr, bool set) {
@@ -463,56 +582,58 @@ void MSHR::setStalledForEvict(Addr addr, bool set) {
             printDebug(20, "Unstall", addr, "");
     }
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setStalledForEvict(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setStalledForEvict(set);
+    reg->entries.front().setStalledForEvict(set);
 }
 
 bool MSHR::getStalledForEvict(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr || reg->entries.empty()) {
         return false;
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
-        return false;
-    }
-    return mshr_.find(addr)->second.entries.front().getStalledForEvict();
+    return reg->entries.front().getStalledForEvict();
 }
 
 void MSHR::setProfiled(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.entries.front().setProfiled();
+    reg->entries.front().setProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getProfiled(0x%" PRIx64 "\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 "). Entry list is empty.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.entries.front().getProfiled();
+    return reg->entries.front().getProfiled();
 }
 
 bool MSHR::getProfiled(Addr addr, SST::Event::id_type id) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr)
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
-    if (mshr_.find(addr)->second.entries.empty())
+    if (reg->entries.empty())
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
+    for (list<MSHREntry>::iterator jt = reg->entries.begin(); jt != reg->entries.end(); jt++) {
         if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
             return jt->getProfiled();
         }
@@ -524,13 +645,14 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
     if (is_debug_addr(addr))
         printDebug(20, "Profile", addr, "");
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Address does not exist in MSHR.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    if (mshr_.find(addr)->second.entries.empty()) {
+    if (reg->entries.empty()) {
         d_->fatal(CALL_INFO, -1, "%s Error: MSHR::setProfiled(0x%" PRIx64 ", (%" PRIu64 ", %" PRId32 ")). Entry list is empty.\n", ownerName_.c_str(), addr, id.first, id.second);
     }
-    for (list<MSHREntry>::iterator jt = mshr_.find(addr)->second.entries.begin(); jt != mshr_.find(addr)->second.entries.end(); jt++) {
+    for (list<MSHREntry>::iterator jt = reg->entries.begin(); jt != reg->entries.end(); jt++) {
         if (jt->getType() == MSHREntryType::Event && jt->getEvent()->getID() == id) {
             jt->setProfiled();
             return;
@@ -539,19 +661,20 @@ void MSHR::setProfiled(Addr addr, SST::Event::id_type id) {
 }
 
 MSHREntry* MSHR::getOldestEntry() {
-    bool first = false;
+    if (flat_)
+        return oldest_;
+
+    bool first = true;
     MSHREntry* entry = nullptr;
     uint64_t time;
 
     for (MSHRBlock::iterator it = mshr_.begin(); it != mshr_.end(); it++) {
         for (list<MSHREntry>::iterator jt = it->second.entries.begin(); jt != it->second.entries.end(); jt++) {
             if (jt->getType() == MSHREntryType::Event) {
-                if (!first) {
-                    entry = &(*jt);
-                    time = jt->getStartTime();
-                } else if (jt->getStartTime() < time) {
+                if (first || jt->getStartTime() < time) {
                     entry = &(*jt);
                     time = jt->getStartTime();
+                    first = false;
                 }
             }
         }
@@ -562,15 +685,12 @@ MSHREntry* MSHR::getOldestEntry() {
 void MSHR::incrementAcksNeeded(Addr addr) {
    // if (is_debug_addr(addr))
    //     d_->debug(_L10_, "    MSHR::incrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
-        MSHRRegister reg;
-        mshr_.insert(std::make_pair(addr, reg));
-    }
-    mshr_.find(addr)->second.acksNeeded++;
+    MSHRRegister* reg = getRegister(addr);
+    reg->acksNeeded++;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "IncAck", addr, reason.str());
     }
 }
@@ -579,44 +699,47 @@ void MSHR::incrementAcksNeeded(Addr addr) {
 bool MSHR::decrementAcksNeeded(Addr addr) {
    // if (is_debug_addr(addr))
    //     d_->debug(_L10_, "    MSHR::decrementAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    if (mshr_.find(addr)->second.acksNeeded == 0) {
+    if (reg->acksNeeded == 0) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::decrementAcksNeeded(0x%" PRIx64 "). AcksNeeded is already 0.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.acksNeeded--;
+    reg->acksNeeded--;
 
     if (is_debug_addr(addr)) {
         std::stringstream reason;
-        reason << mshr_.find(addr)->second.acksNeeded << " acks";
+        reason << reg->acksNeeded << " acks";
         printDebug(10, "DecAck", addr, reason.str());
     }
 
-    return (mshr_.find(addr)->second.acksNeeded == 0);
+    return (reg->acksNeeded == 0);
 }
 
 uint32_t MSHR::getAcksNeeded(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getAcksNeeded(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         return 0;
     }
-    return (mshr_.find(addr)->second.acksNeeded);
+    return reg->acksNeeded;
 }
 
 void MSHR::setData(Addr addr, vector<uint8_t>& data, bool dirty) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L10_, "    MSHR::setData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
 
     if (is_debug_addr(addr))
         printDebug(10, "SetData", addr, (dirty ? "Dirty" : "Clean"));
 
-    mshr_.find(addr)->second.dataBuffer = data;
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataBuffer = data;
+    reg->dataDirty = dirty;
 }
 
 void MSHR::clearData(Addr addr) {
@@ -625,45 +748,49 @@ void MSHR::clearData(Addr addr) {
     if (is_debug_addr(addr))
         printDebug(10, "ClrData", addr, "");
 
-    mshr_.find(addr)->second.dataBuffer.clear();
-    mshr_.find(addr)->second.dataDirty = false;
+    MSHRRegister* reg = findRegister(addr);
+    reg->dataBuffer.clear();
+    reg->dataDirty = false;
 }
 
 vector<uint8_t>& MSHR::getData(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getData(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getData(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataBuffer;
+    return reg->dataBuffer;
 }
 
 bool MSHR::hasData(Addr addr) {
-    if (mshr_.find(addr) == mshr_.end())
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr)
         return false;
-    return !(mshr_.find(addr)->second.dataBuffer.empty());
+    return !(reg->dataBuffer.empty());
 }
 
 bool MSHR::getDataDirty(Addr addr) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L20_, "    MSHR::getDataDirty(0x%" PRIx64 ")\n", addr);
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::getDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    return mshr_.find(addr)->second.dataDirty;
+    return reg->dataDirty;
 }
 
 void MSHR::setDataDirty(Addr addr, bool dirty) {
 //    if (is_debug_addr(addr))
 //        d_->debug(_L10_, "    MSHR::setDataDirty(0x%" PRIx64 ")\n", addr);
-
     if (is_debug_addr(addr))
         printDebug(20, "SetDirt", addr, (dirty ? "Dirty" : "Clean"));
 
-    if (mshr_.find(addr) == mshr_.end()) {
+    MSHRRegister* reg = findRegister(addr);
+    if (reg == nullptr) {
         d_->fatal(CALL_INFO, -1, "%s, Error: MSHR::setDataDirty(0x%" PRIx64 "). Address does not exist in MSHR.\n", ownerName_.c_str(), addr);
     }
-    mshr_.find(addr)->second.dataDirty = dirty;
+    reg->dataDirty = dirty;
 
 }
 
@@ -689,6 +816,17 @@ void MSHR::printDebug(uint32_t lev, std::string action, Addr addr, std::string r
 // Print status. Called by cache controller on EmergencyShutdown and printStatus()
 void MSHR::printStatus(Output &out) {
     out.output("    MSHR Status for %s. Size: %u. Prefetches: %u\b", ownerName_.c_str(), size_, prefetchCount_);
+    if (flat_) {
+        // Sort so the dump matches the map layout
+        std::map<Addr, MSHRRegister*> sorted;
+        table_->forEach([&sorted](Addr addr, MSHRRegister& reg) { sorted[addr] = &reg; });
+        for (std::map<Addr,MSHRRegister*>::iterator it = sorted.begin(); it != sorted.end(); it++) {
+            out.output("      Entry: Addr = 0x%" PRIx64 "\n", (it->first));
+            for (std::list<MSHREntry>::iterator it2 = it->second->entries.begin(); it2 != it->second->entries.end(); it2++) {
+                out.output("        %s\n", it2->getString().c_str());
+            }
+        }
+    }
     for (std::map<Addr,MSHRRegister>::iterator it = mshr_.begin(); it != mshr_.end(); it++) {   // Iterate over addresses
         out.output("      Entry: Addr = 0x%" PRIx64 "\n", (it->first));
         for (std::list<MSHREntry>::iterator it2 = it->second.entries.begin(); it2 != it->second.entries.end(); it2++) { // Iterate over entries for each address
@@ -17,6 +17,8 @@
 #define _MSHR_H_
 
 #include <map>
+#include <deque>
+#include <vector>
 #include <string>
 #include <sstream>
 
@@ -44,6 +46,7 @@ using namespace std;
 enum class MSHREntryType { Event, Evict, Writeback };
 
 class MSHREntry {
+    friend class MSHR;
     public:
         // Event entry
     MSHREntry(MemEventBase* ev, bool stallEvict, SimTime_t curr_time) {
@@ -84,6 +87,18 @@ class MSHREntry {
             downgrade = false;
         }
 
+        // Evict entry using a recycled pointer list
+    MSHREntry(std::list<Addr>* ptrs, SimTime_t curr_time) {
+            type = MSHREntryType::Evict;
+            event = nullptr;
+            evictPtrs = ptrs;
+            time = curr_time;
+            inProgress = false;
+            needEvict = false;
+            profiled = false;
+            downgrade = false;
+        }
+
         MSHREntry(const MSHREntry& entry) {
             type = entry.type;
             evictPtrs = entry.evictPtrs;
@@ -95,6 +110,21 @@ class MSHREntry {
             downgrade = entry.downgrade;
         }
 
+        // Age links are owned by the MSHR and are never copied
+        MSHREntry& operator=(const MSHREntry& entry) {
+            type = entry.type;
+            evictPtrs = entry.evictPtrs;
+            event = entry.event;
+            time = entry.time;
+            inProgress = entry.inProgress;
+            needEvict = entry.needEvict;
+            profiled = entry.profiled;
+            downgrade = entry.downgrade;
+            older = nullptr;
+            newer = nullptr;
+            return *this;
+        }
+
         MSHREntryType getType() { return type; }
 
         bool getInProgress() { return inProgress; }
@@ -161,6 +191,8 @@ class MSHREntry {
         bool inProgress;            // Whether event is currently being handled; prevents early retries
         bool profiled;
         bool downgrade;             // Specific to Writeback type
+        MSHREntry* older = nullptr; // Age list (flat MSHR only), Event entries only
+        MSHREntry* newer = nullptr;
 };
 
 struct MSHRRegister {
@@ -174,10 +206,145 @@ struct MSHRRegister {
     uint32_t getPendingRetries() { return pendingRetries; }
     void addPendingRetry() { pendingRetries++; }
     void removePendingRetry() { pendingRetries--; }
+
+    void reset() {
+        entries.clear();
+        acksNeeded = 0;
+        dataBuffer.clear(); // Keeps capacity for the next user of this register
+        dataDirty = false;
+        pendingRetries = 0;
+    }
 };
 
 typedef map<Addr, MSHRRegister> MSHRBlock;
 
+/*
+ *  Open-addressed (linear probing) table of MSHR registers indexed by address.
+ *  Registers come from a pool and are recycled when an address leaves the MSHR
+ *  so steady-state operation does not touch the allocator.
+ *  Deletion uses backward shifting so no tombstones accumulate.
+ */
+class MSHRTable {
+public:
+    MSHRTable(int maxSize) : count_(0) {
+        // Registers are also created for writebacks/evictions, which do not count against maxSize
+        size_t capacity = 64;
+        size_t target = (maxSize > 0) ? 2 * (size_t)maxSize : 1024;
+        while (capacity < target) capacity <<= 1;
+        slots_.resize(capacity);
+        mask_ = capacity - 1;
+    }
+
+    MSHRRegister* find(Addr addr) {
+        for (size_t i = hash(addr); slots_[i].reg != nullptr; i = (i + 1) & mask_) {
+            if (slots_[i].addr == addr)
+                return slots_[i].reg;
+        }
+        return nullptr;
+    }
+
+    /* Return the register for addr, creating it if needed */
+    MSHRRegister* insert(Addr addr) {
+        size_t i = hash(addr);
+        for (; slots_[i].reg != nullptr; i = (i + 1) & mask_) {
+            if (slots_[i].addr == addr)
+                return slots_[i].reg;
+        }
+        if (2 * (count_ + 1) > slots_.size()) {
+            grow();
+            return insert(addr);
+        }
+        MSHRRegister* reg;
+        if (free_.empty()) {
+            pool_.emplace_back();
+            reg = &(pool_.back());
+        } else {
+            reg = free_.back();
+            free_.pop_back();
+        }
+        slots_[i].addr = addr;
+        slots_[i].reg = reg;
+        count_++;
+        return reg;
+    }
+
+    void erase(Addr addr) {
+        size_t i = hash(addr);
+        for (; slots_[i].reg != nullptr; i = (i + 1) & mask_) {
+            if (slots_[i].addr == addr)
+                break;
+        }
+        if (slots_[i].reg == nullptr)
+            return;
+
+        slots_[i].reg->reset();
+        free_.push_back(slots_[i].reg);
+        count_--;
+
+        // Shift back any entry whose probe sequence passes through the hole
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask_;
+            if (slots_[j].reg == nullptr)
+                break;
+            size_t k = hash(slots_[j].addr);
+            bool inRange = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+            if (inRange)
+                continue;
+            slots_[i] = slots_[j];
+            i = j;
+        }
+        slots_[i].reg = nullptr;
+    }
+
+    size_t size() { return count_; }
+
+    /* Visit every register, in no particular order */
+    template <typename F>
+    void forEach(F func) {
+        for (size_t i = 0; i < slots_.size(); i++) {
+            if (slots_[i].reg != nullptr)
+                func(slots_[i].addr, *(slots_[i].reg));
+        }
+    }
+
+private:
+    struct Slot {
+        Slot() : addr(0), reg(nullptr) { }
+        Addr addr;
+        MSHRRegister* reg;
+    };
+
+    // Addresses are line-aligned so mix the upper bits down before masking
+    size_t hash(Addr addr) {
+        addr ^= addr >> 33;
+        addr *= 0xff51afd7ed558ccdULL;
+        addr ^= addr >> 33;
+        return addr & mask_;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.resize(old.size() * 2);
+        mask_ = slots_.size() - 1;
+        for (size_t i = 0; i < old.size(); i++) {
+            if (old[i].reg == nullptr)
+                continue;
+            size_t j = hash(old[i].addr);
+            while (slots_[j].reg != nullptr)
+                j = (j + 1) & mask_;
+            slots_[j] = old[i];
+        }
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+    size_t count_;
+    std::deque<MSHRRegister> pool_;     // deque so register addresses stay stable as the pool grows
+    std::vector<MSHRRegister*> free_;
+};
+
 /**
  *  Implements an MSHR with entries of type mshrEntry
  */
@@ -185,7 +352,9 @@ class MSHR : public ComponentExtension {
 public:
 
     // used externally
-    MSHR(ComponentId_t cid, Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr);
+    // flat: use the open-addressed MSHRTable with pooled entries instead of the ordered map
+    MSHR(ComponentId_t cid, Output* dbg, int maxSize, string cacheName, std::set<Addr> debugAddr, bool flat = false);
+    ~MSHR();
 
     int getMaxSize();
     int getSize();
@@ -258,7 +427,25 @@ private:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
+    // Storage helpers - all lookups go through these so the storage layout is selectable
+    MSHRRegister* findRegister(Addr addr);
+    MSHRRegister* getRegister(Addr addr);   // Find or create
+    void eraseRegister(Addr addr);
+    std::list<MSHREntry>::iterator insertEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator pos, const MSHREntry& entry);
+    void eraseEntry(MSHRRegister* reg, std::list<MSHREntry>::iterator entry);
+    MSHREntry makeEvictEntry(Addr newAddr);
+
+    // Age list of Event entries (flat only), oldest at head
+    void ageLink(MSHREntry* entry);
+    void ageUnlink(MSHREntry* entry);
+
     MSHRBlock mshr_;
+    bool flat_;
+    MSHRTable* table_;
+    std::list<MSHREntry> entryPool_;            // Recycled list nodes for MSHRRegister::entries
+    std::vector<std::list<Addr>*> evictPool_;   // Recycled evict pointer lists
+    MSHREntry* oldest_;
+    MSHREntry* newest_;
     Output* d_;
     Output* d2_;
     int size_;
@@ -66,66 +66,208 @@ MultiThreadL1::MultiThreadL1(ComponentId_t id, Params &params) : Component(id) {
 
 
     /* Setup throughput limiting */
-    requestsPerCycle = params.find<uint64_t>("requests_per_cycle", 0);
-    responsesPerCycle = params.find<uint64_t>("responses_per_cycle", 0);
+    requests.perCycle = params.find<uint64_t>("requests_per_cycle", 0);
+    responses.perCycle = params.find<uint64_t>("responses_per_cycle", 0);
+    requests.threadPerCycle = params.find<uint64_t>("thread_requests_per_cycle", 0);
+    responses.threadPerCycle = params.find<uint64_t>("thread_responses_per_cycle", 0);
+
+    std::string arbitration = params.find<std::string>("arbitration", "fifo");
+    if (arbitration == "fifo") {
+        roundRobin = false;
+    } else if (arbitration == "round_robin") {
+        roundRobin = true;
+    } else {
+        output.fatal(CALL_INFO, -1, "%s, Invalid param: arbitration - must be 'fifo' or 'round_robin'. You specified '%s'.\n", getName().c_str(), arbitration.c_str());
+    }
+
+    Direction* dirs[2] = { &requests, &responses };
+    for (int i = 0; i < 2; i++) {
+        dirs[i]->queues.resize(threadLinks.size());
+        dirs[i]->nextThread = 0;
+        dirs[i]->queued = 0;
+    }
+    sentThisCycle.resize(threadLinks.size(), 0);
+
+    /* Statistics */
+    for (unsigned int i = 0; i < threadLinks.size(); i++) {
+        std::string thread = "thread" + std::to_string(i);
+        stat_requests.push_back(registerStatistic<uint64_t>("requests_forwarded", thread));
+        stat_responses.push_back(registerStatistic<uint64_t>("responses_forwarded", thread));
+        stat_requestWait.push_back(registerStatistic<uint64_t>("request_queue_cycles", thread));
+        stat_responseWait.push_back(registerStatistic<uint64_t>("response_queue_cycles", thread));
+        stat_latency.push_back(registerStatistic<uint64_t>("request_latency", thread));
+    }
 }
 
 MultiThreadL1::~MultiThreadL1() {
-    while (requestQueue.size()) {
-        delete requestQueue.front();
-        requestQueue.pop();
-    }
-    while (responseQueue.size()) {
-        delete responseQueue.front();
-        responseQueue.pop();
+    Direction* dirs[2] = { &requests, &responses };
+    for (int i = 0; i < 2; i++) {
+        for (auto it = dirs[i]->queues.begin(); it != dirs[i]->queues.end(); it++) {
+            while (!it->empty()) {
+                delete it->front().event;
+                it->pop();
+            }
+        }
     }
 }
 
 void MultiThreadL1::handleRequest(SST::Event * ev, unsigned int threadid) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
     if (!clockOn) enableClock();
-    threadRequestMap.insert(std::make_pair(event->getID(), threadid));
-    requestQueue.push(event);
+    threadRequestMap.insert(event->getID(), threadid, timestamp);
+    enqueue(requests, threadid, event, timestamp);
 }
 
 void MultiThreadL1::handleResponse(SST::Event * ev) {
     MemEventBase *event = static_cast<MemEventBase*>(ev);
     if (!clockOn) enableClock();
-    responseQueue.push(event);
+    unsigned int threadid;
+    uint64_t start;
+    if (!threadRequestMap.take(event->getResponseToID(), threadid, start)) {
+        output.fatal(CALL_INFO, -1, "%s, Error: received a response that does not match an outstanding request. Event: %s\n",
+                getName().c_str(), event->getVerboseString().c_str());
+    }
+    enqueue(responses, threadid, event, start);
+}
+
+void MultiThreadL1::enqueue(Direction& dir, unsigned int thread, MemEventBase* event, uint64_t start) {
+    QueuedEvent qev;
+    qev.event = event;
+    qev.arrival = timestamp;
+    qev.start = start;
+    dir.queues[thread].push(qev);
+    if (!roundRobin)
+        dir.order.push(thread);
+    dir.queued++;
 }
 
 bool MultiThreadL1::tick(SST::Cycle_t cycle) {
     timestamp++;
 
-    uint64_t sendcount = (requestsPerCycle == 0) ? requestQueue.size() : requestsPerCycle;
+    drain(requests, true);
+    drain(responses, false);
+
+    /* Turn off clock if queues are empty */
+    if (requests.queued == 0 && responses.queued == 0) {
+        clockOn = false;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Forward up to dir.perCycle queued events, no more than dir.threadPerCycle from/to any one thread
+ *  FIFO: in arrival order, stopping at the first event whose thread has reached its limit
+ *  Round robin: one event per thread per pass, starting after the thread that went first last cycle
+ */
+void MultiThreadL1::drain(Direction& dir, bool isRequest) {
+    if (dir.queued == 0)
+        return;
+
+    uint64_t sendcount = (dir.perCycle == 0) ? dir.queued : dir.perCycle;
+    if (dir.threadPerCycle != 0)
+        std::fill(sentThisCycle.begin(), sentThisCycle.end(), 0);
+
+    if (!roundRobin) {
+        while (!dir.order.empty() && sendcount > 0) {
+            unsigned int thread = dir.order.front();
+            if (dir.threadPerCycle != 0 && sentThisCycle[thread]++ == dir.threadPerCycle)
+                break;
+            dir.order.pop();
+            forward(thread, dir.queues[thread].front(), isRequest);
+            dir.queues[thread].pop();
+            sendcount--;
+        }
+        return;
+    }
+
+    unsigned int numThreads = dir.queues.size();
+    unsigned int first = dir.nextThread;
+    bool sent = true;
+    for (unsigned int pass = 0; sent && sendcount > 0 && (dir.threadPerCycle == 0 || pass < dir.threadPerCycle); pass++) {
+        sent = false;
+        for (unsigned int i = 0; i < numThreads && sendcount > 0; i++) {
+            unsigned int thread = (first + i) % numThreads;
+            if (dir.queues[thread].empty())
+                continue;
+            forward(thread, dir.queues[thread].front(), isRequest);
+            dir.queues[thread].pop();
+            sendcount--;
+            sent = true;
+        }
+    }
+    dir.nextThread = (first + 1) % numThreads;
+}
 
-    /* Drain request queue */
-    while (!requestQueue.empty() && sendcount > 0) {
-        cacheLink->send(requestQueue.front());
-        requestQueue.pop();
-        sendcount--;
+void MultiThreadL1::forward(unsigned int thread, QueuedEvent& qev, bool isRequest) {
+    if (isRequest) {
+        stat_requests[thread]->addData(1);
+        stat_requestWait[thread]->addData(timestamp - qev.arrival);
+        cacheLink->send(qev.event);
+        requests.queued--;
+    } else {
+        stat_responses[thread]->addData(1);
+        stat_responseWait[thread]->addData(timestamp - qev.arrival);
+        stat_latency[thread]->addData(timestamp - qev.start);
+        threadLinks[thread]->send(qev.event);
+        responses.queued--;
     }
+}
 
-    sendcount = (responsesPerCycle == 0) ? responseQueue.size() : responsesPerCycle;
+void MultiThreadL1::ThreadTable::insert(const Event::id_type& id, unsigned int thread, uint64_t arrival) {
+    if ((count_ + 1) * 2 > slots_.size())
+        grow();
+    size_t mask = slots_.size() - 1;
+    size_t i = home(id);
+    while (slots_[i].used)
+        i = (i + 1) & mask;
+    slots_[i].id = id;
+    slots_[i].thread = thread;
+    slots_[i].arrival = arrival;
+    slots_[i].used = true;
+    count_++;
+}
 
-    /* Drain response queue */
-    while (!responseQueue.empty() && sendcount > 0) {
-        MemEventBase * event = responseQueue.front();
-        responseQueue.pop();
+bool MultiThreadL1::ThreadTable::take(const Event::id_type& id, unsigned int& thread, uint64_t& arrival) {
+    size_t mask = slots_.size() - 1;
+    size_t i = home(id);
+    while (slots_[i].used && slots_[i].id != id)
+        i = (i + 1) & mask;
+    if (!slots_[i].used)
+        return false;
 
-        unsigned int linkid = threadRequestMap.find(event->getResponseToID())->second;
-        threadRequestMap.erase(event->getResponseToID());
-        threadLinks[linkid]->send(event);
+    thread = slots_[i].thread;
+    arrival = slots_[i].arrival;
+    count_--;
 
-        sendcount--;
+    /* Backward-shift deletion: move later entries of the probe run into the hole
+     * so lookups never need tombstones */
+    size_t hole = i;
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (!slots_[j].used)
+            break;
+        size_t h = home(slots_[j].id);
+        /* Entry j can fill the hole if its home is not cyclically within (hole, j] */
+        if (((j - h) & mask) >= ((j - hole) & mask)) {
+            slots_[hole] = slots_[j];
+            hole = j;
+        }
     }
+    slots_[hole].used = false;
+    return true;
+}
 
-    /* Turn off clock if queues are empty */
-    if (requestQueue.empty() && responseQueue.empty()) {
-        clockOn = false;
-        return true;
+void MultiThreadL1::ThreadTable::grow() {
+    std::vector<Slot> old;
+    old.swap(slots_);
+    slots_.resize(old.size() * 2);
+    count_ = 0;
+    for (auto it = old.begin(); it != old.end(); it++) {
+        if (it->used)
+            insert(it->id, it->thread, it->arrival);
     }
-    return false;
 }
 
 inline void MultiThreadL1::enableClock() {
@@ -16,8 +16,7 @@
 #ifndef _MEMHIERARCHY_MULTITHREADL1_H_
 #define _MEMHIERARCHY_MULTITHREADL1_H_
 
-#include <map>
-#include <queue>
+#include <vector>
 
 #include <sst/core/event.h>
 #include <sst/core/sst_types.h>
@@ -43,6 +42,9 @@ public:
             {"clock",               "(string) Clock frequency or period with units (Hz or s; SI units OK).", NULL},
             {"requests_per_cycle",  "(uint) Number of requests to forward to L1 each cycle (for all threads combined). 0 indicates unlimited", "0"},
             {"responses_per_cycle", "(uint) Number of responses to forward to threads each cycle (for all threads combined). 0 indicates unlimited", "0"},
+            {"thread_requests_per_cycle",  "(uint) Number of requests to forward to L1 each cycle from any one thread. 0 indicates unlimited", "0"},
+            {"thread_responses_per_cycle", "(uint) Number of responses to forward to any one thread each cycle. 0 indicates unlimited", "0"},
+            {"arbitration",         "(string) Order in which queued requests are forwarded when throughput is limited. Options: 'fifo' (arrival order across all threads) or 'round_robin' (one request per thread in turn)", "fifo"},
             {"debug",               "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",         "(uint) Debug verbosity level. Between 0 and 10", "0"},
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""} )
@@ -51,6 +53,14 @@ public:
           {"cache", "Link to L1 cache", {"memHierarchy.MemEventBase"} },
           {"thread%(port)d", "Links to threads/cores", {"memHierarchy.MemEventBase"} } )
 
+    /* Statistics are per thread, with subIDs 'thread0', 'thread1', ... */
+    SST_ELI_DOCUMENT_STATISTICS(
+            {"requests_forwarded",  "Number of requests from the thread forwarded to the L1", "count", 1},
+            {"responses_forwarded", "Number of responses forwarded to the thread", "count", 1},
+            {"request_queue_cycles",  "Cycles each request waited in the shim before being forwarded to the L1", "cycles", 2},
+            {"response_queue_cycles", "Cycles each response waited in the shim before being forwarded to the thread", "cycles", 2},
+            {"request_latency",     "Cycles from a request arriving at the shim to its response leaving the shim", "cycles", 2} )
+
 /* Begin class definition */
     /** Constructor & destructor */
     MultiThreadL1(ComponentId_t id, Params &params);
@@ -86,14 +96,91 @@ private:
     Clock::Handler<MultiThreadL1>*  clockHandler;
     TimeConverter* clock;
 
-    /** Track outstanding requests for routing responses correctly */
-    std::map<Event::id_type, unsigned int> threadRequestMap;
+    /** Events waiting in the shim */
+    struct QueuedEvent {
+        MemEventBase* event;
+        uint64_t arrival;   // Timestamp the event arrived at the shim
+        uint64_t start;     // Responses: timestamp the request arrived at the shim
+    };
+
+    /** FIFO ring that doubles when full, so steady-state pushes and pops do not allocate */
+    template <typename T>
+    class Ring {
+    public:
+        Ring() : head_(0), size_(0), ring_(8) { }
+        bool empty() const { return size_ == 0; }
+        size_t size() const { return size_; }
+        T& front() { return ring_[head_]; }
+        void pop() { head_ = (head_ + 1) & (ring_.size() - 1); size_--; }
+        void push(const T& item) {
+            if (size_ == ring_.size()) {
+                std::vector<T> grown(ring_.size() * 2);
+                for (size_t i = 0; i < size_; i++)
+                    grown[i] = ring_[(head_ + i) & (ring_.size() - 1)];
+                ring_.swap(grown);
+                head_ = 0;
+            }
+            ring_[(head_ + size_) & (ring_.size() - 1)] = item;
+            size_++;
+        }
+    private:
+        size_t head_;
+        size_t size_;
+        std::vector<T> ring_;
+    };
+
+    /** Maps an outstanding request ID to the thread that sent it and when it arrived
+     * Open addressing with linear probing in a flat, power-of-two sized array */
+    class ThreadTable {
+    public:
+        ThreadTable() : count_(0), slots_(64) { }
+        void insert(const Event::id_type& id, unsigned int thread, uint64_t arrival);
+        /* Remove 'id' and return its entry; returns false if it is not outstanding */
+        bool take(const Event::id_type& id, unsigned int& thread, uint64_t& arrival);
+        size_t size() const { return count_; }
+    private:
+        struct Slot {
+            Event::id_type id;
+            uint64_t arrival;
+            unsigned int thread;
+            bool used;
+            Slot() : arrival(0), thread(0), used(false) { }
+        };
+        size_t home(const Event::id_type& id) const { return EventIdHash()(id) & (slots_.size() - 1); }
+        void grow();
+        size_t count_;
+        std::vector<Slot> slots_;
+    };
 
-    /** Throughput control */
-    uint64_t requestsPerCycle;
-    uint64_t responsesPerCycle;
-    std::queue<MemEventBase*> requestQueue;
-    std::queue<MemEventBase*> responseQueue;
+    /** Track outstanding requests for routing responses correctly */
+    ThreadTable threadRequestMap;
+
+    /** Throughput control
+     * Requests and responses wait in per-thread rings. With 'fifo' arbitration a second ring records
+     * the thread of each queued event in arrival order; with 'round_robin' threads take turns. */
+    struct Direction {
+        std::vector<Ring<QueuedEvent> > queues;     // Per thread
+        Ring<unsigned int> order;                   // FIFO arbitration: threads in arrival order
+        uint64_t perCycle;                          // Total per cycle, 0 is unlimited
+        uint64_t threadPerCycle;                    // Per thread per cycle, 0 is unlimited
+        unsigned int nextThread;                    // Round robin: thread to consider first next cycle
+        uint64_t queued;
+    };
+    Direction requests;
+    Direction responses;
+    bool roundRobin;
+    std::vector<uint64_t> sentThisCycle;    // Per thread, scratch space for the per-thread limits
+
+    /** Statistics, per thread */
+    std::vector<Statistic<uint64_t>*> stat_requests;
+    std::vector<Statistic<uint64_t>*> stat_responses;
+    std::vector<Statistic<uint64_t>*> stat_requestWait;
+    std::vector<Statistic<uint64_t>*> stat_responseWait;
+    std::vector<Statistic<uint64_t>*> stat_latency;
+
+    void enqueue(Direction& dir, unsigned int thread, MemEventBase* event, uint64_t start);
+    void drain(Direction& dir, bool isRequest);
+    void forward(unsigned int thread, QueuedEvent& qev, bool isRequest);
 
     inline void enableClock();
 };
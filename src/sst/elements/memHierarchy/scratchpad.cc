@@ -23,6 +23,7 @@
 #include <sst/core/interfaces/stringEvent.h>
 #include "memLink.h"
 #include "memNIC.h"
+#include <cstring>
 
 using namespace std;
 using namespace SST;
@@ -185,7 +186,16 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
     directory_ = false;
 
     // Create clock
-    TimeConverter* tc = registerClock(clock_freq, new Clock::Handler<Scratchpad>(this, &Scratchpad::clock));
+    clockHandler_ = new Clock::Handler<Scratchpad>(this, &Scratchpad::clock);
+    TimeConverter* tc = registerClock(clock_freq, clockHandler_);
+    clockTC_ = tc;
+    clockOn_ = true;
+    lastActiveCycle_ = 0;
+    skipIdle_ = params.find<bool>("clock_skip_idle", false);
+    scratch_->setClockSkip(skipIdle_);
+    skipSelfLink_ = nullptr;
+    if (skipIdle_)
+        skipSelfLink_ = configureSelfLink("skipwakeup", tc, new Event::Handler<Scratchpad>(this, &Scratchpad::skipWakeup));
 
     // Register statistics
     stat_ScratchReadReceived      = registerStatistic<uint64_t>("request_received_scratch_read");
@@ -362,6 +372,7 @@ void Scratchpad::processIncomingNetworkEvent(SST::Event* event) {
  * - Acks
  */
 void Scratchpad::processIncomingCPUEvent(SST::Event* event) {
+    turnClockOn();
     MemEventBase * ev = static_cast<MemEventBase*>(event);
 
     if (is_debug_event(ev))
@@ -409,6 +420,7 @@ void Scratchpad::processIncomingCPUEvent(SST::Event* event) {
  * to a memory read or a ScratchGet
  */
 void Scratchpad::processIncomingRemoteEvent(SST::Event * event) {
+    turnClockOn();
     MemEvent * ev = static_cast<MemEvent*>(event);
 
     if (is_debug_event(ev))
@@ -416,7 +428,7 @@ void Scratchpad::processIncomingRemoteEvent(SST::Event * event) {
                 getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getVerboseString(dlevel).c_str());
 
     // Determine what kind of event spawned this and pass off to handler
-    std::map<SST::Event::id_type,SST::Event::id_type>::iterator it = responseIDMap_.find(ev->getResponseToID());
+    auto it = responseIDMap_.find(ev->getResponseToID());
 
     if (it == responseIDMap_.end()) {
         dbg.fatal(CALL_INFO, -1, "(%s) Received data response from remote but no matching request in responseIDMap_, id is (%" PRIu64 ", %" PRIu32 "), timestamp is %" PRIu64 "\n",
@@ -439,13 +451,14 @@ void Scratchpad::processIncomingRemoteEvent(SST::Event * event) {
  */
 bool Scratchpad::clock(Cycle_t cycle) {
     timestamp_++;
+    lastActiveCycle_ = cycle;
 
     bool debug = false;
 
     // issue ready events
     uint32_t responseThisCycle = (responsesPerCycle_ == 0) ? 1 : 0;
-    while (!procMsgQueue_.empty() && procMsgQueue_.begin()->first < timestamp_) {
-        MemEventBase * sendEv = procMsgQueue_.begin()->second;
+    while (procMsgQueue_.ready(timestamp_ - 1)) {
+        MemEventBase * sendEv = procMsgQueue_.front();
 
         if (is_debug_event(sendEv)) {
             debug = true;
@@ -454,13 +467,13 @@ bool Scratchpad::clock(Cycle_t cycle) {
         }
 
         linkUp_->send(sendEv);
-        procMsgQueue_.erase(procMsgQueue_.begin());
+        procMsgQueue_.pop();
         responseThisCycle++;
         if (responseThisCycle == responsesPerCycle_) break;
     }
 
-    while (!memMsgQueue_.empty() && memMsgQueue_.begin()->first < timestamp_) {
-        MemEvent * sendEv = memMsgQueue_.begin()->second;
+    while (memMsgQueue_.ready(timestamp_ - 1)) {
+        MemEvent * sendEv = memMsgQueue_.front();
         sendEv->setDst(linkDown_->getTargetDestination(sendEv->getBaseAddr()));
 
         if (is_debug_event(sendEv)) {
@@ -471,16 +484,44 @@ bool Scratchpad::clock(Cycle_t cycle) {
 
         linkDown_->send(sendEv);
 
-        memMsgQueue_.erase(memMsgQueue_.begin());
+        memMsgQueue_.pop();
     }
 
-    linkDown_->clock();
-    if (linkUp_ != linkDown_) linkUp_->clock();
-    scratch_->clock(cycle); // Clock backend
+    bool idle = linkDown_->clock();
+    if (linkUp_ != linkDown_) idle &= linkUp_->clock();
+    idle &= scratch_->clock(cycle); // Clock backend
+
+    /* If only waiting to send queued events, turn off until the cycle before the next is due.
+     * An event at time t is sent by the tick that moves timestamp_ to t+1 */
+    if (skipIdle_ && idle) {
+        uint64_t next = std::min(procMsgQueue_.nextTime(), memMsgQueue_.nextTime());
+        if (next > timestamp_ + 1) {
+            clockOn_ = false;
+            if (next != std::numeric_limits<uint64_t>::max())
+                skipSelfLink_->send(next - timestamp_, nullptr);
+            return true;
+        }
+    }
 
     return false;
 }
 
+/* Catch timestamp_ and the backend's cycle count up with the cycles skipped while the clock was off */
+void Scratchpad::turnClockOn() {
+    if (clockOn_) return;
+    Cycle_t cycle = reregisterClock(clockTC_, clockHandler_) - 1;
+    Cycle_t skipped = cycle - lastActiveCycle_;
+    timestamp_ += skipped;
+    scratch_->skipCycles(skipped);
+    lastActiveCycle_ = cycle;
+    clockOn_ = true;
+}
+
+/* Handler for skipSelfLink_. An earlier event may already have turned the clock back on */
+void Scratchpad::skipWakeup(SST::Event * ev) {
+    turnClockOn();
+}
+
 
 /***************** request and response handlers ***********************/
 /*
@@ -542,9 +583,9 @@ void Scratchpad::handleScratchRead(MemEvent * ev) {
     outstandingEventList_.insert(std::make_pair(ev->getID(),OutstandingEvent(ev,response)));
 
     if (mshr_.find(ev->getBaseAddr()) == mshr_.end()) {
-        std::vector<uint8_t> data = doScratchRead(read);
-        response->setPayload(data);
-        mshr_.insert(std::make_pair(ev->getBaseAddr(), std::list<MSHREntry>(1,MSHREntry(ev->getID(), Command::GetS, true, false))));
+        response->setZeroPayload(read->getSize());
+        doScratchRead(read, response->getPayload().data());
+        mshr_.insert(std::make_pair(ev->getBaseAddr(), std::deque<MSHREntry>(1,MSHREntry(ev->getID(), Command::GetS, true, false))));
         if (caching_ && !ev->queryFlag(MemEvent::F_NONCACHEABLE)) {
             cacheStatus_.at(ev->getBaseAddr()/scratchLineSize_) = true;
         }
@@ -636,8 +677,8 @@ void Scratchpad::handleScratchWrite(MemEvent * ev) {
         /* For directory - jump write ahead of a Put so we have correct data but otherwise
          * do not resolve race by treating writeback as ackinv since it may not actually signal that
          * the block is not present in caches */
-        std::list<MSHREntry>* entry = &(mshr_.find(ev->getBaseAddr())->second);
-        for (std::list<MSHREntry>::iterator it = entry->begin(); it != entry->end(); it++) {
+        std::deque<MSHREntry>* entry = &(mshr_.find(ev->getBaseAddr())->second);
+        for (std::deque<MSHREntry>::iterator it = entry->begin(); it != entry->end(); it++) {
             if (it->cmd == Command::Put) {
                 if (it == entry->begin()) {
                     doScratchWrite(write);
@@ -713,7 +754,7 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
                 getCurrentSimCycle(), timestamp_, getName().c_str(), saddr, daddr, remoteRead->getID().first, remoteRead->getID().second, remoteRead->getBaseAddr());
     }
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, remoteRead));
+    memMsgQueue_.insert(timestamp_, remoteRead);
 
     // Insert into mshr and send inv if needed
     // start base addr -> end base addr
@@ -723,7 +764,7 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
         Addr baseAddr = ev->getDstBaseAddr() + i*scratchLineSize_;
         if (mshr_.find(baseAddr) == mshr_.end()) {
             bool needAck = startGet(baseAddr, ev);
-            mshr_.insert(std::make_pair(baseAddr, std::list<MSHREntry>(1, MSHREntry(ev->getID(), Command::Get, true, needAck))));
+            mshr_.insert(std::make_pair(baseAddr, std::deque<MSHREntry>(1, MSHREntry(ev->getID(), Command::Get, true, needAck))));
         } else {
             mshr_.find(baseAddr)->second.push_back(MSHREntry(ev->getID(), Command::Get, true));
         }
@@ -774,7 +815,7 @@ void Scratchpad::handleScratchPut(MemEventBase * event) {
 
         if (mshr_.find(baseAddr) == mshr_.end()) {
             bool needAck = startPut(baseAddr, ev);
-            mshr_.insert(std::make_pair(baseAddr, std::list<MSHREntry>(1, MSHREntry(ev->getID(), Command::Put, !needAck, needAck))));
+            mshr_.insert(std::make_pair(baseAddr, std::deque<MSHREntry>(1, MSHREntry(ev->getID(), Command::Put, !needAck, needAck))));
         } else {
             mshr_.find(baseAddr)->second.push_back(MSHREntry(ev->getID(), Command::Put));
         }
@@ -801,6 +842,7 @@ void Scratchpad::handleScratchPut(MemEventBase * event) {
  *  All others (regular read responses): call finishRequest()
  */
 void Scratchpad::handleScratchResponse(SST::Event::id_type responseID) {
+    turnClockOn();
     SST::Event::id_type requestID = responseIDMap_.find(responseID)->second;
     responseIDMap_.erase(responseID);
 
@@ -880,13 +922,8 @@ void Scratchpad::handleAckInv(MemEventBase * event) {
         responseIDMap_.insert(std::make_pair(read->getID(),requestID));
         responseIDAddrMap_.insert(std::make_pair(read->getID(), baseAddr));
 
-        std::vector<uint8_t> data = doScratchRead(read);
-        std::vector<uint8_t> payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
         uint32_t offset = addr - request->getSrcAddr();
-        for (uint32_t i = 0; i < size; i++) {
-            payload[i+offset] = data[i];
-        }
-        outstandingEventList_.find(requestID)->second.remoteWrite->setPayload(payload);
+        doScratchRead(read, outstandingEventList_.find(requestID)->second.remoteWrite->getPayload().data() + offset);
     } else {
         dbg.fatal(CALL_INFO, -1, "%s, Error: unhandled case in handleAckInv. Time = %" PRIu64 ", Event = (%s).\n",
                 getName().c_str(), timestamp_, event->getVerboseString(dlevel).c_str());
@@ -933,12 +970,8 @@ void Scratchpad::handleFetchResp(MemEventBase * event) {
     uint32_t size = deriveSize(addr, baseAddr, put->getSrcAddr(), put->getSize());
 
     // Update write payload
-    std::vector<uint8_t> payload = outstandingEventList_.find(requestID)->second.remoteWrite->getPayload();
     uint32_t offset = addr - put->getSrcAddr();
-    for (uint32_t i = 0; i < size; i++) {
-        payload[i+offset] = response->getPayload()[i];
-    }
-    outstandingEventList_.find(requestID)->second.remoteWrite->setPayload(payload);
+    memcpy(outstandingEventList_.find(requestID)->second.remoteWrite->getPayload().data() + offset, response->getPayload().data(), size);
 
     // Clear this mshr entry
     updatePut(requestID);
@@ -978,7 +1011,7 @@ void Scratchpad::handleNack(MemEventBase * event) {
         uint64_t backoff = (0x1 << retries);
         nackedEvent->incrementRetries();
 
-        procMsgQueue_.insert(std::make_pair(timestamp_ + backoff, nackedEvent));
+        procMsgQueue_.insert(timestamp_ + backoff, nackedEvent);
 
     } else {
         delete nackedEvent;
@@ -1004,7 +1037,7 @@ void Scratchpad::handleRemoteRead(MemEvent * event) {
     outstandingEventList_.insert(std::make_pair(event->getID(), OutstandingEvent(event, response)));
     responseIDMap_.insert(std::make_pair(request->getID(), event->getID()));
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, request));
+    memMsgQueue_.insert(timestamp_, request);
 }
 
 
@@ -1023,11 +1056,11 @@ void Scratchpad::handleRemoteWrite(MemEvent * event) {
     request->setFlag(MemEvent::F_NORESPONSE);
     request->setFlag(MemEvent::F_NONCACHEABLE);
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, request));
+    memMsgQueue_.insert(timestamp_, request);
 
     MemEvent * response = event->makeResponse();
 
-    procMsgQueue_.insert(std::make_pair(timestamp_, response));
+    procMsgQueue_.insert(timestamp_, response);
 
     delete event;
 }
@@ -1075,7 +1108,7 @@ void Scratchpad::handleRemoteGetResponse(MemEvent * response, SST::Event::id_typ
             if (mshr_.find(baseAddr) == mshr_.end()) {
                 dbg.fatal(CALL_INFO, -1, "ERROR: remoteGetResponse but no matching entry in mshr for address 0x%" PRIx64 "\n", baseAddr);
             }
-            for (std::list<MSHREntry>::iterator it = mshr_.find(baseAddr)->second.begin(); it != mshr_.find(baseAddr)->second.end(); it++) {
+            for (std::deque<MSHREntry>::iterator it = mshr_.find(baseAddr)->second.begin(); it != mshr_.find(baseAddr)->second.end(); it++) {
                 if (it->id == requestID) {
                     it->scratch = write;
                     it->needData = false;
@@ -1106,16 +1139,19 @@ void Scratchpad::handleRemoteReadResponse(MemEvent * response, SST::Event::id_ty
 
 // Update MSHR
 void Scratchpad::updateMSHR(Addr baseAddr) {
+    std::deque<MSHREntry>& queue = mshr_.find(baseAddr)->second;
+
     // Remove top event
-    mshr_.find(baseAddr)->second.pop_front();
+    queue.pop_front();
 
     // Start next event
-    while (!mshr_.find(baseAddr)->second.empty()) {
-        MSHREntry * entry = &(mshr_.find(baseAddr)->second.front());
+    while (!queue.empty()) {
+        MSHREntry * entry = &(queue.front());
 
         if (entry->cmd == Command::GetS) {
-            std::vector<uint8_t> readData = doScratchRead(entry->scratch);
-            static_cast<MemEvent*>(outstandingEventList_.find(entry->id)->second.response)->setPayload(readData);
+            MemEvent * readResponse = static_cast<MemEvent*>(outstandingEventList_.find(entry->id)->second.response);
+            readResponse->setZeroPayload(entry->scratch->getSize());
+            doScratchRead(entry->scratch, readResponse->getPayload().data());
 
             if (is_debug_addr(baseAddr))
                 dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Update   0x%-16" PRIx64 " %s\n",
@@ -1128,7 +1164,7 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
         } else if (entry->cmd == Command::GetX || entry->cmd == Command::Write) {
             doScratchWrite(entry->scratch);
             finishRequest(entry->id);
-            mshr_.find(baseAddr)->second.pop_front();
+            queue.pop_front();
 
             if (is_debug_addr(baseAddr))
                 dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Remove   0x%-16" PRIx64 "\n",
@@ -1142,7 +1178,7 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
             }
             if (!entry->needAck && !entry->needData) {
                 updateGet(entry->id);
-                mshr_.find(baseAddr)->second.pop_front();
+                queue.pop_front();
 
                 if (is_debug_addr(baseAddr))
                     dbg.debug(_L10_, "M: %-20" PRIu64 " %-20" PRIu64 " %-20s MSHR:Remove   0x%-16" PRIx64 "\n",
@@ -1169,7 +1205,7 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
     }
 
     // Clear mshr entry if list is empty
-    if (mshr_.find(baseAddr)->second.empty()) {
+    if (queue.empty()) {
         mshr_.erase(baseAddr);
 
         if (is_debug_addr(baseAddr))
@@ -1178,25 +1214,25 @@ void Scratchpad::updateMSHR(Addr baseAddr) {
 }
 
 // Helper methods
-std::vector<uint8_t> Scratchpad::doScratchRead(MemEvent * event) {
+/* Read event->getSize() bytes directly into 'data', e.g., into the payload of the response being built */
+void Scratchpad::doScratchRead(MemEvent * event, uint8_t * data) {
     stat_ScratchReadIssued->addData(1);
 
-    std::vector<uint8_t> data;
-    data.resize(event->getSize(), 0);
     if (backing_) {
         backing_->get(event->getAddr(), event->getSize(), data);
+    } else {
+        memset(data, 0, event->getSize());
     }
     dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Scratch:Send  0x%-16" PRIx64 " (%s)\n",
             getCurrentSimCycle(), timestamp_, getName().c_str(), event->getAddr(), event->getBriefString().c_str());
     scratch_->handleMemEvent(event);
-    return data;
 }
 
 void Scratchpad::doScratchWrite(MemEvent * event) {
     stat_ScratchWriteIssued->addData(1);
 
     if (backing_) {
-        backing_->set(event->getAddr(), event->getSize(), event->getPayload());
+        backing_->set(event->getAddr(), event->getSize(), event->getPayload().data());
     }
 
     dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Scratch:Send  0x%-16" PRIx64 " (%s)\n",
@@ -1205,7 +1241,7 @@ void Scratchpad::doScratchWrite(MemEvent * event) {
 }
 
 void Scratchpad::sendResponse(MemEventBase * event) {
-    procMsgQueue_.insert(std::make_pair(timestamp_, event));
+    procMsgQueue_.insert(timestamp_, event);
 }
 
 
@@ -1222,7 +1258,7 @@ bool Scratchpad::startGet(Addr baseAddr, MoveEvent * get) {
         inv->setInstructionPointer(get->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
                 getCurrentSimCycle(), timestamp_, getName().c_str(), get->getSrcBaseAddr(), get->getDstBaseAddr(), inv->getID().first, inv->getID().second, inv->getBaseAddr());
-        procMsgQueue_.insert(std::make_pair(timestamp_, inv));
+        procMsgQueue_.insert(timestamp_, inv);
         return true;
     }
     return false;
@@ -1242,7 +1278,7 @@ bool Scratchpad::startPut(Addr baseAddr, MoveEvent * put) {
         inv->setInstructionPointer(put->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Put            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
                 getCurrentSimCycle(), timestamp_, getName().c_str(), put->getSrcBaseAddr(), put->getDstBaseAddr(), inv->getID().first, inv->getID().second, inv->getBaseAddr());
-        procMsgQueue_.insert(std::make_pair(timestamp_, inv));
+        procMsgQueue_.insert(timestamp_, inv);
         return true;
     } else {
         // Derive addr and size from baseAddr and the put request
@@ -1258,14 +1294,8 @@ bool Scratchpad::startPut(Addr baseAddr, MoveEvent * put) {
         responseIDMap_.insert(std::make_pair(read->getID(), put->getID()));
         responseIDAddrMap_.insert(std::make_pair(read->getID(), baseAddr));
 
-        std::vector<uint8_t> data = doScratchRead(read);
-
-        std::vector<uint8_t> payload = outstandingEventList_.find(put->getID())->second.remoteWrite->getPayload();
         uint32_t offset = addr - put->getSrcAddr();
-        for (uint32_t i = 0; i < size; i++) {
-            payload[i+offset] = data[i];
-        }
-        outstandingEventList_.find(put->getID())->second.remoteWrite->setPayload(payload);
+        doScratchRead(read, outstandingEventList_.find(put->getID())->second.remoteWrite->getPayload().data() + offset);
         return false;
     }
 }
@@ -1283,7 +1313,7 @@ void Scratchpad::updatePut(SST::Event::id_type putID) {
                 outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr());
 //        dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Finish        0x%-16" PRIx64 " <%" PRIu64 ", %" PRIu32 ">\n",
 //                getCurrentSimCycle(), timestamp_, getName().c_str(), outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr(), baseAddr, responseID.first, responseID.second);
-        memMsgQueue_.insert(std::make_pair(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite));
+        memMsgQueue_.insert(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite);
         sendResponse(outstandingEventList_.find(putID)->second.response);
         delete outstandingEventList_.find(putID)->second.request;
         outstandingEventList_.erase(putID);
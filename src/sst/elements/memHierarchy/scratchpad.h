@@ -24,11 +24,14 @@
 #include <sst/core/output.h>
 #include <map>
 #include <list>
+#include <deque>
+#include <unordered_map>
 
 #include "sst/elements/memHierarchy/membackend/backing.h"
 #include "sst/elements/memHierarchy/moveEvent.h"
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/timingWheel.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -51,6 +54,7 @@ public:
             {"memory_addr_offset",  "(uint) Amount to offset remote addresses by. Default is 'size' so that remote memory addresses start at 0", "size"},
             {"response_per_cycle",  "(uint) Maximum number of responses to return to processor each cycle. 0 is unlimited", "0"},
             {"backendConvertor",    "(string) Backend convertor to use for the scratchpad", "memHierarchy.scratchpadBackendConvertor"},
+            {"clock_skip_idle",     "(bool) When the only pending work is outgoing events waiting out their latency, turn the clock off and wake up with a self event when the next one is due instead of ticking every cycle. Timing is identical to the always-clocked mode.", "false"},
             {"debug",               "(uint) Where to print debug output. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",         "(uint) Debug verbosity level. Between 0 and 10", "0"} )
 
@@ -116,6 +120,16 @@ private:
 
     // Event handling
     bool clock(SST::Cycle_t cycle);
+    void turnClockOn();
+    void skipWakeup(SST::Event * ev);
+
+    // Clock skipping
+    Clock::Handler<Scratchpad>* clockHandler_;
+    TimeConverter* clockTC_;
+    Link* skipSelfLink_;        // Wakes the clock when the next queued event is due
+    bool skipIdle_;             // Whether to turn the clock off while only waiting on queued events
+    bool clockOn_;
+    SST::Cycle_t lastActiveCycle_;
 
     void processIncomingCPUEvent(SST::Event* event);
     void processIncomingRemoteEvent(SST::Event* event);
@@ -140,7 +154,7 @@ private:
     // Helper methods
     void updateMSHR(Addr baseAddr);
 
-    std::vector<uint8_t> doScratchRead(MemEvent * read);
+    void doScratchRead(MemEvent * read, uint8_t * data);
     void doScratchWrite(MemEvent * write);
     void sendResponse(MemEventBase * event);
 
@@ -226,15 +240,16 @@ private:
         }
     } eventDI;
 
-    std::map<SST::Event::id_type,SST::Event::id_type> responseIDMap_;   // Map a forwarded request ID to a original request ID
-    std::map<SST::Event::id_type,Addr> responseIDAddrMap_;              // Map an outstanding scratch request ID to the request's baseAddr
-    std::map<SST::Event::id_type,OutstandingEvent> outstandingEventList_; // List of all outstanding events
-    std::map<Addr,std::list<MSHREntry> > mshr_; // MSHR for scratch accesses
+    // Lookups are by exact key only, so these are hashed rather than ordered
+    std::unordered_map<SST::Event::id_type,SST::Event::id_type,EventIdHash> responseIDMap_;   // Map a forwarded request ID to a original request ID
+    std::unordered_map<SST::Event::id_type,Addr,EventIdHash> responseIDAddrMap_;              // Map an outstanding scratch request ID to the request's baseAddr
+    std::unordered_map<SST::Event::id_type,OutstandingEvent,EventIdHash> outstandingEventList_; // List of all outstanding events
+    std::unordered_map<Addr,std::deque<MSHREntry> > mshr_; // MSHR for scratch accesses
 
 
     // Outgoing message queues - map send timestamp to event
-    std::multimap<uint64_t, MemEventBase*> procMsgQueue_;
-    std::multimap<uint64_t, MemEvent*> memMsgQueue_;
+    TimingWheel<MemEventBase*> procMsgQueue_;
+    TimingWheel<MemEvent*> memMsgQueue_;
 
     // Throughput limits
     uint32_t responsesPerCycle_;
@@ -17,6 +17,7 @@
 
 #include <sst_config.h>
 #include "standardInterface.h"
+#include <algorithm>
 
 #include <sst/core/component.h>
 #include <sst/core/link.h>
@@ -83,7 +84,7 @@ StandardInterface::StandardInterface(SST::ComponentId_t id, Params &params, Time
         reg.setEmpty();
         reg.start = noncache[i];
         reg.end = noncache[i+1];
-        noncacheableRegions.insert(std::make_pair(reg.start, reg));
+        addNoncacheableRegion(reg);
     }
 }
 
@@ -137,7 +138,7 @@ void StandardInterface::init(unsigned int phase) {
                     std::vector<std::pair<MemRegion,bool>> regions = memEventE->getRegions();
                     for (auto it = regions.begin(); it != regions.end(); it++) {
                         if (!it->second) {
-                            noncacheableRegions.insert(std::make_pair(it->first.start, it->first));
+                            addNoncacheableRegion(it->first);
                         }
                     }
                 }
@@ -158,13 +159,13 @@ void StandardInterface::init(unsigned int phase) {
 /* Nothing to do, just report some debug info about our configuration */
 void StandardInterface::setup() { 
     debug.debug(_L9_, "%s, INFO: Line size: %" PRIu64 ", Mask: 0x%" PRIx64 "\n", getName().c_str(), lineSize_, baseAddrMask_);
-    if (noncacheableRegions.empty()) {
+    if (noncacheableRegions_.empty()) {
         debug.debug(_L9_, "%s, INFO: No noncacheable regions discovered\n", getName().c_str());
     } else {
         std::ostringstream regstr;
         regstr << getName() << ", INFO: Discovered noncacheable regions:";
-        for (std::multimap<Addr, MemRegion>::iterator it = noncacheableRegions.begin(); it != noncacheableRegions.end(); it++) {
-            regstr << " [" << it->second.toString() << "]";
+        for (auto it = noncacheableRegions_.begin(); it != noncacheableRegions_.end(); it++) {
+            regstr << " [" << it->toString() << "]";
         }
         debug.debug(_L9_, "%s\n", regstr.str().c_str());
     }
@@ -173,6 +174,33 @@ void StandardInterface::setup() {
 
 void StandardInterface::finish() { }
 
+/* Regions are only added during construction and init() so keep them sorted on insert */
+void StandardInterface::addNoncacheableRegion(const MemRegion& region) {
+    auto pos = std::upper_bound(noncacheableRegions_.begin(), noncacheableRegions_.end(), region,
+            [](const MemRegion& a, const MemRegion& b) { return a.start < b.start; });
+    noncacheableRegions_.insert(pos, region);
+
+    noncacheableMaxEnd_.resize(noncacheableRegions_.size());
+    Addr maxEnd = 0;
+    for (size_t i = 0; i < noncacheableRegions_.size(); i++) {
+        maxEnd = std::max(maxEnd, noncacheableRegions_[i].end);
+        noncacheableMaxEnd_[i] = maxEnd;
+    }
+}
+
+/* Search regions that start at or below addr, newest start first, until no earlier region can reach addr */
+bool StandardInterface::findNoncacheable(Addr addr) {
+    auto ep = std::upper_bound(noncacheableRegions_.begin(), noncacheableRegions_.end(), addr,
+            [](Addr a, const MemRegion& r) { return a < r.start; });
+    for (size_t i = ep - noncacheableRegions_.begin(); i > 0; i--) {
+        if (noncacheableMaxEnd_[i-1] < addr)
+            return false;
+        if (noncacheableRegions_[i-1].contains(addr))
+            return true;
+    }
+    return false;
+}
+
 /* Writes are allowed during init() but nothing else */
 void StandardInterface::sendUntimedData(StandardMem::Request *req) {
 #ifdef __SST_DEBUG_OUTPUT__
@@ -213,6 +241,44 @@ void StandardInterface::send(StandardMem::Request* req) {
     link_->send(me);
 }
 
+void StandardInterface::send(const std::vector<StandardMem::Request*>& reqs) {
+    batch_.clear();
+    batch_.reserve(reqs.size());
+    requests_.reserve(requests_.size() + reqs.size());
+
+    for (auto it = reqs.begin(); it != reqs.end(); it++) {
+        StandardMem::Request* req = *it;
+        MemEventBase *me = static_cast<MemEventBase*>(req->convert(converter_));
+#ifdef __SST_DEBUG_OUTPUT__
+        debug.debug(_L5_, "E: %-40" PRIu64 "  %-20s Req:Convert   EventID: <%" PRIu64", %" PRIu32 "> (%s)\n", getCurrentSimCycle(), getName().c_str(), me->getID().first, me->getID().second, req->getString().c_str());
+#endif
+        if (req->needsResponse())
+            requests_.emplace(me->getID(), std::make_pair(req, me->getCmd()));
+        else
+            delete req;
+        batch_.push_back(me);
+    }
+
+    for (auto it = batch_.begin(); it != batch_.end(); it++) {
+#ifdef __SST_DEBUG_OUTPUT__
+        debug.debug(_L4_, "E: %-40" PRIu64 "  %-20s Event:Send    (%s)\n",
+            getCurrentSimCycle(), getName().c_str(), (*it)->getBriefString().c_str());
+#endif
+        link_->send(*it);
+    }
+    batch_.clear();
+}
+
+void SST::MemHierarchy::sendBatch(Interfaces::StandardMem* mem, const std::vector<Interfaces::StandardMem::Request*>& reqs) {
+    StandardInterface* iface = dynamic_cast<StandardInterface*>(mem);
+    if (iface) {
+        iface->send(reqs);
+        return;
+    }
+    for (auto it = reqs.begin(); it != reqs.end(); it++)
+        mem->send(*it);
+}
+
 StandardMem::Request* StandardInterface::poll() {
     // TODO FIX THIS
     return nullptr;
@@ -229,7 +295,7 @@ void StandardInterface::receive(SST::Event* ev) {
     /* Handle responses to requests we sent */
     if (isResponse) {
         MemEventBase::id_type origID = me->getResponseToID();
-        std::map<MemEventBase::id_type,std::pair<StandardMem::Request*,Command>>::iterator reqit = requests_.find(origID);
+        auto reqit = requests_.find(origID);
         if (reqit == requests_.end()) {
             output.fatal(CALL_INFO, -1, "%s, Error: Received response but cannot locate matching request. Response: %s\n",
                 getName().c_str(), me->getVerboseString(dlevel).c_str());
@@ -330,16 +396,10 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::Read* req
 
     if (req->getNoncacheable()) {
         noncacheable = true;
-    } else if (!((iface->noncacheableRegions).empty())) {
+    } else {
         // Check if addr lies in noncacheable regions. 
         // For simplicity we are not dealing with the case where the address range splits a noncacheable + cacheable region
-        std::multimap<Addr, MemRegion>::iterator ep = (iface->noncacheableRegions).upper_bound(req->pAddr);
-        for (std::multimap<Addr, MemRegion>::iterator it = (iface->noncacheableRegions).begin(); it != ep; it++) {
-            if (it->second.contains(req->pAddr)) {
-                noncacheable = true;
-                break;
-            }
-        }
+        noncacheable = iface->isNoncacheable(req->pAddr);
     }
 
     Addr bAddr = (iface->lineSize_ == 0 || noncacheable) ? req->pAddr : req->pAddr & iface->baseAddrMask_; // Line address
@@ -364,16 +424,10 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::Write* re
     
     if (req->getNoncacheable()) {
         noncacheable = true;
-    } else if (!((iface->noncacheableRegions).empty())) {
+    } else {
         // Check if addr lies in noncacheable regions. 
         // For simplicity we are not dealing with the case where the address range splits a noncacheable + cacheable region
-        std::multimap<Addr, MemRegion>::iterator ep = (iface->noncacheableRegions).upper_bound(req->pAddr);
-        for (std::multimap<Addr, MemRegion>::iterator it = (iface->noncacheableRegions).begin(); it != ep; it++) {
-            if (it->second.contains(req->pAddr)) {
-                noncacheable = true;
-                break;
-            }
-        }
+        noncacheable = iface->isNoncacheable(req->pAddr);
     }
     
     Addr bAddr = (iface->lineSize_ == 0 || noncacheable) ? req->pAddr : req->pAddr & iface->baseAddrMask_;
@@ -533,7 +587,7 @@ Event* StandardInterface::MemEventConverter::convert(StandardMem::CustomReq* req
 }
 
 SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::ReadResp* resp) { 
-    std::map<StandardMem::Request::id_t, MemEventBase*>::iterator it = iface->responses_.find(resp->getID());
+    auto it = iface->responses_.find(resp->getID());
     if (it == iface->responses_.end())
         iface->output.fatal(CALL_INFO, -1, "%s, Error: Handling a ReadResp but no matching Read found\n", iface->getName().c_str());
     MemEvent* mereq = static_cast<MemEvent*>(it->second); // Matching memEvent req
@@ -546,7 +600,7 @@ SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::ReadResp*
     return meresp;
 }
 SST::Event* StandardInterface::MemEventConverter::convert(StandardMem::WriteResp* resp) {
-    std::map<StandardMem::Request::id_t, MemEventBase*>::iterator it = iface->responses_.find(resp->getID());
+    auto it = iface->responses_.find(resp->getID());
     if (it == iface->responses_.end())
         iface->output.fatal(CALL_INFO, -1, "%s, Error: Handling a WriteResp but no matching Write found\n", iface->getName().c_str());
     MemEvent* mereq = static_cast<MemEvent*>(it->second); // Matching memEvent req
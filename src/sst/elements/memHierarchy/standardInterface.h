@@ -21,6 +21,8 @@
 #include <string>
 #include <utility>
 #include <map>
+#include <unordered_map>
+#include <vector>
 #include <queue>
 
 #include <sst/core/sst_types.h>
@@ -103,6 +105,10 @@ public:
     virtual void send(Request* req) override;
     virtual Request* poll() override;
 
+    // Send a group of requests (e.g., all of an instruction's memory ops) in one call.
+    // The group is converted and recorded before any of it is sent; events reach the link in the order given.
+    void send(const std::vector<Request*>& reqs);
+
     // SST simulation life cycle hooks - parent must call these
     void init(unsigned int phase) override;
     void setup() override;
@@ -119,8 +125,8 @@ protected:
     Addr        baseAddrMask_;
     Addr        lineSize_;
     std::string rqstr_;
-    std::map<MemEventBase::id_type, std::pair<StandardMem::Request*,Command>> requests_;   /* Map requests sent by the endpoint */
-    std::map<StandardMem::Request::id_t, MemEventBase*> responses_;     /* Map requests received by the endpoint */
+    std::unordered_map<MemEventBase::id_type, std::pair<StandardMem::Request*,Command>, EventIdHash> requests_;   /* Map requests sent by the endpoint */
+    std::unordered_map<StandardMem::Request::id_t, MemEventBase*> responses_;     /* Map requests received by the endpoint */
     SST::MemHierarchy::MemLinkBase*  link_;
     bool cacheDst_; // Whether we've got a cache below us to handle certain conversions or we need to 
 
@@ -194,8 +200,21 @@ private:
      */
     void handleNACK(MemEventBase* meb);
 
-    /* Record noncacheable regions (e.g., MMIO device addresses) */
-    std::multimap<Addr, MemRegion> noncacheableRegions;
+    /* Record noncacheable regions (e.g., MMIO device addresses)
+     * Regions are sorted by start address and noncacheableMaxEnd_[i] is the largest end
+     * address among regions 0..i, so a lookup only visits regions that could contain the address.
+     * Most systems have no noncacheable regions, so that case returns immediately.
+     */
+    void addNoncacheableRegion(const MemRegion& region);
+    bool isNoncacheable(Addr addr) {
+        if (noncacheableRegions_.empty() || addr > noncacheableMaxEnd_.back())
+            return false;
+        return findNoncacheable(addr);
+    }
+    bool findNoncacheable(Addr addr);
+
+    std::vector<MemRegion> noncacheableRegions_;
+    std::vector<Addr> noncacheableMaxEnd_;
    
     /** Perform some sanity checks to assist with debugging
      * These are only called if SST Core is configured with --enable-debug
@@ -203,8 +222,15 @@ private:
     MemEventBase*   response;
     HandlerBase*    recvHandler_;
     MemEventConverter* converter_;
+    std::vector<MemEventBase*> batch_;  // Events converted by send(vector) but not yet sent
 };
 
+/* Send a group of requests through any StandardMem.
+ * StandardMem is defined in SST core and has no batch send, so endpoints holding a StandardMem pointer
+ * use this: it takes StandardInterface's batch path when that is the loaded interface, and otherwise
+ * calls send() on each request in order. */
+void sendBatch(Interfaces::StandardMem* mem, const std::vector<Interfaces::StandardMem::Request*>& reqs);
+
 }
 }
 
@@ -0,0 +1,133 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include "testcpu/mshrBench.h"
+
+#include <chrono>
+#include <sst/core/params.h>
+#include "memEvent.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+
+
+mshrBench::mshrBench(ComponentId_t id, Params& params) : Component(id)
+{
+    uint32_t outputLevel = params.find<uint32_t>("verbose", 1);
+    out.init("mshrBench:@p:@l: ", outputLevel, 0, Output::STDOUT);
+
+    ops = params.find<uint64_t>("ops", 1000000);
+    outstanding = params.find<uint32_t>("outstanding", 256);
+    lines = params.find<uint64_t>("lines", 65536);
+    lineSize = params.find<uint64_t>("line_size", 64);
+    seed = params.find<uint32_t>("rngseed", 7);
+    int mshrSize = params.find<int>("mshr_num_entries", -1);
+
+    if (outstanding == 0 || lines == 0)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: 'outstanding' and 'lines' must be greater than 0\n", getName().c_str());
+    if (mshrSize > 0 && (uint32_t)mshrSize <= outstanding + 1)
+        out.fatal(CALL_INFO, -1, "%s, Invalid param: 'mshr_num_entries' (%d) must be at least 'outstanding' + 2 (%" PRIu32 ")\n",
+                getName().c_str(), mshrSize, outstanding + 2);
+
+    std::set<Addr> debugAddr;
+    mapMSHR = loadComponentExtension<MSHR>(&out, mshrSize, getName(), debugAddr, false);
+    flatMSHR = loadComponentExtension<MSHR>(&out, mshrSize, getName(), debugAddr, true);
+}
+
+void mshrBench::setup() {
+    uint64_t mapSeq, flatSeq;
+    double mapTime = run(mapMSHR, mapSeq);
+    double flatTime = run(flatMSHR, flatSeq);
+
+    if (mapSeq != flatSeq)
+        out.fatal(CALL_INFO, -1, "%s, Error: map and flat MSHRs retired different event streams (0x%" PRIx64 " vs 0x%" PRIx64 ")\n",
+                getName().c_str(), mapSeq, flatSeq);
+
+    out.verbose(CALL_INFO, 1, 0, "ops=%" PRIu64 " outstanding=%" PRIu32 " lines=%" PRIu64 " retired=0x%" PRIx64 "\n", ops, outstanding, lines, mapSeq);
+    out.verbose(CALL_INFO, 1, 0, "map:  %.3f s (%.1f ns/op)\n", mapTime, 1e9 * mapTime / ops);
+    out.verbose(CALL_INFO, 1, 0, "flat: %.3f s (%.1f ns/op)\n", flatTime, 1e9 * flatTime / ops);
+}
+
+/*
+ * Each op inserts one event for a random line, as a cache does on a miss or
+ * a conflicting request, and checks the register the way processEvent does.
+ * Once 'outstanding' events are held, the oldest one is retired and removed
+ * from the front of its register.
+ *
+ * Everything runs in setup() so all entries share one timestamp and
+ * getOldestEntry() cannot order them; instead the benchmark keeps its own
+ * insertion FIFO and retires from its head. Both layouts therefore see the
+ * same stream, which is checked through 'seq', a hash of the retired
+ * addresses in order.
+ * Returns host seconds.
+ */
+double mshrBench::run(MSHR* mshr, uint64_t& seq) {
+    SST::RNG::MarsagliaRNG rng(11, seed);
+
+    // Events are recycled through a free list as they leave the MSHR
+    std::vector<MemEventBase*> freeEvents;
+    for (uint32_t i = 0; i <= outstanding; i++)
+        freeEvents.push_back(new MemEvent(getName(), 0, 0, Command::GetS));
+
+    std::deque<MemEvent*> fifo;
+    seq = 14695981039346656037ULL;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < ops; i++) {
+        Addr addr = (rng.generateNextUInt64() % lines) * lineSize;
+        MemEvent* ev = static_cast<MemEvent*>(freeEvents.back());
+        freeEvents.pop_back();
+        ev->setAddr(addr);
+        ev->setBaseAddr(addr);
+
+        if (mshr->exists(addr)) {
+            mshr->getFrontType(addr);
+            mshr->insertEvent(addr, ev, -1, false, false);
+        } else {
+            mshr->insertEvent(addr, ev, -1, false, false);
+            mshr->setInProgress(addr);
+        }
+        fifo.push_back(ev);
+
+        if (mshr->getSize() > (int)outstanding)
+            retireOldest(mshr, fifo, freeEvents, seq);
+    }
+    // Drain so the MSHR is empty for the next run
+    while (mshr->getSize() > 0)
+        retireOldest(mshr, fifo, freeEvents, seq);
+    auto end = std::chrono::steady_clock::now();
+
+    for (std::vector<MemEventBase*>::iterator it = freeEvents.begin(); it != freeEvents.end(); it++)
+        delete *it;
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+void mshrBench::retireOldest(MSHR* mshr, std::deque<MemEvent*>& fifo, std::vector<MemEventBase*>& freeEvents, uint64_t& seq) {
+    MemEvent* ev = fifo.front();
+    fifo.pop_front();
+    Addr addr = ev->getBaseAddr();
+
+    // Events for one line are appended in order, so the oldest event
+    // overall must be at the front of its register
+    MemEventBase* front = mshr->getFrontEvent(addr);
+    if (front != ev)
+        out.fatal(CALL_INFO, -1, "%s, Error: MSHR register 0x%" PRIx64 " does not have the oldest event at its front\n", getName().c_str(), addr);
+
+    freeEvents.push_back(front);
+    mshr->removeFront(addr);
+    seq = (seq ^ addr) * 1099511628211ULL;
+}
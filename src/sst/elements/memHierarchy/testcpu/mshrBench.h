@@ -0,0 +1,84 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _mshrBench_H
+#define _mshrBench_H
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+#include <inttypes.h>
+
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+#include <sst/core/rng/marsaglia.h>
+
+#include <deque>
+
+#include "mshr.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Host-time microbenchmark for the MSHR storage layouts.
+ * Drives the 'map' and 'flat' MSHRs directly with the same synthetic
+ * stream of inserts, lookups and oldest-first retirements during setup(),
+ * checks that both retired the same events, and reports the host time
+ * each layout took. No links or clocks; the
+ * simulation ends as soon as setup() returns.
+ */
+class mshrBench : public SST::Component {
+public:
+/* Element Library Info */
+    SST_ELI_REGISTER_COMPONENT(mshrBench, "memHierarchy", "mshrBench", SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Microbenchmark comparing MSHR storage layouts", COMPONENT_CATEGORY_UNCATEGORIZED)
+
+    SST_ELI_DOCUMENT_PARAMS(
+            {"ops",                 "(uint) Number of events to insert into each MSHR", "1000000"},
+            {"outstanding",         "(uint) Number of events held in the MSHR before the oldest is retired", "256"},
+            {"lines",               "(uint) Number of distinct cache lines addressed; fewer lines means more conflicting entries per register", "65536"},
+            {"line_size",           "(uint) Cache line size in bytes", "64"},
+            {"mshr_num_entries",    "(int) MSHR size passed to both layouts, -1 for unlimited", "-1"},
+            {"rngseed",             "(int) Seed for the address stream", "7"},
+            {"verbose",             "(uint) Output verbosity", "1"} )
+
+/* Begin class definiton */
+    mshrBench(SST::ComponentId_t id, SST::Params& params);
+    void setup() override;
+
+private:
+    mshrBench();  // for serialization only
+    mshrBench(const mshrBench&); // do not implement
+    void operator=(const mshrBench&); // do not implement
+
+    double run(MSHR* mshr, uint64_t& seq);
+    void retireOldest(MSHR* mshr, std::deque<MemEvent*>& fifo, std::vector<MemEventBase*>& freeEvents, uint64_t& seq);
+
+    Output out;
+    uint64_t ops;
+    uint32_t outstanding;
+    uint64_t lines;
+    uint64_t lineSize;
+    uint32_t seed;
+
+    MSHR* mapMSHR;
+    MSHR* flatMSHR;
+};
+
+}
+}
+#endif /* _mshrBench_H */
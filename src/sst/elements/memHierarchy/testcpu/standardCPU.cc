@@ -20,6 +20,7 @@
 #include <sst/core/interfaces/stringEvent.h>
 
 #include "util.h"
+#include "standardInterface.h"
 
 using namespace SST;
 using namespace SST::Interfaces;
@@ -102,6 +103,7 @@ standardCPU::standardCPU(ComponentId_t id, Params& params) :
     if (maxReqsPerIssue < 1) {
         out.fatal(CALL_INFO, -1, "%s, Error: StandardCPU cannot issue less than one request at a time...fix your input deck\n", getName().c_str());
     }
+    batchSend = params.find<bool>("batch_send", false);
 
     // Tell the simulator not to end until we OK it
     registerAsPrimaryComponent();
@@ -240,10 +242,17 @@ bool standardCPU::clockTic( Cycle_t )
 		    requests[req->getID()] =  std::make_pair(getCurrentSimTime(), cmdString);
                 }
             
-                memory->send(req);
+                if (batchSend)
+                    batch.push_back(req);
+                else
+                    memory->send(req);
 
                 ops--;
 	    }
+            if (batchSend) {
+                sendBatch(memory, batch);
+                batch.clear();
+            }
         }
     }
 
@@ -53,6 +53,7 @@ public:
         {"maxOutstanding",          "(uint) Maximum number of outstanding memory requests at a time.", "10"},
         {"opCount",                 "(uint) Number of operations to issue."},
         {"reqsPerIssue",            "(uint) Maximum number of requests to issue at a time", "1"},
+        {"batch_send",              "(bool) Send the requests issued in a cycle together using sendBatch() rather than one send() each", "false"},
         {"write_freq",              "(uint) Relative write frequency", "25"},
         {"read_freq",               "(uint) Relative read frequency", "75"},
         {"flush_freq",              "(uint) Relative flush frequency", "0"},
@@ -106,6 +107,8 @@ private:
     unsigned llsc_mark;
     unsigned mmio_mark;
     uint32_t maxReqsPerIssue;
+    bool batchSend;
+    std::vector<Interfaces::StandardMem::Request*> batch;
     uint64_t noncacheableRangeStart, noncacheableRangeEnd, noncacheableSize;
     uint64_t clock_ticks;
     Statistic<uint64_t>* requestsPendingCycle;
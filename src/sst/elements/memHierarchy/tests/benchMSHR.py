@@ -0,0 +1,24 @@
+# Microbenchmark for the MSHR storage layouts
+#
+# memHierarchy.mshrBench drives a 'map' and a 'flat' MSHR directly with the
+# same stream of inserts, lookups and oldest-entry retirements and reports the
+# host time of each. No memory system is simulated, e.g.:
+#   sst benchMSHR.py
+#   sst benchMSHR.py -- --outstanding=4096 --lines=1048576
+import sst
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ops", help="events inserted into each MSHR", type=int, default=1000000)
+parser.add_argument("--outstanding", help="events held in the MSHR before the oldest is retired", type=int, default=256)
+parser.add_argument("--lines", help="distinct cache lines addressed", type=int, default=65536)
+parser.add_argument("--mshr_size", help="mshr_num_entries for both layouts (-1 for unlimited)", type=int, default=-1)
+args = parser.parse_args()
+
+bench = sst.Component("bench", "memHierarchy.mshrBench")
+bench.addParams({
+    "ops" : args.ops,
+    "outstanding" : args.outstanding,
+    "lines" : args.lines,
+    "mshr_num_entries" : args.mshr_size,
+})
@@ -0,0 +1,85 @@
+# Microbenchmark for the built-in (specialized) replacement policies
+#
+# Cores stream over a footprint much larger than their L1s and the shared L2 so
+# that most accesses miss and select a victim. Both caches use 'lru' (lru at the
+# L1, lru-opt at the L2). Run with and without the specialized policies and
+# compare host time, e.g.:
+#   sst --print-timing-info benchReplacement.py -- --specialized=0
+#   sst --print-timing-info benchReplacement.py -- --specialized=1
+# Simulated results are identical in both runs.
+import sst
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--specialized", help="use the built-in replacement policies (0 or 1)", type=int, default=1)
+parser.add_argument("--cores", help="number of cores", type=int, default=4)
+parser.add_argument("--ops", help="memory operations per core", type=int, default=500000)
+parser.add_argument("--assoc", help="L2 associativity", type=int, default=32)
+args = parser.parse_args()
+
+cores = args.cores
+specialized = "true" if args.specialized else "false"
+
+l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+l2cache.addParams({
+    "access_latency_cycles" : "10",
+    "cache_frequency" : "2GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : args.assoc,
+    "cache_line_size" : "64",
+    "cache_size" : "1MiB",
+    "specialized_replacement" : specialized,
+})
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({ "bus_frequency" : "2GHz" })
+
+for i in range(cores):
+    cpu = sst.Component("core" + str(i), "memHierarchy.standardCPU")
+    cpu.addParams({
+        "memFreq" : 1,
+        "memSize" : "64MiB",
+        "clock" : "2GHz",
+        "rngseed" : i + 11,
+        "maxOutstanding" : 16,
+        "opCount" : args.ops,
+        "reqsPerIssue" : 2,
+        "write_freq" : 30,
+        "read_freq" : 70,
+    })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1cache = sst.Component("l1cache" + str(i), "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "8",
+        "cache_line_size" : "64",
+        "cache_size" : "32KiB",
+        "L1" : "1",
+        "specialized_replacement" : specialized,
+    })
+
+    link_cpu = sst.Link("link_cpu" + str(i))
+    link_cpu.connect( (iface, "port", "500ps"), (l1cache, "high_network_0", "500ps") )
+    link_bus = sst.Link("link_l1_bus" + str(i))
+    link_bus.connect( (l1cache, "low_network_0", "500ps"), (bus, "high_network_" + str(i), "500ps") )
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_end" : 64*1024*1024-1,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50ns",
+    "mem_size" : "64MiB",
+})
+
+link_bus_l2 = sst.Link("link_bus_l2")
+link_bus_l2.connect( (bus, "low_network_0", "500ps"), (l2cache, "high_network_0", "500ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (l2cache, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
@@ -0,0 +1,63 @@
+# Throughput microbenchmark for the Scratchpad controller
+#
+# A ScratchCPU drives a scratchpad with a fast scratch backend and many
+# outstanding requests so that host time is dominated by the scratchpad's
+# own request tracking rather than the models around it. Compare host time
+# across builds or backing stores, e.g.:
+#   sst --print-timing-info benchScratchpad.py
+#   sst --print-timing-info benchScratchpad.py -- --backing=none
+import sst
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--ops", help="requests to issue", type=int, default=1000000)
+parser.add_argument("--outstanding", help="maximum outstanding requests", type=int, default=256)
+parser.add_argument("--backing", help="scratchpad backing store (none, malloc or mmap)", default="malloc")
+args = parser.parse_args()
+
+scratchSize = 64 * 1024
+memSize = 64 * 1024 * 1024
+
+comp_scratch = sst.Component("scratch", "memHierarchy.Scratchpad")
+comp_scratch.addParams({
+    "clock" : "2GHz",
+    "size" : "64KiB",
+    "scratch_line_size" : 64,
+    "memory_line_size" : 64,
+    "backing" : args.backing,
+    "response_per_cycle" : 0,
+})
+scratch_conv = comp_scratch.setSubComponent("backendConvertor", "memHierarchy.simpleMemScratchBackendConvertor")
+scratch_back = scratch_conv.setSubComponent("backend", "memHierarchy.simpleMem")
+scratch_back.addParams({
+    "access_time" : "2ns",
+})
+
+cpu = sst.Component("core", "memHierarchy.ScratchCPU")
+cpu.addParams({
+    "scratchSize" : scratchSize,
+    "maxAddr" : scratchSize + memSize,
+    "scratchLineSize" : 64,
+    "memLineSize" : 64,
+    "clock" : "2GHz",
+    "maxOutstandingRequests" : args.outstanding,
+    "maxRequestsPerCycle" : 4,
+    "reqsToIssue" : args.ops,
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_start" : 0,
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50ns",
+    "mem_size" : "128MiB",
+})
+
+link_cpu_scratch = sst.Link("link_cpu_scratch")
+link_cpu_scratch.connect( (iface, "port", "500ps"), (comp_scratch, "cpu", "500ps") )
+link_scratch_mem = sst.Link("link_scratch_mem")
+link_scratch_mem.connect( (comp_scratch, "memory", "100ps"), (memctrl, "direct_link", "100ps") )
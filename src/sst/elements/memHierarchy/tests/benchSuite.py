@@ -0,0 +1,225 @@
+# Simulator-performance benchmark configuration for memHierarchy
+#
+# Builds a core -> L1 -> L2 -> directory -> memory hierarchy driven by miranda
+# generators. Every core has a private L1 and L2; the L2s reach the directories
+# over a single merlin router. The incoherent configuration has no directory;
+# its L2s share a bus to one memory.
+#
+# This file is meant to be run by runBenchmarks.py, which sweeps protocols and
+# generators and reports host time, events/s and memory use, but it can also
+# be run by hand:
+#   sst --print-timing-info benchSuite.py -- --protocol=mesi-inclusive --generator=random
+#
+# --statfile enables the event counters (the *_recv and requests_received_*
+# statistics) into a CSV file. --typemap writes a JSON map from component name
+# to component type so the counts can be grouped by type. --host_profile turns
+# on the caches', directories' and memories' host-time profiles.
+import sst
+import argparse
+import json
+
+protocols = {
+    # name : (L1/L2 protocol, L2 cache_type, use a directory)
+    "mesi-inclusive"    : ("MESI", "inclusive", True),
+    "mesi-noninclusive" : ("MESI", "noninclusive", True),
+    "msi-inclusive"     : ("MSI", "inclusive", True),
+    "msi-noninclusive"  : ("MSI", "noninclusive", True),
+    "none"              : ("NONE", "noninclusive", False),
+}
+generators = [ "stream", "random", "gups" ]
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--protocol", help="coherence configuration", choices=sorted(protocols.keys()), default="mesi-inclusive")
+parser.add_argument("--generator", help="miranda address generator", choices=generators, default="random")
+parser.add_argument("--cores", help="number of cores", type=int, default=4)
+parser.add_argument("--memories", help="number of directory/memory pairs", type=int, default=2)
+parser.add_argument("--ops", help="memory operations per core (STREAM: elements per array)", type=int, default=100000)
+parser.add_argument("--footprint", help="address range touched per core in bytes", type=int, default=16*1024*1024)
+parser.add_argument("--statfile", help="write event counters to this CSV file", default="")
+parser.add_argument("--typemap", help="write a component name to type map to this JSON file", default="")
+parser.add_argument("--host_profile", help="enable host-time profiling in memHierarchy components (0 or 1)", type=int, default=0)
+args = parser.parse_args()
+
+protocol, l2type, useDirectory = protocols[args.protocol]
+cores = args.cores
+memories = args.memories if useDirectory else 1
+memSize = cores * args.footprint
+memSizeStr = str(memSize) + "B"
+network_bw = "60GB/s"
+
+typemap = {}
+profiled = [ "memHierarchy.Cache", "memHierarchy.DirectoryController", "memHierarchy.MemController" ]
+def component(name, ctype):
+    typemap[name] = ctype
+    comp = sst.Component(name, ctype)
+    if args.host_profile and ctype in profiled:
+        comp.addParam("host_profile", 1)
+    return comp
+
+if useDirectory:
+    network = component("network", "merlin.hr_router")
+    network.addParams({
+        "xbar_bw" : network_bw,
+        "link_bw" : network_bw,
+        "input_buf_size" : "2KiB",
+        "output_buf_size" : "2KiB",
+        "num_ports" : cores + memories,
+        "flit_size" : "36B",
+        "id" : "0",
+    })
+    network.setSubComponent("topology", "merlin.singlerouter")
+else:
+    bus = component("bus", "memHierarchy.Bus")
+    bus.addParams({ "bus_frequency" : "2GHz" })
+
+for i in range(cores):
+    cpu = component("core" + str(i), "miranda.BaseCPU")
+    cpu.addParams({
+        "clock" : "2GHz",
+        "max_reqs_cycle" : 2,
+        "maxmemreqpending" : 16,
+        "cache_line_size" : 64,
+    })
+    base = i * args.footprint
+    if args.generator == "stream":
+        gen = cpu.setSubComponent("generator", "miranda.STREAMBenchGenerator")
+        gen.addParams({
+            "n" : args.ops,
+            "operandwidth" : 8,
+            "start_a" : base,
+            "start_b" : base + args.footprint // 3,
+            "start_c" : base + 2 * (args.footprint // 3),
+        })
+    elif args.generator == "random":
+        gen = cpu.setSubComponent("generator", "miranda.RandomGenerator")
+        gen.addParams({
+            "count" : args.ops,
+            "length" : 8,
+            "max_address" : memSize,
+            "issue_op_fences" : "no",
+        })
+    else:
+        gen = cpu.setSubComponent("generator", "miranda.GUPSGenerator")
+        gen.addParams({
+            "count" : args.ops,
+            "length" : 8,
+            "max_address" : memSize,
+            "seed_a" : 11 + i,
+            "seed_b" : 31 + i,
+            "issue_op_fences" : "no",
+        })
+    iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+    l1 = component("l1cache" + str(i), "memHierarchy.Cache")
+    l1.addParams({
+        "cache_frequency" : "2GHz",
+        "access_latency_cycles" : 2,
+        "replacement_policy" : "lru",
+        "coherence_protocol" : protocol,
+        "associativity" : 8,
+        "cache_line_size" : 64,
+        "cache_size" : "32KiB",
+        "L1" : 1,
+    })
+
+    l2 = component("l2cache" + str(i), "memHierarchy.Cache")
+    l2.addParams({
+        "cache_frequency" : "2GHz",
+        "access_latency_cycles" : 9,
+        "replacement_policy" : "lru",
+        "coherence_protocol" : protocol,
+        "associativity" : 16,
+        "cache_line_size" : 64,
+        "cache_size" : "256KiB",
+        "cache_type" : l2type,
+        "mshr_num_entries" : 32,
+    })
+    l2tol1 = l2.setSubComponent("cpulink", "memHierarchy.MemLink")
+
+    link = sst.Link("link_cpu_l1_" + str(i))
+    link.connect( (iface, "port", "500ps"), (l1, "high_network_0", "500ps") )
+    link = sst.Link("link_l1_l2_" + str(i))
+    link.connect( (l1, "low_network_0", "100ps"), (l2tol1, "port", "100ps") )
+
+    if useDirectory:
+        l2nic = l2.setSubComponent("memlink", "memHierarchy.MemNIC")
+        l2nic.addParams({
+            "group" : 1,
+            "network_bw" : network_bw,
+            "network_input_buffer_size" : "2KiB",
+            "network_output_buffer_size" : "2KiB",
+        })
+        link = sst.Link("link_l2_network_" + str(i))
+        link.connect( (l2nic, "port", "100ps"), (network, "port" + str(i), "100ps") )
+    else:
+        l2tobus = l2.setSubComponent("memlink", "memHierarchy.MemLink")
+        link = sst.Link("link_l2_bus_" + str(i))
+        link.connect( (l2tobus, "port", "100ps"), (bus, "high_network_" + str(i), "100ps") )
+
+for i in range(memories):
+    memctrl = component("memory" + str(i), "memHierarchy.MemController")
+    memctrl.addParams({
+        "clock" : "1GHz",
+        "backing" : "none",
+        "addr_range_start" : 0,
+        "addr_range_end" : memSize - 1,
+    })
+    if memories > 1:
+        memctrl.addParams({
+            "interleave_size" : "64B",
+            "interleave_step" : str(memories * 64) + "B",
+            "addr_range_start" : i * 64,
+            "addr_range_end" : memSize - ((memories - i) * 64) + 63,
+        })
+    backend = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    backend.addParams({
+        "access_time" : "50ns",
+        "mem_size" : memSizeStr,
+    })
+
+    if useDirectory:
+        directory = component("directory" + str(i), "memHierarchy.DirectoryController")
+        directory.addParams({
+            "clock" : "2GHz",
+            "coherence_protocol" : protocol,
+            "entry_cache_size" : 32768,
+            "mshr_num_entries" : 32,
+            "addr_range_start" : 0,
+            "addr_range_end" : memSize - 1,
+        })
+        if memories > 1:
+            directory.addParams({
+                "interleave_size" : "64B",
+                "interleave_step" : str(memories * 64) + "B",
+                "addr_range_start" : i * 64,
+                "addr_range_end" : memSize - ((memories - i) * 64) + 63,
+            })
+        dirnic = directory.setSubComponent("cpulink", "memHierarchy.MemNIC")
+        dirnic.addParams({
+            "group" : 2,
+            "network_bw" : network_bw,
+            "network_input_buffer_size" : "2KiB",
+            "network_output_buffer_size" : "2KiB",
+        })
+        dirtomem = directory.setSubComponent("memlink", "memHierarchy.MemLink")
+
+        link = sst.Link("link_directory_network_" + str(i))
+        link.connect( (dirnic, "port", "100ps"), (network, "port" + str(cores + i), "100ps") )
+        link = sst.Link("link_directory_memory_" + str(i))
+        link.connect( (dirtomem, "port", "100ps"), (memctrl, "direct_link", "100ps") )
+    else:
+        link = sst.Link("link_bus_memory")
+        link.connect( (bus, "low_network_0", "100ps"), (memctrl, "direct_link", "100ps") )
+
+# Load level 2 includes the event counters; leave --statfile empty when timing
+# runs must not pay for statistics at all
+if args.statfile != "":
+    sst.setStatisticLoadLevel(2)
+    sst.setStatisticOutput("sst.statOutputCSV", { "filepath" : args.statfile, "separator" : "," })
+    for ctype in set(typemap.values()):
+        if ctype.startswith("memHierarchy."):
+            sst.enableAllStatisticsForComponentType(ctype)
+
+if args.typemap != "":
+    with open(args.typemap, "w") as f:
+        json.dump(typemap, f, indent=1)
@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+# Driver for the memHierarchy simulator-performance benchmarks
+#
+# Runs benchSuite.py once per (protocol, generator) pair and writes a JSON report
+# with, for each run:
+#   - host time of the run loop and of the whole simulation (from --print-timing-info)
+#   - memory events handled, in total and per component type (from the event
+#     counter statistics), plus events/s and ns/event of run loop time
+#   - peak RSS and page faults as reported by SST (falling back to getrusage)
+#   - every other value SST prints in its timing report (mempool usage,
+#     TimeVortex depth, ...)
+#   - with --host-profile, the memHierarchy components' host-time profiles
+#     ('HostProfile:' lines) summed per component type, handler and command,
+#     and the resulting host ns per handler call for each component type
+#
+# The timed run and the counting run are separate so statistics do not add
+# to the measured host time; pass --single-run to use one run for both.
+#
+# Examples:
+#   ./runBenchmarks.py --output=baseline.json
+#   ./runBenchmarks.py --protocols=mesi-inclusive,none --generators=gups --ops=50000 --repeat=3
+#   ./runBenchmarks.py --sst-args="--enable-profiling=events:sst.profile.handler.event.time.steady(level=type)"
+#
+# Compare two reports with --compare=old.json,new.json
+import argparse
+import csv
+import json
+import os
+import re
+import resource
+import shlex
+import subprocess
+import sys
+import tempfile
+import time
+
+all_protocols = [ "mesi-inclusive", "mesi-noninclusive", "msi-inclusive", "msi-noninclusive", "none" ]
+all_generators = [ "stream", "random", "gups" ]
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+units = { "B" : 1, "KB" : 1024, "MB" : 1024**2, "GB" : 1024**3, "TB" : 1024**4,
+          "s" : 1.0, "ms" : 1e-3, "us" : 1e-6, "ns" : 1e-9 }
+
+# Lines in the timing report look like '  Run loop time:     1.234 s'
+timing_line = re.compile(r"^\s*([A-Za-z][A-Za-z .()/-]*?):\s+([-+0-9.eE]+)\s*(\S*)\s*$")
+
+def parse_timing(text):
+    """Return {key: value} for every 'Key: number [unit]' line; values are scaled
+    to seconds or bytes when the unit is known"""
+    values = {}
+    for line in text.splitlines():
+        m = timing_line.match(line)
+        if not m:
+            continue
+        key = m.group(1).strip().lower().replace(" ", "_").replace(".", "")
+        try:
+            value = float(m.group(2))
+        except ValueError:
+            continue
+        unit = m.group(3)
+        if unit in units:
+            value *= units[unit]
+        values[key] = value
+    return values
+
+def find_value(values, *names):
+    for name in names:
+        if name in values:
+            return values[name]
+    return None
+
+def is_event_counter(stat):
+    return stat.endswith("_recv") or stat.startswith("requests_received_")
+
+def count_events(statfile, typemap):
+    """Sum the event counters in a CSV statistics file, per component type"""
+    counts = {}
+    if not os.path.exists(statfile):
+        return counts
+    with open(statfile) as f:
+        reader = csv.reader(f)
+        header = [ h.strip() for h in next(reader, []) ]
+        try:
+            comp = header.index("ComponentName")
+            stat = header.index("StatisticName")
+            total = next(i for i, h in enumerate(header) if h.startswith("Sum."))
+        except (ValueError, StopIteration):
+            return counts
+        for row in reader:
+            if len(row) <= max(comp, stat, total):
+                continue
+            name = row[comp].strip()
+            if not is_event_counter(row[stat].strip()):
+                continue
+            # Statistics owned by subcomponents are reported under the parent's name
+            ctype = typemap.get(name.split(":")[0], "unknown")
+            counts[ctype] = counts.get(ctype, 0) + int(float(row[total]))
+    return counts
+
+def parse_host_profile(text, typemap):
+    """Sum 'HostProfile: <component> <handler> <command> <calls> <ns>' lines per component type"""
+    profile = {}
+    for line in text.splitlines():
+        fields = line.split()
+        if len(fields) != 6 or fields[0] != "HostProfile:":
+            continue
+        ctype = typemap.get(fields[1].split(":")[0], "unknown")
+        entry = profile.setdefault(ctype, {}).setdefault(fields[2], {}).setdefault(fields[3], { "calls" : 0, "ns" : 0 })
+        entry["calls"] += int(fields[4])
+        entry["ns"] += int(fields[5])
+    return profile
+
+def ns_per_call(profile):
+    """Host ns per call of each handler, per component type, from a parse_host_profile() result"""
+    result = {}
+    for ctype, handlers in profile.items():
+        for handler, commands in handlers.items():
+            calls = sum(c["calls"] for c in commands.values())
+            if calls:
+                result.setdefault(ctype, {})[handler] = sum(c["ns"] for c in commands.values()) / calls
+    return result
+
+def run_sst(sst, sst_args, bench_args, workdir, tag):
+    """Run one simulation, return (exit code, stdout+stderr, timing and rusage values)"""
+    cmd = [ sst, "--print-timing-info" ] + sst_args + [ os.path.join(here, "benchSuite.py"), "--" ] + bench_args
+    before = resource.getrusage(resource.RUSAGE_CHILDREN)
+    start = time.monotonic()
+    proc = subprocess.run(cmd, cwd=workdir, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    wall = time.monotonic() - start
+    after = resource.getrusage(resource.RUSAGE_CHILDREN)
+    with open(os.path.join(workdir, tag + ".log"), "w") as f:
+        f.write(" ".join(shlex.quote(c) for c in cmd) + "\n")
+        f.write(proc.stdout)
+    values = parse_timing(proc.stdout)
+    values["host_wall_time"] = wall
+    values["host_user_time"] = after.ru_utime - before.ru_utime
+    values["host_system_time"] = after.ru_stime - before.ru_stime
+    # ru_maxrss is the largest child so far (KiB on Linux) - only meaningful for the first run
+    values["rusage_max_rss"] = after.ru_maxrss * 1024
+    values["rusage_minor_faults"] = after.ru_minflt - before.ru_minflt
+    return proc.returncode, proc.stdout, values
+
+def run_one(args, protocol, generator, workdir):
+    tag = protocol + "_" + generator
+    bench_args = [ "--protocol=" + protocol, "--generator=" + generator, "--cores=" + str(args.cores),
+                   "--memories=" + str(args.memories), "--ops=" + str(args.ops) ]
+    typemap_file = os.path.join(workdir, tag + "_types.json")
+    stat_file = os.path.join(workdir, tag + "_stats.csv")
+    count_args = [ "--typemap=" + typemap_file, "--statfile=" + stat_file ]
+    sst_args = shlex.split(args.sst_args)
+    if args.host_profile:
+        bench_args.append("--host_profile=1")
+
+    result = { "protocol" : protocol, "generator" : generator, "cores" : args.cores,
+               "memories" : args.memories, "ops" : args.ops, "runs" : [] }
+
+    # Counting run
+    if not args.single_run:
+        rc, out, values = run_sst(args.sst, [], bench_args + count_args, workdir, tag + "_count")
+        if rc != 0:
+            result["error"] = "counting run failed with exit code %d, see %s" % (rc, os.path.join(workdir, tag + "_count.log"))
+            return result
+
+    # Timed runs
+    outputs = []
+    for r in range(args.repeat):
+        extra = count_args if args.single_run else [ "--typemap=" + typemap_file ]
+        rc, out, values = run_sst(args.sst, sst_args, bench_args + extra, workdir, tag + "_run" + str(r))
+        if rc != 0:
+            result["error"] = "run failed with exit code %d, see %s" % (rc, os.path.join(workdir, tag + "_run" + str(r) + ".log"))
+            return result
+        result["runs"].append(values)
+        outputs.append(out)
+
+    with open(typemap_file) as f:
+        typemap = json.load(f)
+    counts = count_events(stat_file, typemap)
+    types = {}
+    for ctype in typemap.values():
+        types[ctype] = types.get(ctype, 0) + 1
+    result["components"] = types
+    result["events"] = sum(counts.values())
+    result["events_by_type"] = counts
+
+    # Report the fastest run; host noise only ever adds time
+    best = min(result["runs"], key=lambda v: find_value(v, "run_loop_time", "run_stage_time", "host_wall_time"))
+    runtime = find_value(best, "run_loop_time", "run_stage_time", "host_wall_time")
+    if args.host_profile:
+        result["host_profile"] = parse_host_profile(outputs[result["runs"].index(best)], typemap)
+        result["ns_per_call_by_type"] = ns_per_call(result["host_profile"])
+    result["run_time"] = runtime
+    result["total_time"] = find_value(best, "total_time", "host_wall_time")
+    result["max_rss"] = find_value(best, "max_resident_set_size", "approx_global_max_rss_size", "rusage_max_rss")
+    result["page_faults"] = find_value(best, "max_local_page_faults", "rusage_minor_faults")
+    if runtime and result["events"]:
+        result["events_per_second"] = result["events"] / runtime
+        result["ns_per_event"] = runtime * 1e9 / result["events"]
+    return result
+
+def compare(old_file, new_file):
+    with open(old_file) as f:
+        old = { (r["protocol"], r["generator"]) : r for r in json.load(f)["results"] }
+    with open(new_file) as f:
+        new = { (r["protocol"], r["generator"]) : r for r in json.load(f)["results"] }
+    print("%-20s %-8s %12s %12s %8s %10s %10s" % ("protocol", "gen", "old ns/ev", "new ns/ev", "speedup", "old RSS", "new RSS"))
+    for key in sorted(set(old) & set(new)):
+        o, n = old[key], new[key]
+        if "ns_per_event" not in o or "ns_per_event" not in n:
+            continue
+        print("%-20s %-8s %12.1f %12.1f %8.2f %9.1fM %9.1fM" % (key[0], key[1], o["ns_per_event"], n["ns_per_event"],
+            o["ns_per_event"] / n["ns_per_event"], (o["max_rss"] or 0) / 1024**2, (n["max_rss"] or 0) / 1024**2))
+
+def main():
+    parser = argparse.ArgumentParser(description="Run the memHierarchy simulator-performance benchmarks")
+    parser.add_argument("--protocols", help="comma-separated list of: " + ",".join(all_protocols), default=",".join(all_protocols))
+    parser.add_argument("--generators", help="comma-separated list of: " + ",".join(all_generators), default=",".join(all_generators))
+    parser.add_argument("--cores", type=int, default=4)
+    parser.add_argument("--memories", type=int, default=2)
+    parser.add_argument("--ops", help="memory operations per core", type=int, default=100000)
+    parser.add_argument("--repeat", help="timed runs per configuration; the fastest is reported", type=int, default=1)
+    parser.add_argument("--single-run", help="count events in the timed run instead of a separate run", action="store_true")
+    parser.add_argument("--host-profile", help="enable the memHierarchy host-time profiles in the timed runs", action="store_true")
+    parser.add_argument("--sst", help="sst executable", default="sst")
+    parser.add_argument("--sst-args", help="extra arguments for the timed runs, e.g. sst-core profiling options", default="")
+    parser.add_argument("--workdir", help="directory for logs, statistics and profiles (default: a temporary directory)", default="")
+    parser.add_argument("--output", help="JSON report file (default: stdout)", default="")
+    parser.add_argument("--compare", help="print a comparison of two reports: OLD.json,NEW.json", default="")
+    args = parser.parse_args()
+
+    if args.compare:
+        files = args.compare.split(",")
+        if len(files) != 2:
+            parser.error("--compare takes two files")
+        compare(files[0], files[1])
+        return 0
+
+    protocols = [ p for p in args.protocols.split(",") if p ]
+    generators = [ g for g in args.generators.split(",") if g ]
+    for p in protocols:
+        if p not in all_protocols:
+            parser.error("unknown protocol '%s'" % p)
+    for g in generators:
+        if g not in all_generators:
+            parser.error("unknown generator '%s'" % g)
+
+    workdir = args.workdir if args.workdir else tempfile.mkdtemp(prefix="memh_bench_")
+    os.makedirs(workdir, exist_ok=True)
+
+    report = { "sst" : args.sst, "sst_args" : args.sst_args, "workdir" : workdir,
+               "date" : time.strftime("%Y-%m-%dT%H:%M:%S"), "results" : [] }
+    failed = False
+    for p in protocols:
+        for g in generators:
+            sys.stderr.write("Running %s/%s...\n" % (p, g))
+            result = run_one(args, p, g, workdir)
+            if "error" in result:
+                failed = True
+                sys.stderr.write("  " + result["error"] + "\n")
+            elif "ns_per_event" in result:
+                sys.stderr.write("  %d events, %.3f s, %.1f ns/event, %.1f MiB peak RSS\n" % (result["events"],
+                    result["run_time"], result["ns_per_event"], (result["max_rss"] or 0) / 1024**2))
+            report["results"].append(result)
+
+    text = json.dumps(report, indent=2, sort_keys=True)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    else:
+        print(text)
+    return 1 if failed else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
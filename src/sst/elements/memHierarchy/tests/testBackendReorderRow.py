@@ -1,6 +1,11 @@
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--scheduler", help="per-bank scheduler: 'rows' (built-in row reordering, default) or 'frfcfs' (frfcfsTransactionQ)", choices=["rows", "frfcfs"], default="rows")
+args = parser.parse_args()
+
 cpu_params = {
     "memFreq" : 4,
     "clock" : "2.2GHz",
@@ -180,6 +185,8 @@ memreorder.addParams({
     "max_issue_per_cycle" : 2,      # Num requests the backend can send per cycle
     "reorder_limit" : "20",
 })
+if args.scheduler == "frfcfs":
+    memreorder.addParams({ "scheduler" : "memHierarchy.frfcfsTransactionQ" })
 memory = memreorder.setSubComponent("backend", "memHierarchy.simpleDRAM")
 memory.addParams({
     "mem_size" : "512MiB",
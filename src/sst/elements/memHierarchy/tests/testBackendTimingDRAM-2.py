@@ -1,6 +1,11 @@
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--eventDriven", help="run timingDRAM in eventDriven mode (results must match the default mode)", action="store_true")
+args = parser.parse_args()
+
 # Test timingDRAM with transactionQ = reorderTransactionQ and AddrMapper=simpleAddrMapper and pagepolicy=simplePagePolicy(closed)
 
 # Define the simulation components
@@ -150,6 +155,8 @@ memory.addParams({
     "channel.rank.printconfig" : 0,
     "channel.rank.bank.printconfig" : 0,
 })
+if args.eventDriven:
+    memory.addParams({ "eventDriven" : 1 })
 
 # Do lower memory hierarchy links
 link_bus_l3 = sst.Link("link_bus_l3")
@@ -0,0 +1,69 @@
+import sst
+import argparse
+from mhlib import componentlist
+
+# Paged backing store checkpoint round trip, driven by
+# test_memHA_BackingCheckpoint in testsuite_default_memHierarchy_memHA.py.
+# Every write stores the low 32 bits of its own address (big-endian) so any
+# word in a checkpoint can be checked without a reference.
+#   save:                   sst testBackingCheckpoint.py --model-options="--checkpoint_dir=<d1>"
+#   save on top of <d1>:    sst testBackingCheckpoint.py --model-options="--checkpoint_dir=<d2> --parent=<d1>/memory --seed=11"
+#   read back the chain:    sst testBackingCheckpoint.py --model-options="--checkpoint_dir=<d2> --load"
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--checkpoint_dir", help="directory the memory checkpoint is saved to or loaded from", required=True)
+parser.add_argument("--parent", help="checkpoint to restore before running and to save relative to", default="")
+parser.add_argument("--seed", help="cpu rngseed", type=int, default=7)
+parser.add_argument("--load", help="restore the checkpoint in checkpoint_dir instead of saving one", action="store_true")
+args = parser.parse_args()
+
+# Small memory so successive runs write to many of the same pages
+mem_size = 64 * 1024
+
+cpu = sst.Component("core", "memHierarchy.standardCPU")
+cpu.addParams({
+    "memFreq" : 4,
+    "memSize" : "64KiB",
+    "clock" : "1GHz",
+    "verbose" : 0,
+    "maxOutstanding" : 16,
+    "opCount" : 5000,
+    "write_freq" : 0 if args.load else 50,
+    "read_freq" : 100 if args.load else 50,
+    "rngseed" : args.seed,
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "2",
+    "cache_frequency" : "1GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : "4",
+    "cache_line_size" : "64",
+    "L1" : "1",
+    "cache_size" : "2KiB",
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_end" : mem_size - 1,
+    "backing" : "paged",
+    "backing_page_size" : "4KiB",
+    "checkpointDir" : args.checkpoint_dir,
+    "checkpoint" : "load" if args.load else "save",
+    "checkpoint_parent" : args.parent,
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50ns",
+    "mem_size" : "64KiB",
+})
+
+link_cpu_cache_link = sst.Link("link_cpu_cache_link")
+link_cpu_cache_link.connect( (iface, "port", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
@@ -1,6 +1,11 @@
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--batch_send", help="cores send each cycle's requests with one batch send (results must match the default mode)", action="store_true")
+args = parser.parse_args()
+
 DEBUG_L1 = 0
 DEBUG_DIR = 0
 DEBUG_MEM = 0
@@ -27,6 +32,7 @@ node0_core0.addParams({
     "maxOutstanding" : 16,
     "opCount" : 5000,
     "reqsPerIssue" : 4,
+    "batch_send" : args.batch_send,
     "write_freq" : 40, # 40% writes
     "read_freq" : 60,  # 60% reads
 })
@@ -68,6 +74,7 @@ node0_core1.addParams({
     "maxOutstanding" : 16,
     "opCount" : 5000,
     "reqsPerIssue" : 4,
+    "batch_send" : args.batch_send,
     "write_freq" : 40, # 40% writes
     "read_freq" : 60,  # 60% reads
 })
@@ -109,6 +116,7 @@ node1_core0.addParams({
     "maxOutstanding" : 16,
     "opCount" : 5000,
     "reqsPerIssue" : 4,
+    "batch_send" : args.batch_send,
     "write_freq" : 40, # 40% writes
     "read_freq" : 60,  # 60% reads
 })
@@ -150,6 +158,7 @@ node1_core1.addParams({
     "maxOutstanding" : 16,
     "opCount" : 5000,
     "reqsPerIssue" : 4,
+    "batch_send" : args.batch_send,
     "write_freq" : 40, # 40% writes
     "read_freq" : 60,  # 60% reads
 })
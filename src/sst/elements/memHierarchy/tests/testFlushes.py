@@ -1,4 +1,9 @@
 import sst
+import argparse
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--clock_skip_idle", help="let the caches skip idle cycles while waiting to send (results must match the default mode)", action="store_true")
+args = parser.parse_args()
 
 # Define the simulation components
 # cores with private L1/L2
@@ -56,6 +61,7 @@ for x in range(cores):
     
     comp_l1cache = sst.Component("l1cache" + str(x), "memHierarchy.Cache")
     comp_l1cache.addParams({
+        "clock_skip_idle" : args.clock_skip_idle,
         "cache_frequency" : coreclock,
         "access_latency_cycles" : 3,
         "tag_access_latency_cycles" : 1,
@@ -72,6 +78,7 @@ for x in range(cores):
 
     l2cache = sst.Component("l2cache" + str(x), "memHierarchy.Cache")
     l2cache.addParams({
+        "clock_skip_idle" : args.clock_skip_idle,
         "cache_frequency" : coreclock,
         "access_latency_cycles" : 9,
         "tag_access_latency_cycles" : 2,
@@ -107,6 +114,7 @@ for x in range(cores):
 for x in range(caches):
     l3cache = sst.Component("l3cache" + str(x), "memHierarchy.Cache")
     l3cache.addParams({
+        "clock_skip_idle" : args.clock_skip_idle,
         "cache_frequency" : uncoreclock,
         "access_latency_cycles" : 14,
         "tag_access_latency_cycles" : 6,
@@ -1,7 +1,13 @@
 import os
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--smt_arbitration", help="multithreadL1 arbitration: fifo or round_robin", default="fifo")
+parser.add_argument("--smt_thread_per_cycle", help="multithreadL1 thread_requests_per_cycle and thread_responses_per_cycle (0 for unlimited)", type=int, default=0)
+args = parser.parse_args()
+
 quiet = True
 
 memCapacity = 4 # In GB
@@ -49,6 +55,13 @@ debugLev = 10
 # Verbose
 verbose = 2
 
+# Added to each multithreadL1 on top of its per-core throughput limits
+smt_params = {
+    "arbitration" : args.smt_arbitration,
+    "thread_requests_per_cycle" : args.smt_thread_per_cycle,
+    "thread_responses_per_cycle" : args.smt_thread_per_cycle,
+}
+
 l1_cache_params = {
     "cache_frequency"    : core_clock,
     "coherence_protocol" : coherence_protocol,
@@ -328,6 +341,7 @@ class TileBuilder:
             "requests_per_cycle" : 2,
             "responses_per_cycle" : 2,
             })
+        leftSMT.addParams(smt_params)
 
         # Left Core
         mirandaL0 = sst.Component("thread_" + str(self.next_core_id), "miranda.BaseCPU")
@@ -385,6 +399,7 @@ class TileBuilder:
             "requests_per_cycle" : 2,
             "responses_per_cycle" : 2,
             })
+        rightSMT.addParams(smt_params)
 
         # Right Core
         mirandaR0 = sst.Component("thread_" + str(self.next_core_id), "miranda.BaseCPU")
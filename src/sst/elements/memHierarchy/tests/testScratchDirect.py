@@ -1,6 +1,11 @@
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--clock_skip_idle", help="let the scratchpads turn their clocks off while idle (results must match the default mode)", action="store_true")
+args = parser.parse_args()
+
 DEBUG_SCRATCH = 0
 DEBUG_MEM = 0
 
@@ -27,6 +32,7 @@ comp_scratch.addParams({
     "scratch_line_size" : 64,
     "memory_line_size" : 64,
     "backing" : "none",
+    "clock_skip_idle" : args.clock_skip_idle,
 })
 scratch_conv = comp_scratch.setSubComponent("backendConvertor", "memHierarchy.simpleMemScratchBackendConvertor")
 scratch_back = scratch_conv.setSubComponent("backend", "memHierarchy.simpleMem")
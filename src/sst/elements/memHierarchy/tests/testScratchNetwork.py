@@ -1,6 +1,11 @@
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--clock_skip_idle", help="let the scratchpads turn their clocks off while idle (results must match the default mode)", action="store_true")
+args = parser.parse_args()
+
 DEBUG_SCRATCH = 0
 DEBUG_MEM = 0
 DEBUG_CORE0 = 0
@@ -31,6 +36,7 @@ comp_scratch0.addParams({
     "scratch_line_size" : 64,
     "memory_line_size" : 128,
     "backing" : "none",
+    "clock_skip_idle" : args.clock_skip_idle,
 })
 scratch0_conv = comp_scratch0.setSubComponent("backendConvertor", "memHierarchy.simpleMemScratchBackendConvertor")
 scratch0_back = scratch0_conv.setSubComponent("backend", "memHierarchy.simpleMem")
@@ -63,6 +69,7 @@ comp_scratch1.addParams({
     "scratch_line_size" : 64,
     "memory_line_size" : 128,
     "backing" : "none",
+    "clock_skip_idle" : args.clock_skip_idle,
 })
 scratch1_conv = comp_scratch1.setSubComponent("backendConvertor", "memHierarchy.simpleMemScratchBackendConvertor")
 scratch1_back = scratch1_conv.setSubComponent("backend", "memHierarchy.simpleMem")
@@ -1,6 +1,11 @@
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--batch_max_size", help="coalesce queued NIC sends up to this size; the NIC output buffers are shrunk to the same size so sends do queue", default="")
+args = parser.parse_args()
+
 DEBUG_L1 = 0
 DEBUG_MEM = 0
 DEBUG_CORE = 0
@@ -69,6 +74,10 @@ memory.addParams({
       "mem_size" : "512MiB"
 })
 
+if args.batch_max_size:
+    for nic in [cpu_nic, l1_nic, mem_nic]:
+        nic.addParams({"batch_max_size" : args.batch_max_size, "network_output_buffer_size" : args.batch_max_size})
+
 # Enable statistics
 sst.setStatisticLoadLevel(7)
 sst.setStatisticOutput("sst.statOutputConsole")
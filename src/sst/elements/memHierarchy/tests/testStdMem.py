@@ -1,6 +1,11 @@
 import sst
+import argparse
 from mhlib import componentlist
 
+parser = argparse.ArgumentParser()
+parser.add_argument("--clock_skip_idle", help="let the caches skip idle cycles while waiting to send (results must match the default mode)", action="store_true")
+args = parser.parse_args()
+
 # Define the simulation components
 verbose = 2
 
@@ -22,6 +27,7 @@ iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
 
 l1cache = sst.Component("l1cache", "memHierarchy.Cache")
 l1cache.addParams({
+    "clock_skip_idle" : args.clock_skip_idle,
     "access_latency_cycles" : "4",
     "cache_frequency" : "2 Ghz",
     "replacement_policy" : "lru",
@@ -4,6 +4,7 @@ from sst_unittest import *
 from sst_unittest_support import *
 import os.path
 import re
+import struct
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -60,6 +61,79 @@ class testcase_memHierarchy_memHA(SSTTestCase):
     def test_memHA_BackendReorderRow(self):
         self.memHA_Template("BackendReorderRow")
 
+    def test_memHA_BackendReorderRow_frfcfs(self):
+        # Timing differs from the built-in reordering so there is no reference; check that
+        # the scheduler actually promoted row hits past older requests
+        self.memHA_Template("BackendReorderRow", variant="frfcfs", other_args='--model-options="--scheduler=frfcfs"',
+                            compare_ref=False, nonzero_stats=["row_hits", "row_already_open"])
+
+    def test_memHA_BackingCheckpoint(self):
+        # Save a paged checkpoint, save a second one on top of it, then
+        # restore the chain. The files are checked directly: no reference.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+        sdlfile = "{0}/testBackingCheckpoint.py".format(test_path)
+
+        base_dir = "{0}/memHA_BackingCheckpoint_base".format(tmpdir)
+        child_dir = "{0}/memHA_BackingCheckpoint_child".format(tmpdir)
+        runs = [("save", base_dir, "--checkpoint_dir={0}".format(base_dir)),
+                ("child", child_dir, "--checkpoint_dir={0} --parent={1}/memory --seed=11".format(child_dir, base_dir)),
+                ("load", child_dir, "--checkpoint_dir={0} --load".format(child_dir))]
+        for name, ckpt_dir, options in runs:
+            if not os.path.isdir(ckpt_dir):
+                os.makedirs(ckpt_dir)
+            outfile = "{0}/test_memHA_BackingCheckpoint_{1}.out".format(outdir, name)
+            errfile = "{0}/test_memHA_BackingCheckpoint_{1}.err".format(outdir, name)
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path,
+                         other_args='--model-options="{0}"'.format(options))
+
+        parent, base_pages = self._read_paged_checkpoint("{0}/memory".format(base_dir))
+        self.assertEqual(parent, "", "First checkpoint should not have a parent")
+        self.assertTrue(len(base_pages) > 0, "First checkpoint has no pages")
+
+        parent, child_pages = self._read_paged_checkpoint("{0}/memory".format(child_dir))
+        self.assertEqual(parent, "{0}/memory".format(base_dir), "Second checkpoint does not point at its parent")
+
+        # Every page written again in the second run must still hold the first run's data
+        shared = 0
+        for page, data in child_pages.items():
+            if page not in base_pages:
+                continue
+            old = base_pages[page]
+            for off in range(0, len(old), 4):
+                if old[off:off+4] != b"\0\0\0\0":
+                    shared += 1
+                    self.assertEqual(data[off:off+4], old[off:off+4],
+                            "Restored data at 0x{0:x} was lost".format(page * len(old) + off))
+        self.assertTrue(shared > 0, "The two runs did not write to any common page")
+
+    # Returns (parent path, {page number: page bytes}) from a BackingPaged checkpoint
+    # and checks that every non-zero word holds its own address, as testBackingCheckpoint.py writes
+    def _read_paged_checkpoint(self, path):
+        self.assertTrue(os.path.isfile(path), "Checkpoint {0} was not written".format(path))
+        with open(path, "rb") as fp:
+            ckpt = fp.read()
+        magic, version, page_shift, num_pages, parent_len, data_offset = struct.unpack_from("<8sIIQQQ", ckpt, 0)
+        self.assertEqual(magic, b"SSTMEMPG", "{0} is not a paged checkpoint".format(path))
+        header_size = struct.calcsize("<8sIIQQQ")
+        parent = ckpt[header_size:header_size + parent_len].decode()
+        index = struct.unpack_from("<{0}Q".format(num_pages), ckpt, header_size + parent_len)
+        page_size = 1 << page_shift
+        self.assertEqual(len(ckpt), data_offset + num_pages * page_size, "{0} is truncated".format(path))
+
+        pages = {}
+        for i, page in enumerate(index):
+            data = ckpt[data_offset + i * page_size:data_offset + (i + 1) * page_size]
+            for off in range(0, page_size, 4):
+                word = data[off:off+4]
+                addr = page * page_size + off
+                if word != b"\0\0\0\0":
+                    self.assertEqual(word, struct.pack(">I", addr & 0xffffffff),
+                            "{0}: word at 0x{1:x} does not hold its address".format(path, addr))
+            pages[page] = data
+        return parent, pages
+
     def test_memHA_BackendReorderSimple(self):
         self.memHA_Template("BackendReorderSimple")
 
@@ -78,8 +152,14 @@ class testcase_memHierarchy_memHA(SSTTestCase):
     def test_memHA_Flushes_2(self):
         self.memHA_Template("Flushes_2")
 
+    # Dirty flushes reach memory behind their writeback, so they must wait in the
+    # backend convertor's flush counters and the slot table must hold issued requests
     def test_memHA_Flushes(self):
-        self.memHA_Template("Flushes")
+        self.memHA_Template("Flushes", nonzero_stats=["requests_in_backend", "flushes_waiting"])
+
+    def test_memHA_Flushes_clockSkip(self):
+        self.memHA_Template("Flushes", variant="clockSkip", other_args='--model-options="--clock_skip_idle"',
+                            nonzero_stats=["Cycles_skipped"])
 
     def test_memHA_HashXor(self):
         self.memHA_Template("HashXor")
@@ -102,6 +182,10 @@ class testcase_memHierarchy_memHA(SSTTestCase):
     def test_memHA_CoherenceDomains(self):
         self.memHA_Template("CoherenceDomains")
 
+    # Batches mix cacheable and noncacheable requests; sending them together must not change the results
+    def test_memHA_CoherenceDomains_batchSend(self):
+        self.memHA_Template("CoherenceDomains", variant="batchSend", other_args='--model-options="--batch_send"')
+
     @skip_on_sstsimulator_conf_empty_str("GOBLIN_HMCSIM", "LIBDIR", "GOBLIN_HMCSIM is not included as part of this build")
     def test_memHA_BackendGoblinHMC(self):
         self.memHA_Template("BackendGoblinHMC", testtimeout=400)
@@ -134,6 +218,19 @@ class testcase_memHierarchy_memHA(SSTTestCase):
     def test_memHA_BackendTimingDRAM_4(self):
         self.memHA_Template("BackendTimingDRAM_4")
 
+    # eventDriven must produce the same output as the always-clocked runs above
+    def test_memHA_BackendTimingDRAM_1_eventDriven(self):
+        self.memHA_Template("BackendTimingDRAM_1", variant="eventDriven", other_args='--model-options="--eventDriven"')
+
+    def test_memHA_BackendTimingDRAM_2_eventDriven(self):
+        self.memHA_Template("BackendTimingDRAM_2", variant="eventDriven", other_args='--model-options="--eventDriven"')
+
+    def test_memHA_BackendTimingDRAM_3_eventDriven(self):
+        self.memHA_Template("BackendTimingDRAM_3", variant="eventDriven", other_args='--model-options="--eventDriven"')
+
+    def test_memHA_BackendTimingDRAM_4_eventDriven(self):
+        self.memHA_Template("BackendTimingDRAM_4", variant="eventDriven", other_args='--model-options="--eventDriven"')
+
     @skip_on_sstsimulator_conf_empty_str("DRAMSIM", "LIBDIR", "DRAMSIM is not included as part of this build")
     @skip_on_sstsimulator_conf_empty_str("HBMDRAMSIM", "LIBDIR", "HBMDRAMSIM is not included as part of this build")
     def test_memHA_BackendHBMDramsim(self):
@@ -148,6 +245,16 @@ class testcase_memHierarchy_memHA(SSTTestCase):
 
     def test_memHA_Kingsley(self):
         self.memHA_Template("Kingsley")
+
+    # Per-thread multithreadL1 limits equal to the per-core limits never bind, so the output must match
+    def test_memHA_Kingsley_threadLimits(self):
+        self.memHA_Template("Kingsley", variant="threadLimits", other_args='--model-options="--smt_thread_per_cycle=2"',
+                            nonzero_stats=["requests_forwarded", "responses_forwarded"])
+
+    # Round-robin changes the order requests from the two threads reach the L1, so timing differs from the reference
+    def test_memHA_Kingsley_roundRobin(self):
+        self.memHA_Template("Kingsley", variant="roundRobin", other_args='--model-options="--smt_arbitration=round_robin --smt_thread_per_cycle=1"',
+                            nonzero_stats=["requests_forwarded", "responses_forwarded"], compare_ref=False)
     
     def test_memHA_ScratchCache_1(self):
         self.memHA_Template("ScratchCache_1")
@@ -166,15 +273,33 @@ class testcase_memHierarchy_memHA(SSTTestCase):
     
     def test_memHA_ScratchNetwork(self):
         self.memHA_Template("ScratchNetwork")
+
+    # clock_skip_idle must produce the same output as the always-clocked runs above
+    def test_memHA_ScratchDirect_clockSkip(self):
+        self.memHA_Template("ScratchDirect", variant="clockSkip", other_args='--model-options="--clock_skip_idle"')
+
+    def test_memHA_ScratchNetwork_clockSkip(self):
+        self.memHA_Template("ScratchNetwork", variant="clockSkip", other_args='--model-options="--clock_skip_idle"')
     
     def test_memHA_StdMem(self):
         self.memHA_Template("StdMem")
+
+    # clock_skip_idle must produce the same output as the always-clocked run
+    def test_memHA_StdMem_clockSkip(self):
+        self.memHA_Template("StdMem", variant="clockSkip", other_args='--model-options="--clock_skip_idle"',
+                            nonzero_stats=["Cycles_skipped"])
     
     def test_memHA_StdMem_flush(self):
         self.memHA_Template("StdMem_flush")
     
     def test_memHA_StdMem_nic(self):
         self.memHA_Template("StdMem_nic")
+
+    # Coalesced events arrive together so timing differs from the reference; check
+    # that every request completes and that events were coalesced
+    def test_memHA_StdMem_nic_batch(self):
+        self.memHA_Template("StdMem_nic", variant="batch", other_args='--model-options="--batch_max_size=256B"',
+                            nonzero_stats=["events_coalesced"], compare_ref=False)
     
     def test_memHA_StdMem_noninclusive(self):
         self.memHA_Template("StdMem_noninclusive")
@@ -189,8 +314,14 @@ class testcase_memHierarchy_memHA(SSTTestCase):
         self.memHA_Template("StdMem_mmio3")
 #####
 
+    # 'variant' runs the same config and reference file with 'other_args' passed to sst
+    # 'nonzero_stats' lists statistics that must have a non-zero sum in at least one
+    # component, to check that the mode a variant enables was actually exercised
+    # 'compare_ref=False' is for variants that legitimately change timing: the run must
+    # complete and meet 'nonzero_stats' but is not diffed against a reference
     def memHA_Template(self, testcase,
-                       ignore_err_file=False, testtimeout=240):
+                       ignore_err_file=False, testtimeout=240, variant="", other_args="",
+                       variant_ref=False, nonzero_stats=[], compare_ref=True):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -203,6 +334,13 @@ class testcase_memHierarchy_memHA(SSTTestCase):
         testDataFileName=("test_memHA_{0}".format(testcase))
         sdlfile = "{0}/test{1}.py".format(test_path, testcasename_sdl)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        if variant:
+            testDataFileName = "{0}_{1}".format(testDataFileName, variant)
+            # Variants whose output legitimately differs from the base run keep their own reference
+            if variant_ref:
+                reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+                if not os.path.isfile(reffile):
+                    self.skipTest("Reference file {0} not found; generate it with genRefs.sh".format(reffile))
         
         tmpfile = "{0}/{1}.tmp".format(outdir, testDataFileName)
 
@@ -216,7 +354,7 @@ class testcase_memHierarchy_memHA(SSTTestCase):
         log_debug("ref file = {0}".format(reffile))
 
         # Run SST in the tests directory
-        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path,
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=other_args,
                      timeout_sec=testtimeout, mpi_out_files=mpioutfiles)
         
         # Lines to ignore
@@ -238,6 +376,11 @@ class testcase_memHierarchy_memHA(SSTTestCase):
                       "total_cycles" : [20, 'X', 20, 20, 20],    # This stat is set once at the end of sim. May vary in all fields
                       "MSHR_occupancy" : [0, 0, 20, 0, 0] }      # Only diffs in number of cycles
 
+        for stat in nonzero_stats:
+            self.assertTrue(self._stat_is_nonzero(outfile, stat), "Statistic {0} is zero in {1}".format(stat, outfile))
+        if not compare_ref:
+            return
+
         filesAreTheSame, statDiffs, othDiffs = testing_stat_output_diff(outfile, reffile, ignore_lines, tol_stats, True)
 
         # Perform the tests
@@ -274,6 +417,16 @@ class testcase_memHierarchy_memHA(SSTTestCase):
                 if not skip:
                     fp.write(line)
 
+    # Return whether any component's (or subcomponent's) statistic 'stat' has a non-zero sum in out_file
+    def _stat_is_nonzero(self, out_file, stat):
+        cons_accum = re.compile(r' (\S+) : Accumulator : Sum\.\w+ = (\d+);')
+        with open(out_file, 'r') as fp:
+            for line in fp:
+                m = cons_accum.match(line)
+                if m != None and stat in re.split(r'[.:]', m.group(1)) and int(m.group(2)) != 0:
+                    return True
+        return False
+
     ####################################
     # TODO move these two functions to the Core test frameworks utilities once they have matured
     # These are used to diff statistic output files with some extra checking abilities
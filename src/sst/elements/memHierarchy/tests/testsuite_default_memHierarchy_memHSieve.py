@@ -58,8 +58,82 @@ class testcase_memHierarchy_memHSieve(SSTTestCase):
     def test_memHSieve(self):
         self.memHSieve_Template("memHSieve")
 
+    @unittest.skipIf(not pin_compiled, "memHSieve: Requires PIN, but PinTool is not compiled with Elements. In sst_element_config.h PINTOOL_EXECUTABLE={0}".format(pin_exec_path))
+    @unittest.skipIf(not pin_version_valid, "memHSieve: Requires PIN, but PinTool does not seem to be a valid version. PINTOOL_EXECUTABLE={0}".format(pin_exec_path))
+    @unittest.skipIf(not pin_loaded, "memHSieve: Requires PIN, but Env Var 'INTEL_PIN_DIR' is not found or path does not exist.")
+    def test_memHSieve_sampledBinary(self):
+        self.memHSieve_sampledBinary_Template("memHSieve_sampledBinary")
+
 #####
 
+    # Model one set in four and stream the profile in binary, then read it back with
+    # sieve-profile-reader.py. The final dump must account for every miss the statistics counted.
+    def memHSieve_sampledBinary_Template(self, testcase, testtimeout=360):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        MemHElementSieveTestsDir = "{0}/Sieve/tests".format(os.path.abspath("{0}/../".format(test_path)))
+        testMemHSieveDir = "{0}/testmemhsieve".format(tmpdir)
+        # Own directory so the statistics file does not collide with test_memHSieve's
+        runDir = "{0}/testmemhsieve_sampled".format(tmpdir)
+        if os.path.isdir(runDir):
+            shutil.rmtree(runDir, True)
+        os.makedirs(runDir)
+        os_symlink_file(testMemHSieveDir, runDir, "ompsievetest")
+
+        samplePeriod = 4
+        testDataFileName = "test_{0}".format(testcase)
+        sdlfile = "{0}/sieve-test.py".format(MemHElementSieveTestsDir)
+        readerfile = "{0}/sieve-profile-reader.py".format(MemHElementSieveTestsDir)
+        binfile = "{0}/mallocRankSampled.bin".format(runDir)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        other_args = '--model-options="--set_sample_fraction={0} --output_format=binary --output_file=mallocRankSampled --output_interval=100000"'.format(1.0 / samplePeriod)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=runDir, other_args=other_args,
+                     mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        self.assertTrue(os_test_file(binfile, expression='-s'), "Binary profile {0} was not written".format(binfile))
+
+        # Every dump, in order
+        rtn = OSCommand("python3 {0} {1}".format(readerfile, binfile), set_cwd=runDir).run()
+        self.assertTrue(rtn.result() == 0, "sieve-profile-reader.py failed on {0}:\n{1}".format(binfile, rtn.output()))
+        lines = rtn.output().splitlines()
+        self.assertTrue(len(lines) > 0 and lines[0] == "#Line size 64, one set in {0} modeled".format(samplePeriod),
+                        "Unexpected profile header: {0}".format(lines[0] if lines else ""))
+        dumps = [l for l in lines if l.startswith("#Dump ")]
+        self.assertTrue(len(dumps) > 0, "No dumps in {0}".format(binfile))
+        self.assertTrue(dumps == ["#Dump {0}, marker {1}".format(i, d.split()[-1]) for i, d in enumerate(dumps)],
+                        "Dump sequence numbers are not consecutive from 0: {0}".format(dumps))
+
+        # Totals for the run; dumps are cumulative so this is the final dump
+        rtn = OSCommand("python3 {0} --total {1}".format(readerfile, binfile), set_cwd=runDir).run()
+        self.assertTrue(rtn.result() == 0, "sieve-profile-reader.py --total failed on {0}:\n{1}".format(binfile, rtn.output()))
+        reads = 0
+        writes = 0
+        for line in rtn.output().splitlines():
+            if line.startswith("#"):
+                continue
+            mallocID, r, w = [int(x) for x in line.split()]
+            # Each modeled miss is counted samplePeriod times
+            self.assertTrue(r % samplePeriod == 0 and w % samplePeriod == 0,
+                            "malloc {0} counts ({1}, {2}) are not multiples of the sample period {3}".format(mallocID, r, w, samplePeriod))
+            reads += r
+            writes += w
+        self.assertTrue(reads + writes > 0, "Binary profile {0} has no malloc misses".format(binfile))
+
+        # Misses in the profile plus misses outside any malloc must equal the statistics
+        statfile = "{0}/StatisticOutput.csv".format(runDir)
+        stats = self._sieve_read_stat_sums(statfile, ["ReadMisses", "WriteMisses", "UnassociatedReadMisses",
+                                                       "UnassociatedWriteMisses", "SampledAccesses"])
+        self.assertTrue(stats["SampledAccesses"] > 0, "No accesses were modeled")
+        self.assertEqual(reads + stats["UnassociatedReadMisses"], stats["ReadMisses"],
+                         "Profile read misses {0} + unassociated {1} != ReadMisses {2}".format(reads, stats["UnassociatedReadMisses"], stats["ReadMisses"]))
+        self.assertEqual(writes + stats["UnassociatedWriteMisses"], stats["WriteMisses"],
+                         "Profile write misses {0} + unassociated {1} != WriteMisses {2}".format(writes, stats["UnassociatedWriteMisses"], stats["WriteMisses"]))
+
     def memHSieve_Template(self, testcase, testtimeout=360):
 
         pin2defined = testing_is_PIN2_used()
@@ -291,6 +365,20 @@ class testcase_memHierarchy_memHSieve(SSTTestCase):
 
 
 
+    def _sieve_read_stat_sums(self, statfile, statnames):
+        # Return {statname : Sum} from the last row for each statistic in a CSV statistics file
+        sums = {}
+        with open(statfile, 'rt') as csvfile:
+            statreader = csv.reader(csvfile, delimiter=',', skipinitialspace=True)
+            header = next(statreader)
+            sumcol = [i for i, name in enumerate(header) if name.startswith("Sum.")][0]
+            for row in statreader:
+                if len(row) > sumcol and row[1] in statnames:
+                    sums[row[1]] = int(row[sumcol])
+        for statname in statnames:
+            self.assertTrue(statname in sums, "Statistic '{0}' not found in {1}".format(statname, statfile))
+        return sums
+
     # NOTE: This is the bash code from the bamboo test system that possibly cleans up
     #       the old ompsievetest runs.  We are not doing this unless necessary
     #       for the new frameworks
@@ -0,0 +1,138 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_TIMINGWHEEL_H
+#define MEMHIERARCHY_TIMINGWHEEL_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Queue of items keyed by delivery cycle, replacing std::multimap<uint64_t, T> send queues
+ *
+ * Items due within 'slots' cycles of the current position are kept in a ring of buckets
+ * (constant time insert and pop, no allocation once buckets have grown); items further out
+ * wait in an ordered overflow map and move into the ring as time advances.
+ * Items are popped in (time, insertion) order, the same order as the multimap.
+ * Items inserted with a time earlier than the current position are delivered at the current position.
+ *
+ * Typical use:
+ *   queue.insert(timestamp + latency, ev);
+ *   while (queue.ready(timestamp)) { send(queue.front()); queue.pop(); }
+ *
+ * nextTime() gives the earliest pending delivery time so that a clock handler
+ * can tell how many cycles it may skip (or whether it can turn its clock off).
+ */
+template <typename T>
+class TimingWheel {
+public:
+    TimingWheel(size_t slots = 64) : cursor_(0), size_(0), ringCount_(0) {
+        size_t n = 1;
+        while (n < slots) n <<= 1;
+        ring_.resize(n);
+        mask_ = n - 1;
+    }
+
+    void insert(uint64_t time, const T& item) {
+        if (time < cursor_)
+            time = cursor_;
+        if (time - cursor_ <= mask_) {
+            ring_[time & mask_].items.push_back(item);
+            ringCount_++;
+        } else {
+            overflow_.insert(std::make_pair(time, item));
+        }
+        size_++;
+    }
+
+    /* Return whether an item is due at or before 'now'. If so, front() is the earliest such item */
+    bool ready(uint64_t now) {
+        while (size_ != 0) {
+            Bucket& bucket = ring_[cursor_ & mask_];
+            if (bucket.head != bucket.items.size())
+                return cursor_ <= now;
+            if (cursor_ >= now)
+                return false;
+            if (ringCount_ == 0)    // Nothing close by, skip ahead
+                cursor_ = std::min(now, overflow_.begin()->first);
+            else
+                cursor_++;
+            refill();
+        }
+        return false;
+    }
+
+    /* Earliest item; only valid after ready() returned true */
+    T& front() {
+        Bucket& bucket = ring_[cursor_ & mask_];
+        return bucket.items[bucket.head];
+    }
+
+    void pop() {
+        Bucket& bucket = ring_[cursor_ & mask_];
+        bucket.head++;
+        if (bucket.head == bucket.items.size()) {
+            bucket.items.clear();
+            bucket.head = 0;
+        }
+        ringCount_--;
+        size_--;
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    /* Earliest pending delivery time, or UINT64_MAX if the queue is empty */
+    uint64_t nextTime() const {
+        if (ringCount_ == 0)
+            return overflow_.empty() ? std::numeric_limits<uint64_t>::max() : overflow_.begin()->first;
+        for (uint64_t time = cursor_; ; time++) {
+            const Bucket& bucket = ring_[time & mask_];
+            if (bucket.head != bucket.items.size())
+                return time;
+        }
+    }
+
+private:
+    struct Bucket {
+        std::vector<T> items;
+        size_t head = 0;
+    };
+
+    /* Move overflow items that now fall within the ring */
+    void refill() {
+        while (!overflow_.empty() && overflow_.begin()->first - cursor_ <= mask_) {
+            ring_[overflow_.begin()->first & mask_].items.push_back(overflow_.begin()->second);
+            overflow_.erase(overflow_.begin());
+            ringCount_++;
+        }
+    }
+
+    std::vector<Bucket> ring_;
+    std::multimap<uint64_t, T> overflow_;
+    uint64_t cursor_;       // Time of the ring slot at the head
+    uint64_t mask_;
+    size_t size_;
+    size_t ringCount_;      // Items in the ring (vs. overflow)
+};
+
+}}
+
+#endif /* MEMHIERARCHY_TIMINGWHEEL_H */
@@ -124,6 +124,16 @@ inline void fixupParams( Params& params, const std::string oldKey, const std::st
         }
     }
 }
+/*
+ * Hash for SST::Event::id_type (<counter, rank>) keys in unordered containers
+ */
+struct EventIdHash {
+    template <typename A, typename B>
+    size_t operator()(const std::pair<A,B>& id) const {
+        return std::hash<uint64_t>()((uint64_t)id.first ^ ((uint64_t)id.second << 48));
+    }
+};
+
 /*
  *  IGNORE - ignore this request, drop it, do not retry any waiting requests
  *  DONE - this request finished, should retry
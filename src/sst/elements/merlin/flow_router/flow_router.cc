@@ -0,0 +1,715 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+#include "flow_router/flow_router.h"
+
+#include <sst/core/params.h>
+#include <sst/core/output.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <cmath>
+
+#include "merlin.h"
+
+using namespace SST::Merlin;
+using namespace SST::Interfaces;
+using namespace std;
+
+// Bits left below which the packet at the head of a flow is
+// considered drained.  Wakeups are rounded up to whole cycles, so
+// this only absorbs floating point error.
+static const double drain_epsilon = 1e-6;
+
+std::map<std::string, FlowSolver*> FlowSolver::solvers;
+
+FlowSolver*
+FlowSolver::attach(const std::string& name, flow_router* rtr)
+{
+    FlowSolver*& solver = solvers[name];
+    if ( solver == nullptr ) solver = new FlowSolver();
+
+    if ( solver->routers.count(rtr->id) != 0 ) {
+        merlin_abort.fatal(CALL_INFO, 1, "flow_router: two routers with id %d in network \"%s\"\n", rtr->id, name.c_str());
+    }
+    solver->routers[rtr->id] = rtr;
+    if ( solver->owner == nullptr || rtr->id < solver->owner->id ) solver->owner = rtr;
+    solver->refs++;
+    return solver;
+}
+
+void
+FlowSolver::detach(const std::string& name, flow_router* rtr)
+{
+    auto it = solvers.find(name);
+    if ( it == solvers.end() ) return;
+
+    FlowSolver* solver = it->second;
+    solver->routers.erase(rtr->id);
+    if ( --solver->refs > 0 ) return;
+
+    for ( auto& entry : solver->flows ) {
+        for ( RtrEvent* ev : entry.second->packets ) delete ev;
+        delete entry.second;
+    }
+    delete solver;
+    solvers.erase(it);
+}
+
+void
+FlowSolver::setup()
+{
+    if ( initialized ) return;
+    initialized = true;
+
+    // Give every router a block of resources, two per port
+    int num_res = 0;
+    for ( auto& entry : routers ) {
+        entry.second->res_base = num_res;
+        num_res += 2 * entry.second->num_ports;
+    }
+
+    capacity.assign(num_res, 0.0);
+    for ( auto& entry : routers ) {
+        flow_router* rtr = entry.second;
+        for ( int i = 0; i < rtr->num_ports; i++ ) {
+            if ( rtr->links[i] == nullptr ) continue;
+            capacity[rtr->res_base + 2 * i] = rtr->port_bw[i];
+            capacity[rtr->res_base + 2 * i + 1] = rtr->port_bw[i];
+        }
+    }
+
+    cap_left.assign(num_res, 0.0);
+    unfixed.assign(num_res, 0);
+    res_flows.resize(num_res);
+}
+
+flow_router*
+FlowSolver::getRouter(int id)
+{
+    auto it = routers.find(id);
+    if ( it == routers.end() ) return nullptr;
+    return it->second;
+}
+
+FlowSolver::Flow*
+FlowSolver::createFlow(flow_router* rtr, int port, RtrEvent* ev)
+{
+    Flow* flow = new Flow();
+    flow->src_rtr = rtr;
+    flow->src_port = port;
+    flow->rate = 0;
+
+    // Injection link
+    flow->resources.push_back(rtr->res_base + 2 * port + 1);
+
+    // Walk the path using the topology object of each router, the
+    // same way the packet would be routed by hr_router
+    internal_router_event* ire = rtr->topo->process_input(ev);
+    ire->setCreditReturnVC(ev->getRouteVN());
+
+    flow_router* curr = rtr;
+    int in_port = port;
+    int hops = 0;
+    int max_hops = 2 * (int)routers.size() + 2;
+    while ( true ) {
+        curr->topo->route_packet(in_port, ire->getVC(), ire);
+        int out = ire->getNextPort();
+        if ( out < 0 || out >= curr->num_ports || curr->links[out] == nullptr ) {
+            merlin_abort.fatal(CALL_INFO, 1, "flow_router %d: packet from %" PRI_NID " to %" PRI_NID " routed to unconnected port %d\n",
+                               curr->id, ev->getTrustedSrc(), ev->getDest(), out);
+        }
+        flow->resources.push_back(curr->res_base + 2 * out);
+        flow->out_ports.push_back(std::make_pair(curr, out));
+
+        if ( curr->topo->getPortState(out) == Topology::R2N ) {
+            flow->dest_rtr = curr;
+            flow->dest_port = out;
+            break;
+        }
+
+        flow_router* next = getRouter(curr->remote[out].first);
+        if ( next == nullptr ) {
+            merlin_abort.fatal(CALL_INFO, 1, "flow_router %d: port %d is not connected to a flow_router in this network.  "
+                               "All routers of a flow network must be flow_routers on the same rank.\n", curr->id, out);
+        }
+        in_port = curr->remote[out].second;
+        curr = next;
+
+        if ( ++hops > max_hops ) {
+            merlin_abort.fatal(CALL_INFO, 1, "flow_router: packet from %" PRI_NID " to %" PRI_NID " exceeded %d hops, routing loop?\n",
+                               ev->getTrustedSrc(), ev->getDest(), max_hops);
+        }
+    }
+
+    // The RtrEvent stays with the flow
+    ire->setEncapsulatedEvent(nullptr);
+    delete ire;
+
+    // hops counts router to router links; the source router is
+    // crossed too
+    flow->latency = (hops + 1) * rtr->hop_cycles;
+    for ( auto& op : flow->out_ports ) op.first->addFlowToPort(op.second, 1);
+    return flow;
+}
+
+void
+FlowSolver::inject(flow_router* rtr, int port, RtrEvent* ev)
+{
+    flow_key_t key(ev->getTrustedSrc(), ev->getDest(), ev->getRouteVN());
+    auto it = flows.find(key);
+    if ( it != flows.end() ) {
+        // Flow is already draining, rates don't change
+        it->second->packets.push_back(ev);
+        return;
+    }
+
+    SimTime_t now = owner->getCurrentSimCycle();
+    Flow* flow = createFlow(rtr, port, ev);
+    flow->key = key;
+    flow->packets.push_back(ev);
+    flow->head_left = (double)ev->getSizeInFlits() * rtr->flit_bits;
+    flow->updated = now;
+    flows[key] = flow;
+    rtr->flows_started->addData(1);
+
+    computeRates(now);
+    schedule(now);
+}
+
+void
+FlowSolver::handleTimer()
+{
+    SimTime_t now = owner->getCurrentSimCycle();
+    if ( wakeup_pending && now >= wakeup_time ) wakeup_pending = false;
+
+    bool changed = false;
+    while ( !drain_queue.empty() && drain_queue.top()->drain_time <= now ) {
+        Flow* flow = drain_queue.top();
+        drain_queue.pop();
+        advance(flow, now);
+        while ( !flow->packets.empty() && flow->head_left <= drain_epsilon ) {
+            RtrEvent* ev = flow->packets.front();
+            flow->packets.pop_front();
+            flow->src_rtr->returnCredits(flow->src_port, ev->getRouteVN(), ev->getSizeInFlits());
+            flow->dest_rtr->deliver(flow->dest_port, ev, flow->latency);
+            // Any overshoot counts against the next packet
+            if ( !flow->packets.empty() ) {
+                flow->head_left += (double)flow->packets.front()->getSizeInFlits() * flow->src_rtr->flit_bits;
+            }
+        }
+
+        if ( flow->packets.empty() ) {
+            for ( auto& op : flow->out_ports ) op.first->addFlowToPort(op.second, -1);
+            flows.erase(flow->key);
+            delete flow;
+            changed = true;
+        }
+        else {
+            queueDrain(flow, now);
+        }
+    }
+
+    if ( changed ) computeRates(now);
+    schedule(now);
+}
+
+void
+FlowSolver::advance(Flow* flow, SimTime_t now)
+{
+    if ( now <= flow->updated ) return;
+    flow->head_left -= flow->rate * (double)(now - flow->updated);
+    flow->updated = now;
+}
+
+// Queue a flow (already advanced to now) for the cycle its head
+// packet will have drained
+void
+FlowSolver::queueDrain(Flow* flow, SimTime_t now)
+{
+    if ( flow->rate <= 0 ) return;
+    double left = flow->head_left > 0 ? flow->head_left : 0;
+    SimTime_t delay = (SimTime_t)std::ceil(left / flow->rate);
+    if ( delay == 0 ) delay = 1;
+    flow->drain_time = now + delay;
+    drain_queue.push(flow);
+}
+
+// Max-min fair rates by progressive filling: repeatedly find the
+// resource with the smallest fair share among the flows not yet
+// fixed, give that share to all its unfixed flows and remove their
+// bandwidth from every resource they cross.
+void
+FlowSolver::computeRates(SimTime_t now)
+{
+    std::vector<int> used;
+    for ( auto& entry : flows ) {
+        Flow* flow = entry.second;
+        // Drain at the old rate up to now
+        advance(flow, now);
+        flow->rate = -1;
+        for ( int res : flow->resources ) {
+            if ( res_flows[res].empty() ) {
+                used.push_back(res);
+                cap_left[res] = capacity[res];
+            }
+            unfixed[res]++;
+            res_flows[res].push_back(flow);
+        }
+    }
+
+    while ( true ) {
+        int bottleneck = -1;
+        double share = 0;
+        for ( int res : used ) {
+            if ( unfixed[res] == 0 ) continue;
+            double s = cap_left[res] / unfixed[res];
+            if ( bottleneck == -1 || s < share ) {
+                bottleneck = res;
+                share = s;
+            }
+        }
+        if ( bottleneck == -1 ) break;
+        if ( share < 0 ) share = 0;
+
+        for ( Flow* flow : res_flows[bottleneck] ) {
+            if ( flow->rate >= 0 ) continue;
+            flow->rate = share;
+            for ( int res : flow->resources ) {
+                cap_left[res] -= share;
+                unfixed[res]--;
+            }
+        }
+    }
+
+    for ( int res : used ) {
+        res_flows[res].clear();
+        unfixed[res] = 0;
+    }
+
+    // Every drain time has moved
+    drain_queue = std::priority_queue<Flow*, std::vector<Flow*>, DrainLater>();
+    for ( auto& entry : flows ) queueDrain(entry.second, now);
+
+    owner->active_flows->addData(flows.size());
+}
+
+// Wake up when the first head packet will have drained
+void
+FlowSolver::schedule(SimTime_t now)
+{
+    if ( drain_queue.empty() ) return;
+    SimTime_t next = drain_queue.top()->drain_time;
+
+    // An earlier wakeup will reschedule
+    if ( wakeup_pending && wakeup_time <= next ) return;
+
+    owner->timer->send(next - now, nullptr);
+    wakeup_pending = true;
+    wakeup_time = next;
+}
+
+void
+FlowSolver::routeUntimedData(flow_router* rtr, int port, RtrEvent* ev)
+{
+    if ( ev->getDest() == UNTIMED_BROADCAST_ADDR ) {
+        for ( auto& entry : routers ) {
+            flow_router* r = entry.second;
+            for ( int i = 0; i < r->num_ports; i++ ) {
+                if ( !r->isHostPort(i) || ( r == rtr && i == port ) ) continue;
+                r->links[i]->sendUntimedData(ev->share());
+            }
+        }
+        delete ev;
+        return;
+    }
+
+    for ( auto& entry : routers ) {
+        flow_router* r = entry.second;
+        for ( int i = 0; i < r->num_ports; i++ ) {
+            if ( r->isHostPort(i) && r->topo->getEndpointID(i) == ev->getDest() ) {
+                r->links[i]->sendUntimedData(ev);
+                return;
+            }
+        }
+    }
+    delete ev;
+}
+
+
+flow_router::~flow_router()
+{
+    FlowSolver::detach(network_name, this);
+
+    delete [] output_credits;
+    delete [] output_queue_lengths;
+    delete topo;
+}
+
+flow_router::flow_router(ComponentId_t cid, Params& params) :
+    Component(cid),
+    topo(nullptr),
+    solver(nullptr),
+    timer(nullptr),
+    res_base(0),
+    output_credits(nullptr),
+    output_queue_lengths(nullptr),
+    output(getSimulationOutput())
+{
+    // The solver is shared through a static, so the whole network
+    // has to live in one thread
+    RankInfo ranks = getNumRanks();
+    if ( ranks.rank > 1 || ranks.thread > 1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router only supports serial simulations (1 rank, 1 thread)\n");
+    }
+
+    id = params.find<int>("id",-1);
+    if ( id == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires id to be specified\n");
+    }
+
+    num_ports = params.find<int>("num_ports",-1);
+    if ( num_ports == -1 ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires num_ports to be specified\n");
+    }
+
+    num_vns = params.find<int>("num_vns",2);
+    network_name = params.find<std::string>("network_name","");
+
+    // Get the topology
+    topo = loadUserSubComponent<SST::Merlin::Topology>
+        ("topology", ComponentInfo::SHARE_NONE, num_ports, id, num_vns);
+
+    if ( !topo ) {
+        merlin_abort.fatal(CALL_INFO_LONG, 1, "flow_router requires topology to be specified in input file\n");
+    }
+
+    std::vector<int> vcs_per_vn(num_vns);
+    topo->getVCsPerVN(vcs_per_vn);
+    num_vcs = 0;
+    for ( int vcs : vcs_per_vn ) num_vcs += vcs;
+
+    // Flit size
+    std::string flit_size_s = params.find<std::string>("flit_size");
+    if ( flit_size_s == "" ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires flit_size to be specified\n");
+    }
+    flit_size = UnitAlgebra(flit_size_s);
+    if ( flit_size.hasUnits("B") ) {
+        flit_size *= UnitAlgebra("8b/B");
+    }
+    flit_bits = flit_size.getRoundedValue();
+
+    // Link BW
+    std::string link_bw_s = params.find<std::string>("link_bw");
+    if ( link_bw_s == "" ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires link_bw to be specified\n");
+    }
+    link_bw = UnitAlgebra(link_bw_s);
+    if ( link_bw.hasUnits("B/s") ) {
+        link_bw *= UnitAlgebra("8b/B");
+    }
+
+    // Input buffers, used as the credits handed to the endpoints
+    std::string input_buf_size_s = params.find<std::string>("input_buf_size");
+    if ( input_buf_size_s == "" ) {
+        merlin_abort.fatal(CALL_INFO, -1, "flow_router requires input_buf_size to be specified\n");
+    }
+    UnitAlgebra input_buf_size(input_buf_size_s);
+    if ( input_buf_size.hasUnits("B") ) {
+        input_buf_size *= UnitAlgebra("8b/B");
+    }
+    input_buf_flits = (input_buf_size / flit_size).getRoundedValue();
+
+    UnitAlgebra hop_latency(params.find<std::string>("hop_latency","20ns"));
+    hop_cycles = (hop_latency / getCoreTimeBase()).getRoundedValue();
+
+    // All links use the core time base so the solver can send with
+    // delays in core cycles
+    std::string core_tb = getCoreTimeBase().toString();
+
+    links.assign(num_ports, nullptr);
+    port_bw.assign(num_ports, 0.0);
+    remote.assign(num_ports, std::make_pair(-1,-1));
+    ep_credits.resize(num_ports);
+    pending.resize(num_ports);
+    send_init_credits.assign(num_ports, false);
+
+    for ( int i = 0; i < num_ports; i++ ) {
+        std::string port_name = "port" + std::to_string(i);
+        if ( !isPortConnected(port_name) ) continue;
+        links[i] = configureLink(port_name, core_tb, new Event::Handler<flow_router,int>(this,&flow_router::handle_input,i));
+        if ( isHostPort(i) ) {
+            ep_credits[i].assign(num_vns, 0);
+            pending[i].resize(num_vns);
+        }
+    }
+
+    timer = configureSelfLink("flow_timer", core_tb, new Event::Handler<flow_router>(this,&flow_router::handle_timer));
+
+    output_credits = new int[num_ports * num_vcs];
+    output_queue_lengths = new int[num_ports * num_vcs];
+    for ( int i = 0; i < num_ports * num_vcs; i++ ) {
+        output_credits[i] = input_buf_flits;
+        output_queue_lengths[i] = 0;
+    }
+    topo->setOutputBufferCreditArray(output_credits, num_vcs);
+    topo->setOutputQueueLengthsArray(output_queue_lengths, num_vcs);
+
+    flows_started = registerStatistic<uint64_t>("flows_started");
+    active_flows = registerStatistic<uint64_t>("active_flows");
+
+    solver = FlowSolver::attach(network_name, this);
+}
+
+RtrInitEvent*
+flow_router::checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func)
+{
+    bool good = true;
+    RtrInitEvent* init_ev = nullptr;
+    if ( nullptr == ev || static_cast<BaseRtrEvent*>(ev)->getType() != BaseRtrEvent::INITIALIZATION ) good = false;
+
+    if ( good ) {
+        init_ev = static_cast<RtrInitEvent*>(ev);
+        if ( init_ev->command != command ) {
+            good = false;
+        }
+    }
+
+    sst_assert(good, line, file, func, 1, "Error during flow_router protocol initialization.  The most likely cause of this is connecting an endpoint to a router port expecting to be connnected to another router.\n");
+    return init_ev;
+}
+
+void
+flow_router::init(unsigned int phase)
+{
+    Event* ev;
+    RtrInitEvent* init_ev;
+
+    // Same protocol as PortControl, so endpoints use an unmodified
+    // LinkControl and routers find their neighbors
+    for ( int i = 0; i < num_ports; i++ ) {
+        if ( links[i] == nullptr ) continue;
+
+        switch ( phase ) {
+        case 0:
+            init_ev = new RtrInitEvent();
+            init_ev->command = RtrInitEvent::REPORT_BW;
+            init_ev->ua_value = link_bw;
+            links[i]->sendUntimedData(init_ev);
+
+            if ( isHostPort(i) ) {
+                init_ev = new RtrInitEvent();
+                init_ev->command = RtrInitEvent::REPORT_FLIT_SIZE;
+                init_ev->ua_value = flit_size;
+                links[i]->sendUntimedData(init_ev);
+
+                init_ev = new RtrInitEvent();
+                init_ev->command = RtrInitEvent::REPORT_ID;
+                init_ev->int_value = topo->getEndpointID(i);
+                links[i]->sendUntimedData(init_ev);
+            }
+            else {
+                init_ev = new RtrInitEvent();
+                init_ev->command = RtrInitEvent::REPORT_ID;
+                init_ev->int_value = id;
+                links[i]->sendUntimedData(init_ev);
+
+                init_ev = new RtrInitEvent();
+                init_ev->command = RtrInitEvent::REPORT_PORT;
+                init_ev->int_value = i;
+                links[i]->sendUntimedData(init_ev);
+            }
+            break;
+
+        case 1:
+        {
+            // Link speed is the minimum of the two sides
+            ev = links[i]->recvUntimedData();
+            init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_BW, CALL_INFO);
+            UnitAlgebra bw = link_bw;
+            if ( bw > init_ev->ua_value ) bw = init_ev->ua_value;
+            port_bw[i] = (bw * getCoreTimeBase()).getDoubleValue();
+            delete ev;
+
+            if ( isHostPort(i) ) {
+                ev = links[i]->recvUntimedData();
+                init_ev = checkInitProtocol(ev, RtrInitEvent::REQUEST_VNS, CALL_INFO);
+                int req_vns = init_ev->int_value;
+                delete ev;
+
+                // Report the number of VNs, then the (identity) mapping
+                init_ev = new RtrInitEvent();
+                init_ev->command = RtrInitEvent::REQUEST_VNS;
+                init_ev->int_value = num_vns;
+                links[i]->sendUntimedData(init_ev);
+
+                for ( int j = 0; j < req_vns; ++j ) {
+                    init_ev = new RtrInitEvent();
+                    init_ev->command = RtrInitEvent::REQUEST_VNS;
+                    init_ev->int_value = j;
+                    links[i]->sendUntimedData(init_ev);
+                }
+                send_init_credits[i] = true;
+            }
+            else {
+                ev = links[i]->recvUntimedData();
+                init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_ID, CALL_INFO);
+                remote[i].first = init_ev->int_value;
+                delete ev;
+
+                ev = links[i]->recvUntimedData();
+                init_ev = checkInitProtocol(ev, RtrInitEvent::REPORT_PORT, CALL_INFO);
+                remote[i].second = init_ev->int_value;
+                delete ev;
+            }
+        }
+            break;
+
+        default:
+            if ( send_init_credits[i] ) {
+                for ( int vn = 0; vn < num_vns; ++vn ) {
+                    links[i]->sendUntimedData(new credit_event(vn, input_buf_flits));
+                }
+                send_init_credits[i] = false;
+            }
+            handle_untimed(i);
+            break;
+        }
+    }
+}
+
+void
+flow_router::complete(unsigned int phase)
+{
+    for ( int i = 0; i < num_ports; i++ ) {
+        if ( links[i] != nullptr ) handle_untimed(i);
+    }
+}
+
+void
+flow_router::handle_untimed(int port)
+{
+    Event* ev;
+    while ( ( ev = links[port]->recvUntimedData() ) != nullptr ) {
+        BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+        switch ( bev->getType() ) {
+        case BaseRtrEvent::CREDIT:
+        {
+            credit_event* ce = static_cast<credit_event*>(ev);
+            if ( ce->vc < (int)ep_credits[port].size() ) ep_credits[port][ce->vc] += ce->credits;
+            delete ev;
+        }
+            break;
+        case BaseRtrEvent::PACKET:
+            solver->routeUntimedData(this, port, static_cast<RtrEvent*>(ev));
+            break;
+        default:
+            delete ev;
+            break;
+        }
+    }
+}
+
+void
+flow_router::setup()
+{
+    solver->setup();
+}
+
+void
+flow_router::finish()
+{
+    for ( auto& port : pending ) {
+        for ( auto& queue : port ) {
+            for ( auto& entry : queue ) delete entry.first;
+            queue.clear();
+        }
+    }
+}
+
+void
+flow_router::handle_input(Event* ev, int port)
+{
+    BaseRtrEvent* bev = static_cast<BaseRtrEvent*>(ev);
+    switch ( bev->getType() ) {
+    case BaseRtrEvent::CREDIT:
+    {
+        credit_event* ce = static_cast<credit_event*>(ev);
+        int vn = ce->vc;
+        if ( vn < (int)ep_credits[port].size() ) {
+            ep_credits[port][vn] += ce->credits;
+            delete ev;
+            // Endpoint freed buffer space, send what was waiting
+            deliver(port, nullptr, 0, vn);
+        }
+        else {
+            delete ev;
+        }
+    }
+        break;
+    case BaseRtrEvent::PACKET:
+        solver->inject(this, port, static_cast<RtrEvent*>(ev));
+        break;
+    default:
+        merlin_abort.fatal(CALL_INFO, 1, "flow_router %d: unexpected event type %d on port %d\n", id, bev->getType(), port);
+        break;
+    }
+}
+
+void
+flow_router::handle_timer(Event* ev)
+{
+    solver->handleTimer();
+}
+
+// Hand ev to the endpoint on port after delay, once the endpoint has
+// credits for it.  With ev == nullptr just sends whatever is waiting
+// on vn.
+void
+flow_router::deliver(int port, RtrEvent* ev, SimTime_t delay, int vn)
+{
+    SimTime_t now = getCurrentSimCycle();
+    if ( ev != nullptr ) {
+        vn = ev->getRouteVN();
+        pending[port][vn].push_back(std::make_pair(ev, now + delay));
+    }
+
+    auto& queue = pending[port][vn];
+    while ( !queue.empty() ) {
+        RtrEvent* pev = queue.front().first;
+        int flits = pev->getSizeInFlits();
+        if ( ep_credits[port][vn] < flits ) break;
+        ep_credits[port][vn] -= flits;
+
+        SimTime_t ready = queue.front().second;
+        links[port]->send(ready > now ? ready - now : 0, pev);
+        queue.pop_front();
+    }
+}
+
+void
+flow_router::returnCredits(int port, int vn, int flits)
+{
+    if ( flits == 0 ) return;
+    links[port]->send(new credit_event(vn, flits));
+}
+
+void
+flow_router::addFlowToPort(int port, int count)
+{
+    for ( int i = 0; i < num_vcs; i++ ) {
+        output_queue_lengths[port * num_vcs + i] += count;
+    }
+}
@@ -0,0 +1,244 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_FLOW_ROUTER_FLOW_ROUTER_H
+#define COMPONENTS_MERLIN_FLOW_ROUTER_FLOW_ROUTER_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/unitAlgebra.h>
+
+#include <deque>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <vector>
+
+#include "sst/elements/merlin/router.h"
+
+using namespace SST;
+
+namespace SST {
+namespace Merlin {
+
+class flow_router;
+
+// Fluid model shared by all the flow_routers of one network.  Every
+// packet that enters a host port is appended to the flow for its
+// (source, destination, VN).  A flow follows the path chosen by the
+// topology objects of the routers it crosses and drains at the rate
+// given by a max-min fair share of the links on that path.  Rates
+// are only recomputed when a flow starts (first packet for an idle
+// source/destination/VN) or ends (last queued packet has drained);
+// packets completing inside a flow that still has data do not
+// change any rates.  Between those points each flow's head packet
+// drains on its own schedule, so flows are kept in a queue ordered
+// by drain time and only the flows that are due are touched.
+class FlowSolver {
+public:
+    static FlowSolver* attach(const std::string& name, flow_router* rtr);
+    static void detach(const std::string& name, flow_router* rtr);
+
+    // Called from each router's setup(); only the first call does
+    // anything
+    void setup();
+
+    void inject(flow_router* rtr, int port, RtrEvent* ev);
+    void routeUntimedData(flow_router* rtr, int port, RtrEvent* ev);
+    void handleTimer();
+
+private:
+    typedef std::tuple<SST::Interfaces::SimpleNetwork::nid_t, SST::Interfaces::SimpleNetwork::nid_t, int> flow_key_t;
+
+    struct Flow {
+        flow_key_t key;
+        flow_router* src_rtr;
+        int src_port;
+        flow_router* dest_rtr;
+        int dest_port;
+        // Resources (directed links) used by the flow
+        std::vector<int> resources;
+        // Router output ports used, for the queue lengths reported
+        // to adaptive topologies
+        std::vector<std::pair<flow_router*,int> > out_ports;
+        SimTime_t latency;
+        std::deque<RtrEvent*> packets;
+        // Bits left to drain for the packet at the front of the
+        // queue, as of cycle 'updated'
+        double head_left;
+        SimTime_t updated;
+        // Bits per core cycle
+        double rate;
+        // Cycle by which the head packet will have drained; only
+        // meaningful while rate > 0
+        SimTime_t drain_time;
+    };
+
+    // Orders the drain queue earliest first.  Ties go by flow key so
+    // packets finishing in the same cycle are delivered in the same
+    // order on every run.
+    struct DrainLater {
+        bool operator()(const Flow* lhs, const Flow* rhs) const {
+            if ( lhs->drain_time != rhs->drain_time ) return lhs->drain_time > rhs->drain_time;
+            return lhs->key > rhs->key;
+        }
+    };
+
+    FlowSolver() : owner(nullptr), refs(0), initialized(false), wakeup_pending(false), wakeup_time(0) {}
+
+    Flow* createFlow(flow_router* rtr, int port, RtrEvent* ev);
+    void advance(Flow* flow, SimTime_t now);
+    void queueDrain(Flow* flow, SimTime_t now);
+    void computeRates(SimTime_t now);
+    void schedule(SimTime_t now);
+    flow_router* getRouter(int id);
+
+    static std::map<std::string, FlowSolver*> solvers;
+
+    std::map<int, flow_router*> routers;
+    // Router that owns the timer and provides the current time
+    flow_router* owner;
+    int refs;
+    bool initialized;
+
+    // Capacity in bits per core cycle of each resource.  Each router
+    // port has two resources: out (router to link) and in (endpoint
+    // to router, only used for host ports)
+    std::vector<double> capacity;
+    // Scratch space for computeRates()
+    std::vector<double> cap_left;
+    std::vector<int> unfixed;
+    std::vector<std::vector<Flow*> > res_flows;
+
+    std::map<flow_key_t, Flow*> flows;
+    // Every flow with a non-zero rate, by drain time.  Rebuilt by
+    // computeRates(), since all drain times move when rates change.
+    std::priority_queue<Flow*, std::vector<Flow*>, DrainLater> drain_queue;
+
+    bool wakeup_pending;
+    SimTime_t wakeup_time;
+};
+
+
+class flow_router : public Component {
+
+public:
+
+    SST_ELI_REGISTER_COMPONENT(
+        flow_router,
+        "merlin",
+        "flow_router",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Flow-level (fluid) router.  Drop-in replacement for hr_router that models traffic as flows sharing link "
+        "bandwidth with max-min fairness instead of simulating flits.  All flow_routers of a network share one "
+        "solver, so the network must be placed on a single rank and thread.",
+        COMPONENT_CATEGORY_NETWORK)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"id",                 "ID of the router."},
+        {"num_ports",          "Number of ports that the router has"},
+        {"link_bw",            "Bandwidth of the links specified in either b/s or B/s (can include SI prefix)."},
+        {"flit_size",          "Flit size specified in either b or B (can include SI prefix).  Packets consume whole flits of bandwidth."},
+        {"input_buf_size",     "Amount of data per VN an endpoint can have in flight into the network, specified in b or B (can include SI prefix)."},
+        {"hop_latency",        "Latency added for each router a packet crosses, covering the router pipeline and its output link.  Specified in s (can include SI prefix).", "20ns"},
+        {"num_vns",            "Number of VNs.","2"},
+        {"network_name",       "Name of the network.  Routers with the same network_name share a flow solver.", ""}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "flows_started",      "Number of flows started with a source on this router", "flows", 1},
+        { "active_flows",       "Number of active flows in the network each time rates are recomputed (router 0 only)", "flows", 1}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(num_ports)d",  "Ports which connect to endpoints or other routers.", { "merlin.RtrEvent", "merlin.credit_event" } }
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"topology", "Topology object to control routing", "SST::Merlin::Topology" }
+    )
+
+private:
+    friend class FlowSolver;
+
+    int id;
+    int num_ports;
+    int num_vns;
+    int num_vcs;
+    std::string network_name;
+
+    Topology* topo;
+    FlowSolver* solver;
+
+    std::vector<Link*> links;
+    Link* timer;
+
+    UnitAlgebra link_bw;
+    UnitAlgebra flit_size;
+    int flit_bits;
+    int input_buf_flits;
+    SimTime_t hop_cycles;
+
+    // Negotiated bandwidth of each port in bits per core cycle
+    std::vector<double> port_bw;
+    // Router and port on the other side of router to router links
+    std::vector<std::pair<int,int> > remote;
+    // First resource index of this router in the solver
+    int res_base;
+
+    // Host port state: credits for the endpoint's input buffers and
+    // packets waiting for them, per VN
+    std::vector<std::vector<int> > ep_credits;
+    std::vector<std::vector<std::deque<std::pair<RtrEvent*,SimTime_t> > > > pending;
+    std::vector<bool> send_init_credits;
+
+    // Handed to the topology so adaptive routing sees the flows
+    int* output_credits;
+    int* output_queue_lengths;
+
+    Statistic<uint64_t>* flows_started;
+    Statistic<uint64_t>* active_flows;
+
+    Output& output;
+
+    RtrInitEvent* checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func);
+    void handle_input(Event* ev, int port);
+    void handle_timer(Event* ev);
+    void handle_untimed(int port);
+
+    bool isHostPort(int port) const { return links[port] != nullptr && topo->isHostPort(port); }
+    void deliver(int port, RtrEvent* ev, SimTime_t delay, int vn = 0);
+    void returnCredits(int port, int vn, int flits);
+    void addFlowToPort(int port, int count);
+
+public:
+    flow_router(ComponentId_t cid, Params& params);
+    ~flow_router();
+
+    void init(unsigned int phase);
+    void complete(unsigned int phase);
+    void setup();
+    void finish();
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_FLOW_ROUTER_FLOW_ROUTER_H
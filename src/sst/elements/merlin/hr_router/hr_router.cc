@@ -283,6 +283,8 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     arb =
         loadAnonymousSubComponent<XbarArbitration>(xbar_arb, "XbarArb", 0, ComponentInfo::INSERT_STATS, empty_params);
 
+    fast_forward = params.find<bool>("fast_forward", false);
+
     my_clock_handler = new Clock::Handler<hr_router>(this,&hr_router::clock_handler);
     xbar_tc = registerClock( xbar_clock, my_clock_handler);
     num_routers++;
@@ -306,6 +308,7 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
         port_name = port_name + std::to_string(i);
         xbar_stalls[i] = registerStatistic<uint64_t>("xbar_stalls",port_name);
     }
+    xbar_fast_forward = registerStatistic<uint64_t>("xbar_fast_forward");
 
     init_vcs();
 }
@@ -319,14 +322,21 @@ hr_router::notifyEvent()
 #if VERIFY_DECLOCKING
     clocking = true;
     Cycle_t next_cycle = getNextClockCycle( xbar_tc );
+    // Report skipped cycles to arbitration unit.
+    arb->reportSkippedCycles(next_cycle - unclocked_cycle);
 #else
     Cycle_t next_cycle = reregisterClock( xbar_tc, my_clock_handler);
+    advance_unclocked(next_cycle);
 #endif
+}
 
-    int64_t elapsed_cycles = next_cycle - unclocked_cycle;
-
+// Bring the busy variables, which hold their values as of
+// unclocked_cycle while the clock is off, forward to cycle
+void
+hr_router::advance_unclocked(Cycle_t cycle)
+{
+    int64_t elapsed_cycles = cycle - unclocked_cycle;
 
-#if !VERIFY_DECLOCKING
     // Fix up the busy variables
     for ( int i = 0; i < num_ports; i++ ) {
     	// Should stop at zero, need to find a clean way to do this
@@ -338,11 +348,42 @@ hr_router::notifyEvent()
     	if ( tmp < 0 ) out_port_busy[i] = 0;
         else out_port_busy[i] = tmp;
     }
-#endif
+    unclocked_cycle = cycle;
+
     // Report skipped cycles to arbitration unit.
     arb->reportSkippedCycles(elapsed_cycles);
 }
 
+void
+hr_router::notifyPacket(int port, int vc)
+{
+#if !VERIFY_DECLOCKING
+    // With the clock off nothing else is buffered in the router, so
+    // if this packet's path through the crossbar is free it is the
+    // only contender and would win arbitration on the next cycle.
+    // Do that transfer now and leave the clock off.
+    if ( fast_forward && get_vcs_with_data() == 1 ) {
+        advance_unclocked(getNextClockCycle(xbar_tc));
+
+        internal_router_event* ev = ports[port]->getVCHeads()[vc];
+        int next_port = ev->getNextPort();
+        int flits = ev->getFlitCount();
+        if ( in_port_busy[port] == 0 && out_port_busy[next_port] == 0 &&
+             ports[next_port]->spaceToSend(ev->getVC(), flits) ) {
+            // Same arbitration state and busy values a clocked grant
+            // would have left behind
+            arb->reportGrant(in_port_busy, port, vc);
+            in_port_busy[port] = flits;
+            out_port_busy[next_port] = flits;
+            xbar_transfer(port, vc);
+            xbar_fast_forward->addData(1);
+            return;
+        }
+    }
+#endif
+    notifyEvent();
+}
+
 void
 hr_router::sigHandler(int signal)
 {
@@ -411,25 +452,7 @@ hr_router::clock_handler(Cycle_t cycle)
     for ( int i = 0; i < num_ports; i++ ) {
         // if ( progress_vcs[i] != -1 ) {
         if ( progress_vcs[i] > -1 ) {
-            internal_router_event* ev = ports[i]->recv(progress_vcs[i]);
-            ports[ev->getNextPort()]->send(ev,ev->getVC());
-
-            if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
-                output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
-                              "over crossbar in router %d (%s) from port %d, VC %d to port"
-                              " %d, VC %d.\n",
-                              ev->getTraceID(),
-                              getCurrentSimTimeNano(),
-                              ev->getSrc(),
-                              ev->getDest(),
-                              id,
-                              getName().c_str(),
-                              i,
-                              progress_vcs[i] ,
-                              ev->getNextPort(),
-                              ev->getVC());
-            }
-
+            xbar_transfer(i, progress_vcs[i]);
         }
         else if ( progress_vcs[i] == -2 ) {
                 xbar_stalls[i]->addData(1);
@@ -444,6 +467,29 @@ hr_router::clock_handler(Cycle_t cycle)
     return false;
 }
 
+void
+hr_router::xbar_transfer(int port, int vc)
+{
+    internal_router_event* ev = ports[port]->recv(vc);
+    ports[ev->getNextPort()]->send(ev,ev->getVC());
+
+    if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
+                      "over crossbar in router %d (%s) from port %d, VC %d to port"
+                      " %d, VC %d.\n",
+                      ev->getTraceID(),
+                      getCurrentSimTimeNano(),
+                      ev->getSrc(),
+                      ev->getDest(),
+                      id,
+                      getName().c_str(),
+                      port,
+                      vc,
+                      ev->getNextPort(),
+                      ev->getVC());
+    }
+}
+
 void hr_router::setup()
 {
     for ( int i = 0; i < num_ports; i++ ) {
@@ -473,18 +519,20 @@ hr_router::init(unsigned int phase)
             std::vector<int> outPorts;
             topo->routeUntimedData(i, ire, outPorts);
             for ( std::vector<int>::iterator j = outPorts.begin() ; j != outPorts.end() ; ++j ) {
-                /* Little tricky here.  Need to clone both the event, and the
-                 * encapsulated event.
+                /* Little tricky here.  Need to copy both the event, and the
+                 * encapsulated event.  The copies share the request, which
+                 * is only cloned if an endpoint takes it while other copies
+                 * are still around.
                  */
                 switch ( topo->getPortState(*j) ) {
                 case Topology::R2N:
-                    ports[*j]->sendUntimedData(ire->getEncapsulatedEvent()->clone());
+                    ports[*j]->sendUntimedData(ire->getEncapsulatedEvent()->share());
                     break;
                 case Topology::R2R:
                 // Ignore failed links during init
                 case Topology::FAILED: {
                     internal_router_event *new_ire = ire->clone();
-                    new_ire->setEncapsulatedEvent(ire->getEncapsulatedEvent()->clone());
+                    new_ire->setEncapsulatedEvent(ire->getEncapsulatedEvent()->share());
                     ports[*j]->sendUntimedData(new_ire);
                     break;
                 }
@@ -523,18 +571,20 @@ hr_router::complete(unsigned int phase)
             std::vector<int> outPorts;
             topo->routeUntimedData(i, ire, outPorts);
             for ( std::vector<int>::iterator j = outPorts.begin() ; j != outPorts.end() ; ++j ) {
-                /* Little tricky here.  Need to clone both the event, and the
-                 * encapsulated event.
+                /* Little tricky here.  Need to copy both the event, and the
+                 * encapsulated event.  The copies share the request, which
+                 * is only cloned if an endpoint takes it while other copies
+                 * are still around.
                  */
                 switch ( topo->getPortState(*j) ) {
                 case Topology::R2N:
-                    ports[*j]->sendUntimedData(ire->getEncapsulatedEvent()->clone());
+                    ports[*j]->sendUntimedData(ire->getEncapsulatedEvent()->share());
                     break;
                 case Topology::R2R:
                 // Ignore failed links during init
                 case Topology::FAILED: {
                     internal_router_event *new_ire = ire->clone();
-                    new_ire->setEncapsulatedEvent(ire->getEncapsulatedEvent()->clone());
+                    new_ire->setEncapsulatedEvent(ire->getEncapsulatedEvent()->share());
                     ports[*j]->sendUntimedData(new_ire);
                     break;
                 }
@@ -68,6 +68,10 @@ public:
         {"num_vns",            "Number of VNs.","2"},
         {"vn_remap",           "Array that specifies the vn remapping for each node in the systsm."},
         {"vn_remap_shm",       "Name of shared memory region for vn remapping.  If empty, no remapping is done", ""},
+        {"fast_forward",       "When the router is idle (clock off), move a packet that finds its crossbar input and output free "
+                               "and enough output credits across the crossbar as it arrives instead of turning the clock on.  Any "
+                               "contention falls back to clocked arbitration.  The xbar_arb unit's state is updated as if it had "
+                               "granted the packet.  Packets may cross up to one crossbar cycle earlier than in clocked mode.", "false"},
         {"debug",              "Turn on debugging for router. Set to 1 for on, 0 for off.", "0"}
     )
 
@@ -76,6 +80,7 @@ public:
         { "send_packet_count",  "Count number of packets sent on link", "packets", 1},
         { "output_port_stalls", "Time output port is stalled (in units of core timebase)", "time in stalls", 1},
         { "xbar_stalls",        "Count number of cycles the xbar is stalled", "cycles", 1},
+        { "xbar_fast_forward",  "Count number of packets moved across the xbar without turning on the router clock", "packets", 1},
         { "idle_time",          "Amount of time spent idle for a given port", "units of core timebase", 1},
         { "width_adj_count",    "Number of times that link width was increased or decreased", "width adjustment count", 1}
     )
@@ -121,6 +126,7 @@ private:
     UnitAlgebra output_buf_size;
 
     Cycle_t unclocked_cycle;
+    bool fast_forward;
     std::string xbar_bw;
     TimeConverter* xbar_tc;
     Clock::Handler<hr_router>* my_clock_handler;
@@ -131,7 +137,10 @@ private:
     static void sigHandler(int signal);
 
     void init_vcs();
+    void advance_unclocked(Cycle_t cycle);
+    void xbar_transfer(int port, int vc);
     Statistic<uint64_t>** xbar_stalls;
+    Statistic<uint64_t>* xbar_fast_forward;
 
     Output& output;
 
@@ -147,6 +156,7 @@ public:
     void finish();
 
     void notifyEvent();
+    void notifyPacket(int port, int vc);
     int const* getOutputBufferCredits() {return xbar_in_credits;}
     int const* getOutputQueueLengths() {return output_queue_lengths;}
 
@@ -185,6 +185,16 @@ public:
     void reportSkippedCycles(Cycle_t cycles) {
     }
 
+    // arbitrate() keeps the order of the entries it did not grant and
+    // moves the granted one to the end of the list
+    void reportGrant(const int* in_port_busy, int port, int vc) {
+        priority_entry_t granted(port, vc);
+        int i = 0;
+        while ( cur_list[i] != granted ) i++;
+        for ( ; i < total_entries - 1; i++ ) cur_list[i] = cur_list[i+1];
+        cur_list[total_entries - 1] = granted;
+    }
+
     void dumpState(std::ostream& stream) {
         /* stream << "Current round robin port: " << rr_port << std::endl; */
         /* stream << "  Current round robin VC by port:" << std::endl; */
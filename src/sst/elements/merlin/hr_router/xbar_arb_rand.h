@@ -231,6 +231,12 @@ public:
     void reportSkippedCycles(Cycle_t cycles) {
     }
 
+    // Draw the priority arbitrate() would have drawn for the one
+    // candidate so the random stream stays the same
+    void reportGrant(const int* in_port_busy, int port, int vc) {
+        rng->nextUniform();
+    }
+
     void dumpState(std::ostream& stream) {
         /* stream << "Current round robin port: " << rr_port << std::endl; */
         /* stream << "  Current round robin VC by port:" << std::endl; */
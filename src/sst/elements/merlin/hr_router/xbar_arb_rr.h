@@ -166,6 +166,15 @@ public:
 #endif
     }
 
+    // arbitrate() advances the VC pointer of every port whose xbar
+    // input is free.  rr_port for that cycle is already covered by
+    // reportSkippedCycles().
+    void reportGrant(const int* in_port_busy, int port, int vc) {
+        for ( int i = 0; i < num_ports; i++ ) {
+            if ( in_port_busy[i] <= 0 ) rr_vcs[i] = (rr_vcs[i] + 1) % num_vcs;
+        }
+    }
+
     void dumpState(std::ostream& stream) {
         stream << "Current round robin port: " << rr_port << std::endl;
         stream << "  Current round robin VC by port:" << std::endl;
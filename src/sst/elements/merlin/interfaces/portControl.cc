@@ -532,6 +532,10 @@ PortControl::initVCs(int vns, int* vcs_per_vn, internal_router_event** vc_heads_
         port_ret_credits[i] = ibs.getRoundedValue();
         xbar_in_credits[i] = obs.getRoundedValue();
         port_out_credits[i] = 0;
+        // Every event uses at least one flit of credit, so the
+        // buffers never hold more events than they have flits
+        input_buf[i].reserve(port_ret_credits[i]);
+        output_buf[i].reserve(xbar_in_credits[i]);
     }
 
 
@@ -878,14 +882,12 @@ void
 PortControl::dumpQueueState(port_queue_t& q, std::ostream& stream) {
 	int size = q.size();
 	for ( int i = 0; i < size; i++ ) {
-	    internal_router_event* ev = q.front();
+	    internal_router_event* ev = q[i];
 	    stream << "      dest = " << ev->getDest()
                << ", size = " << ev->getFlitCount()
                << ", vc = " << ev->getVC()
                << ", next_port = " << ev->getNextPort()
                << std::endl;
-	    q.pop();
-	    q.push(ev);
 	}
 }
 
@@ -893,11 +895,9 @@ void
 PortControl::dumpQueueState(port_queue_t& q, Output& out) {
 	int size = q.size();
 	for ( int i = 0; i < size; i++ ) {
-	    internal_router_event* ev = q.front();
+	    internal_router_event* ev = q[i];
         out.output("      dest = %d, size = %d, vc = %d, next_port = %d\n",
                    ev->getDest(), ev->getFlitCount(), ev->getVC(), ev->getNextPort());
-	    q.pop();
-	    q.push(ev);
 	}
 }
 
@@ -976,7 +976,7 @@ PortControl::handle_input_n2r(Event* ev)
                           event->getDest());
 	    }
 
-	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyEvent();
+	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyPacket(port_number, curr_vc);
 	}
     break;
 	case BaseRtrEvent::INTERNAL:
@@ -1059,7 +1059,7 @@ PortControl::handle_input_r2r(Event* ev)
                           event->getDest());
 	    }
 
-	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyEvent();
+	    if ( parent->getRequestNotifyOnEvent() ) parent->notifyPacket(port_number, curr_vc);
 	}
     break;
 	case BaseRtrEvent::CTRL:
@@ -826,7 +826,7 @@ class hr_router(RouterTemplate):
         RouterTemplate.__init__(self)
 
         self._declareParams("params",["link_bw","flit_size","xbar_bw","input_latency","output_latency","input_buf_size","output_buf_size",
-                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
+                                      "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm","fast_forward"])
 
         self._declareParams("params",["qos_settings"],"portcontrol.arbitration.")
         self._declareParams("params",["output_arb", "enable_congestion_management", "cm_outstanding_threshold", "cm_incast_threshold"],"portcontrol.")
@@ -858,6 +858,35 @@ class hr_router(RouterTemplate):
     def getTopologySlotName(self):
         return "topology"
 
+# Flow-level (fluid) model of the network.  Uses the same topologies
+# and network interfaces as hr_router, but all routers must be on one
+# rank.
+class flow_router(RouterTemplate):
+    _default_linkcontrol = "sst.merlin.interface.LinkControl"
+
+    def __init__(self):
+        RouterTemplate.__init__(self)
+
+        self._declareParams("params",["link_bw","flit_size","input_buf_size","hop_latency","num_vns","network_name"])
+
+    def getDefaultNetworkInterface(self):
+        module_name, class_name = flow_router._default_linkcontrol.rsplit(".", 1)
+        return getattr(import_module(module_name), class_name)()
+
+    def instanceRouter(self, name, radix, rtr_id):
+        if self._check_first_build():
+            sst.addGlobalParams("%s_params"%self._instance_name, self._getGroupParams("params"))
+
+        rtr = sst.Component(name, "merlin.flow_router")
+        self._applyStatisticsSettings(rtr)
+        rtr.addGlobalParamSet("%s_params"%self._instance_name)
+        rtr.addParam("num_ports",radix)
+        rtr.addParam("id",rtr_id)
+        return rtr
+
+    def getTopologySlotName(self):
+        return "topology"
+
 class SystemEndpoint(Buildable):
     def __init__(self,system):
         Buildable.__init__(self)
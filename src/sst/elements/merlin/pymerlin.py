@@ -203,7 +203,7 @@ class topoTorus(Topo):
                 links[name] = sst.Link(name)
             return links[name]
 
-        swap_keys = [("torus.shape","shape"),("torus.width","width"),("torus.local_ports","local_ports")]
+        swap_keys = [("torus.shape","shape"),("torus.width","width"),("torus.local_ports","local_ports"),("torus.route_table","route_table")]
 
         _topo_params = _params.subsetWithRename(swap_keys);
 
@@ -696,7 +696,7 @@ class topoFatTree(Topo):
     def build(self):
 #        print("build()")
 
-        swap_keys = [("fattree.shape","shape"),("fattree.algorithm","algorithm"),("fattree.adaptive_threshold","adaptive_threshold")]
+        swap_keys = [("fattree.shape","shape"),("fattree.algorithm","algorithm"),("fattree.adaptive_threshold","adaptive_threshold"),("fattree.route_table","route_table")]
 
         self._topo_params = _params.subsetWithRename(swap_keys);
 
@@ -0,0 +1,97 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_RING_QUEUE_H
+#define COMPONENTS_MERLIN_RING_QUEUE_H
+
+#include <cstddef>
+#include <utility>
+
+namespace SST {
+namespace Merlin {
+
+// FIFO with the std::queue interface used by the router ports, kept
+// in a power-of-two ring buffer.  VC buffers are credit limited, so
+// once reserve() has been called with the buffer depth the queue
+// never allocates again.  If a queue does fill up (e.g. zero-flit
+// events, which do not consume credits) it doubles in size rather
+// than failing.
+template <typename T>
+class ring_queue {
+public:
+    ring_queue() : buf(nullptr), mask(0), head(0), count(0) {}
+    explicit ring_queue(size_t capacity) : ring_queue() { reserve(capacity); }
+    ~ring_queue() { delete [] buf; }
+
+    ring_queue(const ring_queue&) = delete;
+    ring_queue& operator=(const ring_queue&) = delete;
+
+    inline bool empty() const { return count == 0; }
+    inline size_t size() const { return count; }
+    inline size_t capacity() const { return buf ? mask + 1 : 0; }
+
+    inline T& front() { return buf[head]; }
+    inline const T& front() const { return buf[head]; }
+    inline T& back() { return buf[(head + count - 1) & mask]; }
+    inline const T& back() const { return buf[(head + count - 1) & mask]; }
+
+    // Element i positions from the front, for walking the queue
+    // without disturbing it
+    inline T& operator[](size_t i) { return buf[(head + i) & mask]; }
+    inline const T& operator[](size_t i) const { return buf[(head + i) & mask]; }
+
+    inline void push(const T& val) {
+        if ( count == capacity() ) grow(count + 1);
+        buf[(head + count) & mask] = val;
+        count++;
+    }
+
+    inline void pop() {
+        head = (head + 1) & mask;
+        count--;
+    }
+
+    // Make room for at least n entries (rounded up to a power of two)
+    void reserve(size_t n) {
+        if ( n > capacity() ) grow(n);
+    }
+
+private:
+    void grow(size_t n) {
+        size_t new_size = capacity() ? capacity() : 1;
+        while ( new_size < n ) new_size <<= 1;
+        T* new_buf = new T[new_size];
+        for ( size_t i = 0; i < count; i++ ) {
+            new_buf[i] = std::move(buf[(head + i) & mask]);
+        }
+        delete [] buf;
+        buf = new_buf;
+        mask = new_size - 1;
+        head = 0;
+    }
+
+    T* buf;
+    size_t mask;
+    size_t head;
+    size_t count;
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_RING_QUEUE_H
@@ -27,8 +27,11 @@
 #include <sst/core/unitAlgebra.h>
 #include <sst/core/interfaces/simpleNetwork.h>
 
+#include <atomic>
 #include <queue>
 
+#include "sst/elements/merlin/ring_queue.h"
+
 namespace SST {
 namespace Merlin {
 
@@ -65,6 +68,10 @@ public:
     inline bool getRequestNotifyOnEvent() { return requestNotifyOnEvent; }
 
     virtual void notifyEvent() {}
+    // Called by a port when a packet is queued on port/vc while
+    // getRequestNotifyOnEvent() is set.  Routers that can move the
+    // packet without turning their clock back on override this.
+    virtual void notifyPacket(int port, int vc) { notifyEvent(); }
 
     inline void inc_vcs_with_data() { vcs_with_data++; }
     inline void dec_vcs_with_data() { vcs_with_data--; }
@@ -116,12 +123,14 @@ public:
 
     RtrEvent() :
         BaseRtrEvent(BaseRtrEvent::PACKET),
+        request_refs(nullptr),
         injectionTime(0)
     {}
 
     RtrEvent(SST::Interfaces::SimpleNetwork::Request* req, SST::Interfaces::SimpleNetwork::nid_t trusted_src, int route_vn) :
         BaseRtrEvent(BaseRtrEvent::PACKET),
         request(req),
+        request_refs(nullptr),
         trusted_src(trusted_src),
         route_vn(route_vn),
         injectionTime(0)
@@ -130,7 +139,13 @@ public:
 
     ~RtrEvent()
     {
-        if (request) delete request;
+        if ( request_refs ) {
+            if ( --(*request_refs) == 0 ) {
+                delete request;
+                delete request_refs;
+            }
+        }
+        else if (request) delete request;
     }
 
     inline void setInjectionTime(SimTime_t time) {injectionTime = time;}
@@ -139,9 +154,20 @@ public:
     virtual RtrEvent* clone(void)  override {
         RtrEvent *ret = new RtrEvent(*this);
         ret->request = this->request->clone();
+        ret->request_refs = nullptr;
         return ret;
     }
 
+    // Copy of the event that shares the request (and its payload)
+    // with this one instead of cloning it.  Used for multicast
+    // fan-out; the request is only cloned if an endpoint takes it
+    // while other copies are still alive.
+    RtrEvent* share(void) {
+        if ( request_refs == nullptr ) request_refs = new std::atomic<int>(1);
+        (*request_refs)++;
+        return new RtrEvent(*this);
+    }
+
     inline SimTime_t getInjectionTime(void) const { return injectionTime; }
     inline SST::Interfaces::SimpleNetwork::Request::TraceType getTraceType() const {return request->getTraceType();}
     inline int getTraceID() const {return request->getTraceID();}
@@ -158,6 +184,19 @@ public:
     inline int getLogicalVN() { return request->vn; }
     SST::Interfaces::SimpleNetwork::Request* takeRequest() {
         auto ret = request;
+        if ( request_refs ) {
+            if ( request_refs->load() != 1 ) {
+                ret = request->clone();
+                if ( --(*request_refs) == 0 ) {
+                    delete request;
+                    delete request_refs;
+                }
+            }
+            else {
+                delete request_refs;
+            }
+            request_refs = nullptr;
+        }
         request = nullptr;
         return ret;
     }
@@ -179,6 +218,10 @@ public:
 
 private:
     SST::Interfaces::SimpleNetwork::Request* request;
+    // Reference count when request is shared with other RtrEvents
+    // (see share()), nullptr if this event owns it outright.  Not
+    // serialized: a copy received over a link owns its request.
+    std::atomic<int>* request_refs;
 
     SST::Interfaces::SimpleNetwork::nid_t trusted_src;
     int route_vn;
@@ -428,6 +471,42 @@ public:
         if ( encap_ev != NULL ) delete encap_ev;
     }
 
+    // An internal_router_event (or topology specific subclass) is
+    // created for every packet that enters a router, so recycle the
+    // storage through per-thread free lists.  Subclasses differ in
+    // size, so there is one list per POOL_GRANULE sized class.  Only
+    // the event object itself comes from the pool: subclasses that
+    // allocate per-packet arrays (e.g. topo_torus_event, topo_mesh_event
+    // and topo_hyperx_event allocate dest_loc in process_input() and
+    // clone()) still do so on the heap.
+    static void* operator new(size_t size) {
+        size_t cls = (size + POOL_GRANULE - 1) / POOL_GRANULE;
+        if ( cls >= POOL_CLASSES ) return ::operator new(size);
+        EventPool& pool = eventPool(cls);
+        if ( pool.head ) {
+            PoolBlock* block = pool.head;
+            pool.head = block->next;
+            pool.count--;
+            return block;
+        }
+        return ::operator new(cls * POOL_GRANULE);
+    }
+
+    static void operator delete(void* ptr, size_t size) {
+        size_t cls = (size + POOL_GRANULE - 1) / POOL_GRANULE;
+        if ( cls < POOL_CLASSES ) {
+            EventPool& pool = eventPool(cls);
+            if ( pool.count < POOL_LIMIT ) {
+                PoolBlock* block = static_cast<PoolBlock*>(ptr);
+                block->next = pool.head;
+                pool.head = block;
+                pool.count++;
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
     virtual internal_router_event* clone(void) override
     {
         return new internal_router_event(*this);
@@ -477,6 +556,21 @@ public:
     }
 
 private:
+    static const size_t POOL_GRANULE = 16;
+    static const size_t POOL_CLASSES = 32;
+    static const size_t POOL_LIMIT = 65536;
+
+    struct PoolBlock { PoolBlock* next; };
+    struct EventPool {
+        PoolBlock* head;
+        size_t count;
+    };
+
+    static EventPool& eventPool(size_t cls) {
+        static thread_local EventPool pools[POOL_CLASSES] = {};
+        return pools[cls];
+    }
+
     ImplementSerializable(SST::Merlin::internal_router_event)
 };
 
@@ -568,7 +662,9 @@ public:
     // params are: parent router, router id, port number, topology object
     SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Merlin::PortInterface, Router*, int, int, Topology*)
 
-    typedef std::queue<internal_router_event*> port_queue_t;
+    // VC buffers are credit limited, so a fixed-size ring buffer
+    // (sized in initVCs()) replaces the deque behind std::queue
+    typedef ring_queue<internal_router_event*> port_queue_t;
     typedef std::queue<CtrlRtrEvent*> ctrl_queue_t;
 
     virtual void recvCtrlEvent(CtrlRtrEvent* ev) = 0;
@@ -650,6 +746,12 @@ public:
     virtual void setPorts(int num_ports, int num_vcs) = 0;
     virtual bool isOkayToPauseClock() { return true; }
     virtual void reportSkippedCycles(Cycle_t cycles) {};
+    // Called instead of arbitrate() when the router moves the only
+    // waiting packet (port, vc) across the crossbar with its clock
+    // off.  in_port_busy is what arbitrate() would have seen on that
+    // cycle.  Units that keep state update it as if arbitrate() had
+    // granted the packet.
+    virtual void reportGrant(const int* in_port_busy, int port, int vc) {};
     virtual void dumpState(std::ostream& stream) {};
 
 };
@@ -12,6 +12,7 @@
 # distribution.
 
 import sst
+import argparse
 from sst.merlin.base import *
 from sst.merlin.endpoint import *
 from sst.merlin.topology import *
@@ -20,6 +21,10 @@ from sst.merlin.router import *
 
 if __name__ == "__main__":
 
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--untimed_bcast", help="have every endpoint broadcast during init (output must match the default)", action="store_true")
+    args = parser.parse_args()
+
     PlatformDefinition.loadPlatformFile("platform_file_dragon_128")
     PlatformDefinition.setCurrentPlatform("platform_dragon_128")
 
@@ -29,6 +34,8 @@ if __name__ == "__main__":
 
     ### set up the endpoint
     ep = TestJob(0,system.topology.getNumNodes())
+    if args.untimed_bcast:
+        ep.send_untimed_bcast = True
         
     system.allocateNodes(ep,"linear")
 
@@ -12,13 +12,20 @@
 # distribution.
 
 import sst
+import argparse
 from sst.merlin.base import *
 from sst.merlin.endpoint import *
 from sst.merlin.interface import *
 from sst.merlin.topology import *
+from sst.merlin.targetgen import *
 
 if __name__ == "__main__":
 
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--route_table", help="route from the topology's precomputed table (output must match the default)", action="store_true")
+    parser.add_argument("--fast_forward", help="let idle routers move uncontended packets without turning their clock on", action="store_true")
+    parser.add_argument("--offered_load", help="replace the test NICs with uniform random traffic at this load and report its average latency")
+    args = parser.parse_args()
 
     ### Setup the topology
     topo = topoDragonFly()
@@ -27,6 +34,8 @@ if __name__ == "__main__":
     topo.intergroup_links = 4
     topo.num_groups = 5
     topo.algorithm = ["minimal","ugal"]
+    if args.route_table:
+        topo.route_table = True
 
     group_size = topo.hosts_per_router * topo.routers_per_group
     
@@ -41,6 +50,8 @@ if __name__ == "__main__":
     router.output_buf_size = "4kB"
     router.num_vns = 2
     router.xbar_arb = "merlin.xbar_arb_lru"
+    if args.fast_forward:
+        router.fast_forward = True
 
     topo.router = router
     topo.link_latency = "20ns"
@@ -60,22 +71,37 @@ if __name__ == "__main__":
     networkif.vn_remap = [0]
     networkif2.vn_remap = [1]
     
-    ep = TestJob(0,(topo.getNumNodes() - group_size) // 2)
-    ep.network_interface = networkif
-    #ep.num_messages = 10
-    #ep.message_size = "8B"
-    #ep.send_untimed_bcast = False
-        
-    ep2 = TestJob(1,(topo.getNumNodes() - group_size) // 2)
-    ep2.network_interface = networkif2
-    #ep.num_messages = 10
-    #ep.message_size = "8B"
-    #ep.send_untimed_bcast = False
-        
     system = System()
     system.setTopology(topo)
-    system.allocateNodes(ep,"linear")
-    system.allocateNodes(ep2,"linear")
+
+    if args.offered_load:
+        # Latency run: every endpoint sends on the ugal VN
+        ep = OfferedLoadJob(0,topo.getNumNodes())
+        ep.network_interface = networkif2
+        ep.pattern = UniformTarget()
+        ep.offered_load = args.offered_load
+        ep.link_bw = "4GB/s"
+        ep.message_size = "64B"
+        ep.warmup_time = "1us"
+        ep.collect_time = "5us"
+        ep.drain_time = "5us"
+        system.allocateNodes(ep,"linear")
+
+    else:
+        ep = TestJob(0,(topo.getNumNodes() - group_size) // 2)
+        ep.network_interface = networkif
+        #ep.num_messages = 10
+        #ep.message_size = "8B"
+        #ep.send_untimed_bcast = False
+        
+        ep2 = TestJob(1,(topo.getNumNodes() - group_size) // 2)
+        ep2.network_interface = networkif2
+        #ep.num_messages = 10
+        #ep.message_size = "8B"
+        #ep.send_untimed_bcast = False
+        
+        system.allocateNodes(ep,"linear")
+        system.allocateNodes(ep2,"linear")
 
     system.build()
     
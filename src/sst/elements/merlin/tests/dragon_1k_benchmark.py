@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Simulator-performance benchmark: a 1024-router dragonfly (64 groups of
+# 16 routers, 4 hosts per router, 4096 endpoints) under uniform random
+# offered load.  Not part of the test suite; run it through
+# run_dragon_1k_benchmark.py, which times the router modes against each
+# other.
+#
+#   sst dragon_1k_benchmark.py -- --fast_forward --offered_load=0.2
+
+import sst
+import argparse
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+from sst.merlin.targetgen import *
+
+if __name__ == "__main__":
+
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--route_table", help="route from the topology's precomputed table", action="store_true")
+    parser.add_argument("--fast_forward", help="let idle routers move uncontended packets without turning their clock on", action="store_true")
+    parser.add_argument("--algorithm", help="dragonfly routing algorithm", choices=["minimal", "ugal"], default="ugal")
+    parser.add_argument("--offered_load", help="load offered by each endpoint, as a fraction of link bandwidth", default="0.3")
+    parser.add_argument("--warmup_time", help="time before latencies are recorded", default="2us")
+    parser.add_argument("--collect_time", help="time over which latencies are recorded", default="10us")
+    parser.add_argument("--drain_time", help="time allowed for the network to drain", default="10us")
+    args = parser.parse_args()
+
+    ### Setup the topology
+    topo = topoDragonFly()
+    topo.hosts_per_router = 4
+    topo.routers_per_group = 16
+    topo.intergroup_links = 1
+    topo.num_groups = 64
+    topo.algorithm = args.algorithm
+    if args.route_table:
+        topo.route_table = True
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 1
+    router.xbar_arb = "merlin.xbar_arb_lru"
+    if args.fast_forward:
+        router.fast_forward = True
+
+    topo.router = router
+    topo.link_latency = "20ns"
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = OfferedLoadJob(0, topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.pattern = UniformTarget()
+    ep.offered_load = args.offered_load
+    ep.link_bw = "4GB/s"
+    ep.message_size = "64B"
+    ep.warmup_time = args.warmup_time
+    ep.collect_time = args.collect_time
+    ep.drain_time = args.drain_time
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep, "linear")
+
+    system.build()
@@ -12,10 +12,15 @@
 # distribution.
 
 import sst
+import argparse
 from sst.merlin import *
 
 if __name__ == "__main__":
 
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--route_table", help="route from the topology's precomputed table (output must match the default)", action="store_true")
+    args = parser.parse_args()
+
     topo = topoFatTree()
     endPoint = TestEndPoint()
 
@@ -34,6 +39,8 @@ if __name__ == "__main__":
 
     #sst.merlin._params["checkerboard"] = "1"
     sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+    if args.route_table:
+        sst.merlin._params["fattree.route_table"] = "1"
 
     topo.prepParams()
     endPoint.prepParams()
@@ -0,0 +1,56 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2024 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2024, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+# Flow-level model of a small torus.  Two endpoints per router, so
+# some flows never leave their source router.  Every endpoint also
+# broadcasts during init.
+if __name__ == "__main__":
+
+    ### Setup the topology
+    topo = topoTorus()
+    topo.shape = "4x4"
+    topo.width = "1x1"
+    topo.local_ports = 2
+
+    # Set up the routers
+    router = flow_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.input_buf_size = "4kB"
+    router.hop_latency = "20ns"
+    router.num_vns = 2
+
+    topo.router = router
+    topo.link_latency = "20ns"
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    ep = TestJob(0,topo.getNumNodes())
+    ep.network_interface = networkif
+    ep.send_untimed_bcast = True
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+
+    system.build()
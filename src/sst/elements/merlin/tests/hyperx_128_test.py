@@ -12,6 +12,7 @@
 # distribution.
 
 import sst
+import argparse
 from sst.merlin.base import *
 from sst.merlin.endpoint import *
 from sst.merlin.interface import *
@@ -19,6 +20,9 @@ from sst.merlin.topology import *
 
 if __name__ == "__main__":
 
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--route_table", help="route from the topology's precomputed table (output must match the default)", action="store_true")
+    args = parser.parse_args()
 
     ### Setup the topology
     topo = topoHyperX()
@@ -26,6 +30,8 @@ if __name__ == "__main__":
     topo.width = "2x2"
     topo.local_ports = 8
     topo.algorithm = ["DOR","MIN-A"]
+    if args.route_table:
+        topo.route_table = True
     
     # Set up the routers
     router = hr_router()
@@ -0,0 +1,139 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Standalone check that ring_queue behaves like the std::queue it
+// replaced for the router VC buffers.  Built as a check program by the
+// merlin Makefile and run by 'make check' and by test_merlin_ring_queue
+// in testsuite_default_merlin.py:
+//
+//   make tests/ring_queue_check
+//   ./tests/ring_queue_check [operations] [seed]
+//
+// Prints "ring_queue check passed" and exits 0 on success.
+
+#include <sst/elements/merlin/ring_queue.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+#include <random>
+
+using SST::Merlin::ring_queue;
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                       \
+        if ( !(cond) ) {                                            \
+            fprintf(stderr, "FAILED line %d: ", __LINE__);          \
+            fprintf(stderr, __VA_ARGS__);                           \
+            fprintf(stderr, "\n");                                  \
+            if ( ++failures > 10 ) exit(1);                         \
+        }                                                           \
+    } while (0)
+
+// Random push/pop sequence compared against std::queue, including
+// growth past the reserved capacity and wrap-around of the head
+static void check_random(unsigned long ops, unsigned long seed)
+{
+    std::mt19937_64 rng(seed);
+    ring_queue<unsigned long> rq(4);
+    std::queue<unsigned long> ref;
+    unsigned long next = 0;
+
+    for ( unsigned long i = 0; i < ops; i++ ) {
+        // Bias towards pushes for the first half and pops for the
+        // second so the queue both grows and drains
+        unsigned push_pct = ( i < ops / 2 ) ? 55 : 45;
+        if ( ref.empty() || (rng() % 100) < push_pct ) {
+            rq.push(next);
+            ref.push(next);
+            next++;
+        }
+        else {
+            CHECK(rq.front() == ref.front(), "front %lu != %lu at op %lu", rq.front(), ref.front(), i);
+            rq.pop();
+            ref.pop();
+        }
+
+        CHECK(rq.size() == ref.size(), "size %zu != %zu at op %lu", rq.size(), ref.size(), i);
+        CHECK(rq.empty() == ref.empty(), "empty mismatch at op %lu", i);
+        if ( !ref.empty() ) {
+            CHECK(rq.front() == ref.front(), "front %lu != %lu at op %lu", rq.front(), ref.front(), i);
+            CHECK(rq.back() == ref.back(), "back %lu != %lu at op %lu", rq.back(), ref.back(), i);
+            CHECK(rq[rq.size() - 1] == ref.back(), "operator[] disagrees with back at op %lu", i);
+        }
+    }
+
+    // Drain and compare the remaining order
+    while ( !ref.empty() ) {
+        CHECK(rq.front() == ref.front(), "drain front %lu != %lu", rq.front(), ref.front());
+        rq.pop();
+        ref.pop();
+    }
+    CHECK(rq.empty(), "ring_queue not empty after drain");
+}
+
+// PortControl::initVCs reserves each VC queue with its credit count.
+// Filling to that depth, and cycling through it, must not reallocate.
+static void check_reserved(unsigned long seed)
+{
+    std::mt19937_64 rng(seed);
+    const size_t depths[] = { 1, 3, 8, 100, 128, 1000 };
+    for ( size_t depth : depths ) {
+        ring_queue<int*> rq;
+        rq.reserve(depth);
+        size_t cap = rq.capacity();
+        CHECK(cap >= depth, "capacity %zu < reserved %zu", cap, depth);
+
+        std::queue<int*> ref;
+        for ( unsigned long i = 0; i < 20 * depth; i++ ) {
+            if ( ref.size() < depth && (ref.empty() || rng() % 2) ) {
+                int* p = reinterpret_cast<int*>(i + 1);
+                rq.push(p);
+                ref.push(p);
+            }
+            else {
+                CHECK(rq.front() == ref.front(), "depth %zu: front mismatch at op %lu", depth, i);
+                rq.pop();
+                ref.pop();
+            }
+        }
+        CHECK(rq.capacity() == cap, "depth %zu: queue reallocated (%zu -> %zu)", depth, cap, rq.capacity());
+
+        // Walking with operator[] (dumpQueueState) must not disturb the queue
+        size_t n = rq.size();
+        for ( size_t i = 0; i < n; i++ ) {
+            CHECK(rq[i] != nullptr, "depth %zu: null entry at %zu", depth, i);
+        }
+        CHECK(rq.size() == n, "depth %zu: walk changed size", depth);
+        if ( n ) CHECK(rq[0] == ref.front(), "depth %zu: walk changed front", depth);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    unsigned long ops = argc > 1 ? strtoul(argv[1], nullptr, 0) : 1000000;
+    unsigned long seed = argc > 2 ? strtoul(argv[2], nullptr, 0) : 1;
+
+    check_random(ops, seed);
+    check_reserved(seed);
+
+    if ( failures ) {
+        printf("ring_queue check FAILED (%d failures)\n", failures);
+        return 1;
+    }
+    printf("ring_queue check passed\n");
+    return 0;
+}
@@ -2,6 +2,8 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import os
+import re
 
 try:
     from sympy.polys.domains import ZZ
@@ -83,6 +85,11 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_dragon_128_platform_cm(self):
         self.merlin_test_template("dragon_128_platform_test_cm", True)
 
+    # Init-phase broadcasts from every endpoint, four endpoints per router.  Untimed
+    # traffic does not change the simulation, so the reference is the same.
+    def test_merlin_dragon_128_platform_untimed_bcast(self):
+        self.merlin_test_template("dragon_128_platform_test", True, variant="untimed_bcast", other_args='--model-options="--untimed_bcast"')
+
     def test_merlin_dragon_128_fl(self):
         self.merlin_test_template("dragon_128_test_fl")
 
@@ -98,10 +105,132 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_polarstar_504(self):
         self.merlin_test_template("polarstar_504_test")
 
+    # Routing from the precomputed tables must give the same results as the default runs
+    def test_merlin_torus_64_route_table(self):
+        self.merlin_test_template("torus_64_test", variant="route_table", other_args='--model-options="--route_table"')
+
+    def test_merlin_fattree_128_route_table(self):
+        self.merlin_test_template("fattree_128_test", variant="route_table", other_args='--model-options="--route_table"')
+
+    def test_merlin_hyperx_128_route_table(self):
+        self.merlin_test_template("hyperx_128_test", variant="route_table", other_args='--model-options="--route_table"')
+
+    def test_merlin_dragon_128_route_table(self):
+        self.merlin_test_template("dragon_128_test", variant="route_table", other_args='--model-options="--route_table"')
+
+    # A fast-forwarded packet crosses an idle router's xbar when it arrives instead of on
+    # the next xbar edge, so each hop can be up to one xbar cycle early.  Rather than keep
+    # a separate reference, check that the average latency under light uniform traffic
+    # stays within that bound of the clocked run.
+    def test_merlin_dragon_128_fast_forward(self):
+        clocked = self.merlin_latency_template("dragon_128_test", "0.1", "latency")
+        fast_forward = self.merlin_latency_template("dragon_128_test", "0.1", "fast_forward", "--fast_forward")
+
+        # dragon_128_test: 8B flits over a 6GB/s xbar, and a ugal route visits at most
+        # 6 routers (source, gateway, intermediate group in and out, destination group
+        # in, destination)
+        xbar_cycle = 8 / 6.0e9
+        max_routers = 6
+        tolerance = max_routers * xbar_cycle
+        log_debug("dragon_128 average latency: clocked = {0}, fast_forward = {1}, tolerance = {2}".format(clocked, fast_forward, tolerance))
+        self.assertTrue(abs(fast_forward - clocked) <= tolerance,
+                        "Fast-forward average latency {0:.3f} ns is not within {1:.3f} ns of the clocked run ({2:.3f} ns)".format(
+                        fast_forward * 1e9, tolerance * 1e9, clocked * 1e9))
+
+    # The flow model's timing is not comparable to hr_router's, so instead of a reference
+    # check that all 32 endpoints got every packet and every init message
+    @unittest.skipIf(testing_check_get_num_ranks() > 1, "merlin: flow_router only runs serially, test_merlin_flow_router_torus_16 skipped if ranks > 1")
+    @unittest.skipIf(testing_check_get_num_threads() > 1, "merlin: flow_router only runs serially, test_merlin_flow_router_torus_16 skipped if threads > 1")
+    def test_merlin_flow_router_torus_16(self):
+        self.merlin_delivery_template("flow_router_torus_16_test", 32)
+
+    # Not a simulation: builds tests/ring_queue_check through the merlin Makefile ('make check'
+    # also runs it) and checks the router VC queue (ring_queue.h) against std::queue
+    def test_merlin_ring_queue(self):
+        builddir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BUILDDIR", "BUILDDIR_UNDEFINED")
+        merlindir = "{0}/src/sst/elements/merlin".format(builddir)
+        if not os.path.isfile("{0}/Makefile".format(merlindir)):
+            self.skipTest("ring_queue check needs the elements build directory; {0} has no Makefile".format(merlindir))
+
+        rtn = OSCommand("make tests/ring_queue_check", set_cwd=merlindir).run()
+        log_debug("ring_queue_check make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Building tests/ring_queue_check failed:\n{0}".format(rtn.output()))
+
+        rtn = OSCommand("./tests/ring_queue_check", set_cwd=merlindir).run()
+        if rtn.result() != 0:
+            log_failure(rtn.output())
+        self.assertTrue(rtn.result() == 0, "ring_queue_check failed:\n{0}".format(rtn.output()))
+
 
 #####
 
-    def merlin_test_template(self, testcase, cwd=False):
+    # Runs testcase with its --offered_load option and returns the average latency, in
+    # seconds, that the offered_load endpoints report
+    def merlin_latency_template(self, testcase, offered_load, variant, model_args=""):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}_{1}".format(testcase, variant)
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        other_args = '--model-options="--offered_load={0} {1}"'.format(offered_load, model_args)
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, other_args=other_args)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        # The offered_load summary row is '<load> <average latency>', followed by '*'
+        # if the network backed up
+        units = { "s" : 1.0, "ms" : 1e-3, "us" : 1e-6, "ns" : 1e-9, "ps" : 1e-12, "fs" : 1e-15 }
+        row = re.compile(r"\s{0}\s+([-+0-9.eE]+)\s*([munpf]?s)(.*)$".format(re.escape("{0:.2f}".format(float(offered_load)))))
+        with open(outfile) as f:
+            for line in f:
+                m = row.search(line)
+                if m:
+                    self.assertFalse("*" in m.group(3), "Network backed up at offered load {0} in {1}".format(offered_load, outfile))
+                    return float(m.group(1)) * units[m.group(2)]
+        self.fail("No average latency found in {0}".format(outfile))
+
+    # Runs a test_nic based testcase and checks that each of its num_nics endpoints
+    # received all of its packets and init messages, without comparing timing
+    def merlin_delivery_template(self, testcase, num_nics):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}".format(testcase)
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        done = re.compile(r"NIC (\d+) received all packets")
+        finished = set()
+        errors = []
+        complete = False
+        with open(outfile) as f:
+            for line in f:
+                m = done.search(line)
+                if m:
+                    finished.add(int(m.group(1)))
+                elif "didn't receive" in line or "don't match" in line:
+                    errors.append(line.strip())
+                elif "Simulation is complete" in line:
+                    complete = True
+
+        self.assertTrue(complete, "Simulation did not complete; see {0}".format(outfile))
+        self.assertTrue(len(errors) == 0, "Endpoints reported errors:\n{0}".format("\n".join(errors)))
+        missing = sorted(set(range(num_nics)) - finished)
+        self.assertTrue(len(missing) == 0, "NICs {0} did not receive all packets; see {1}".format(missing, outfile))
+
+    def merlin_test_template(self, testcase, cwd=False, variant="", other_args=""):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -112,14 +241,17 @@ class testcase_merlin_Component(SSTTestCase):
 
         sdlfile = "{0}/{1}.py".format(test_path, testcase)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        # Variants must reproduce the reference of the base test
+        if variant:
+            testDataFileName = "{0}_{1}".format(testDataFileName, variant)
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
 
         if cwd:
-            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=test_path)
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=test_path, other_args=other_args)
         else:
-            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, other_args=other_args)
 
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
@@ -130,8 +262,9 @@ class testcase_merlin_Component(SSTTestCase):
         if os_test_file(errfile, "-s"):
             log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
 
-        cmp_result = testing_compare_sorted_diff(testcase, outfile, reffile)
+        diffname = "{0}_{1}".format(testcase, variant) if variant else testcase
+        cmp_result = testing_compare_sorted_diff(diffname, outfile, reffile)
         if (cmp_result == False):
-            diffdata = testing_get_diff_data(testcase)
+            diffdata = testing_get_diff_data(diffname)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
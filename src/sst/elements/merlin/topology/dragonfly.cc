@@ -327,6 +327,11 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
 
     rng = new RNG::XORShiftRNG(rtr_id+1);
 
+    route_row = -1;
+    if ( p.find<bool>("route_table", false) ) {
+        init_route_table(prefix + "route_table");
+    }
+
     output.verbose(CALL_INFO, 1, 1, "%u:%u:  ID: %u   Params:  p = %u  a = %u  k = %u  h = %u  g = %u\n",
             group_id, router_id, rtr_id, params.p, params.a, params.k, params.h, params.g);
 }
@@ -337,6 +342,47 @@ topo_dragonfly::~topo_dragonfly()
     delete[] vns;
 }
 
+void topo_dragonfly::init_route_table(const std::string& name)
+{
+    // Every router's row depends on its group (global link map and
+    // failed links) and its position in the group, so the table
+    // covers the whole network and router 0 fills it in from the
+    // RouteToGroup data it just wrote.
+    size_t row_size = params.g * params.n * params.m;
+    route_row = rtr_id * row_size;
+
+    if ( rtr_id != 0 ) {
+        route_table.initialize(name);
+        route_table.publish();
+        return;
+    }
+
+    route_table.initialize(name, params.g * params.a * row_size, -1);
+    for ( uint32_t src = 0; src < params.g * params.a; src++ ) {
+        uint32_t src_group = src / params.a;
+        uint32_t src_router = src % params.a;
+        for ( uint32_t group = 0; group < params.g; group++ ) {
+            if ( group == src_group ) continue;
+            for ( uint32_t gs = 0; gs < params.n; gs++ ) {
+                const RouterPortPair& pair = group_to_global_port.getRouterPortPairForGroup(src_group, group, gs);
+                if ( group_to_global_port.isFailedPortForGroup(src_group, pair) ) continue;
+                for ( uint32_t ls = 0; ls < params.m; ls++ ) {
+                    int port;
+                    if ( pair.router == src_router ) {
+                        port = pair.port;
+                    }
+                    else {
+                        uint32_t index = (pair.router > src_router) ? pair.router - 1 : pair.router;
+                        port = params.p + ( index * params.m ) + ls;
+                    }
+                    route_table.write(src * row_size + (group * params.n + gs) * params.m + ls, port);
+                }
+            }
+        }
+    }
+    route_table.publish();
+}
+
 
 void topo_dragonfly::route_nonadaptive(int port, int vc, internal_router_event* ev)
 {
@@ -1137,6 +1183,11 @@ int32_t topo_dragonfly::hops_to_router(uint32_t group, uint32_t router, uint32_t
 /* returns local router port if group can't be reached from this router */
 int32_t topo_dragonfly::port_for_group(uint32_t group, uint32_t global_slice, uint32_t local_slice)
 {
+    // The table is empty until it has been published everywhere
+    if ( route_row >= 0 && route_table.size() != 0 ) {
+        return route_table[route_row + (group * params.n + global_slice) * params.m + local_slice];
+    }
+
     const RouterPortPair& pair = group_to_global_port.getRouterPortPair(group,global_slice);
     if ( group_to_global_port.isFailedPort(pair) ) {
         // printf("******** Skipping failed port ********\n");
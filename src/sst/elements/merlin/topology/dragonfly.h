@@ -212,6 +212,9 @@ public:
         {"global_route_mode",     "Mode for intepreting global link map [absolute (default) | relative].","absolute"},
         {"config_failed_links",   "Controls whether or not failed links are considered","False"},
         {"failed_links",          "List of global links to mark as failed.  Only needs to be passed to router 0. Format is \"group1:group2:slice\"",""},
+        {"route_table",           "Precompute the output port for every (router, destination group, global slice, local slice) at "
+                                  "construction and share the table between the routers of the network on a rank.  Minimal and "
+                                  "adaptive routing then look up candidate ports instead of computing them.", "false"},
     )
 
     enum RouteAlgo {
@@ -224,6 +227,12 @@ public:
 
     RouteToGroup group_to_global_port;
 
+    // Optional precomputed routes: route_table[route_row + (group * n +
+    // global_slice) * m + local_slice] is what port_for_group() would
+    // return for this router
+    Shared::SharedArray<int16_t> route_table;
+    int route_row;
+
 
     struct dgnflyParams params;
     double adaptive_threshold;
@@ -286,6 +295,7 @@ private:
     int32_t port_for_group(uint32_t group, uint32_t global_slice, uint32_t local_slice);
     int32_t port_for_group_init(uint32_t group, uint32_t global_slice);
     int32_t hops_to_router(uint32_t group, uint32_t router, uint32_t slice);
+    void init_route_table(const std::string& name);
 
     inline bool is_port_endpoint(uint32_t port) const { return ( port < params.p ); }
     inline bool is_port_local_group(uint32_t port) const { return (port >= params.p && port < (params.p + params.a -1 )); }
@@ -144,7 +144,30 @@ topo_fattree::topo_fattree(ComponentId_t cid, Params& params, int num_ports, int
 
     low_host = level_group * rid;
     high_host = low_host + rid - 1;
-    
+
+    route_row = -1;
+    if ( params.find<bool>("route_table", false) ) {
+        // The table only depends on the shape, so every router on
+        // the rank shares it and router 0 fills it in for all levels
+        std::string name = "fattree_route_table_" + shape;
+        route_row = 2 * rtr_level * total_hosts;
+        if ( id == 0 ) {
+            route_table.initialize(name, 2 * levels * total_hosts, -1);
+            int factor = 1;
+            for ( int l = 0; l < levels; l++ ) {
+                for ( int dest = 0; dest < total_hosts; dest++ ) {
+                    int index = 2 * (l * total_hosts + dest);
+                    route_table.write(index, (dest / factor) % downs[l]);
+                    if ( ups[l] != 0 ) route_table.write(index + 1, downs[l] + ((dest / factor) % ups[l]));
+                }
+                factor *= downs[l];
+            }
+        }
+        else {
+            route_table.initialize(name);
+        }
+        route_table.publish();
+    }
 }
 
 
@@ -155,6 +178,12 @@ topo_fattree::~topo_fattree()
 
 void topo_fattree::route_deterministic(int port, int vc, internal_router_event* ev)  {
     int dest = ev->getDest();
+    // The table is empty until it has been published everywhere
+    if ( route_row >= 0 && route_table.size() != 0 ) {
+        int index = route_row + 2 * dest;
+        ev->setNextPort(route_table[(dest >= low_host && dest <= high_host) ? index : index + 1]);
+        return;
+    }
     // Down routes
     if ( dest >= low_host && dest <= high_host ) {
         ev->setNextPort((dest - low_host) / down_route_factor);
@@ -22,6 +22,7 @@
 #include <sst/core/event.h>
 #include <sst/core/link.h>
 #include <sst/core/params.h>
+#include <sst/core/shared/sharedArray.h>
 
 #include "sst/elements/merlin/router.h"
 
@@ -49,7 +50,10 @@ public:
 
         {"shape",               "Shape of the fattree"},
         {"routing_alg",         "Routing algorithm to use. [deterministic | adaptive]","deterministic"},
-        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."}
+        {"adaptive_threshold",  "Threshold used to determine if a packet will adaptively route."},
+        {"route_table",         "Precompute the down and up port for every destination host at each level at construction "
+                                "and share the table between the routers of the same shape on a rank.  Routing then does a "
+                                "table lookup instead of a division and modulo per hop.", "false"}
     )
 
 
@@ -83,6 +87,12 @@ private:
 
     vn_info* vns;
 
+    // Optional precomputed routes: route_table[route_row + 2*dest] is
+    // the down port toward host dest and the next entry is its
+    // deterministic up port
+    Shared::SharedArray<int16_t> route_table;
+    int route_row;
+
     void parseShape(const std::string &shape, int *downs, int *ups) const;
 
 
@@ -137,6 +137,11 @@ topo_hyperx::topo_hyperx(ComponentId_t cid, Params& params, int num_ports, int r
         total_routers *= dim_size[i];
     }
 
+    route_row = NULL;
+    if ( params.find<bool>("route_table", false) ) {
+        init_route_table("hyperx_route_table_" + shape + "_" + width);
+    }
+
     
     
 }
@@ -148,6 +153,41 @@ topo_hyperx::~topo_hyperx()
     delete [] dim_size;
     delete [] dim_width;
     delete [] port_start;
+    delete [] route_row;
+}
+
+void
+topo_hyperx::init_route_table(const std::string& name)
+{
+    // One dim_size x dim_size block per dimension, indexed by source
+    // and destination coordinate.  The table only depends on the
+    // shape, so every router on the rank shares it and router 0
+    // fills it in.
+    route_row = new int[dimensions];
+    int size = 0;
+    for ( int d = 0 ; d < dimensions ; d++ ) {
+        route_row[d] = size + id_loc[d] * dim_size[d];
+        size += dim_size[d] * dim_size[d];
+    }
+
+    if ( router_id != 0 ) {
+        route_table.initialize(name);
+        route_table.publish();
+        return;
+    }
+
+    route_table.initialize(name, size, -1);
+    int index = 0;
+    for ( int d = 0 ; d < dimensions ; d++ ) {
+        for ( int src = 0 ; src < dim_size[d] ; src++ ) {
+            for ( int dst = 0 ; dst < dim_size[d] ; dst++, index++ ) {
+                if ( src == dst ) continue;
+                int offset = dst - ((dst > src) ? 1 : 0);
+                route_table.write(index, port_start[d] + (offset * dim_width[d]));
+            }
+        }
+    }
+    route_table.publish();
 }
 
 void
@@ -213,8 +253,8 @@ topo_hyperx::process_input(RtrEvent* ev)
     
     // Need to figure out what the hyperx address is for easier
     // routing.
-    int rtr_id = get_dest_router(tt_ev->getDest());
-    idToLocation(rtr_id, tt_ev->dest_loc);
+    tt_ev->dest_router = get_dest_router(tt_ev->getDest());
+    idToLocation(tt_ev->dest_router, tt_ev->dest_loc);
 
 	return tt_ev;
 }
@@ -264,8 +304,8 @@ internal_router_event* topo_hyperx::process_UntimedData_input(RtrEvent* ev)
     tt_ev->setEncapsulatedEvent(ev);
     tt_ev->setVC(vns[tt_ev->getVN()].start_vc);
     if ( tt_ev->getDest() != UNTIMED_BROADCAST_ADDR ) {
-        int rtr_id = get_dest_router(tt_ev->getDest());
-        idToLocation(rtr_id, tt_ev->dest_loc);
+        tt_ev->dest_router = get_dest_router(tt_ev->getDest());
+        idToLocation(tt_ev->dest_router, tt_ev->dest_loc);
     }
     return tt_ev;
 }
@@ -378,10 +418,7 @@ topo_hyperx::routeDORBase(int* dest_loc) {
     for ( int dim = 0 ; dim < dimensions ; ++dim ) {
         // Find first unaligned dimension and route to align it
         if ( dest_loc[dim] != id_loc[dim] ) {
-            // Get offset to the first unaligned dimension
-            int offset = dest_loc[dim] - ((dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-            offset *= dim_width[dim];
-            return std::make_pair(dim,port_start[dim] + offset);
+            return std::make_pair(dim,minimal_port(dim,dest_loc[dim]));
         }
     }
     return std::make_pair(-1,-1);
@@ -469,8 +506,7 @@ void
 topo_hyperx::routeDOAL(int port, int vc, topo_hyperx_event* ev) {
     // We still have to go in dimension order, but we can adaptively
     // route once in each dimension.
-    int dest_router = get_dest_router(ev->getDest());
-    if ( dest_router == router_id ) {
+    if ( ev->dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
     }
     else {
@@ -481,15 +517,14 @@ topo_hyperx::routeDOAL(int port, int vc, topo_hyperx_event* ev) {
             // already adaptively routed, if so, then we have to go
             // direct for this dimension
             if ( ( vc - vns[ev->getVN()].start_vc ) == 1 ) {
-                // Get offset in the dimension
-                int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-                offset *= dim_width[dim];
+                // Get first minimal port in the dimension
+                int offset = minimal_port(dim,ev->dest_loc[dim]);
                 
                 // Choose the least loaded route to the next router
                 int min = 0x7FFFFFFF;
                 int min_port;
                 
-                for ( int p = port_start[dim] + offset; p < port_start[dim] + offset + dim_width[dim]; ++p ) {
+                for ( int p = offset; p < offset + dim_width[dim]; ++p ) {
                     int weight = output_queue_lengths[p * num_vcs + vc];
                     if ( weight < min ) {
                         min = weight;
@@ -511,17 +546,10 @@ topo_hyperx::routeDOAL(int port, int vc, topo_hyperx_event* ev) {
                 int min_port = 0;
                 int min_weight = 0x7fffffff;
                 int min_vc = vc;
+                // Starting port for the minimal link(s)
+                int offset = minimal_port(dim,ev->dest_loc[dim]);
                 for ( int curr_port = port_start[dim]; curr_port < port_start[dim] + ((dim_size[dim] - 1) * dim_width[dim]); ++curr_port  ) {
                     // See if this is a minimal route
-                    
-                    // Compute the base offset in this dimension for
-                    // the minimal route (this is essentially what the
-                    // offset would be if the width in this dimension
-                    // is 1).
-                    int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-                    
-                    // Now get the actual starting port for the minimal link(s)
-                    offset = port_start[dim] + ( offset * dim_width[dim]);
                     if ( curr_port >= offset && curr_port < offset + dim_width[dim] ) {
                         // This is a minimal route.  We would use VC 0
                         // in the VN, which is the VC the packet came
@@ -559,8 +587,7 @@ void
 topo_hyperx::routeMINA(int port, int vc, topo_hyperx_event* ev) {
 
     // Check to see if we made it to the dest router
-    int dest_router = get_dest_router(ev->getDest());
-    if ( dest_router == router_id ) {
+    if ( ev->dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
         return;
     }
@@ -579,8 +606,7 @@ topo_hyperx::routeMINA(int port, int vc, topo_hyperx_event* ev) {
         if ( ev->dest_loc[dim] == id_loc[dim] ) continue;
 
         // Find the minimum weight, minimally-routed port
-        int offset = ev->dest_loc[dim] - ((ev->dest_loc[dim] > id_loc[dim]) ? 1 : 0);
-        offset = port_start[dim] + (offset * dim_width[dim]);
+        int offset = minimal_port(dim,ev->dest_loc[dim]);
 
         for ( int i = offset; i < offset + dim_width[dim]; ++i ) {
             int weight = output_queue_lengths[(i * num_vcs) + vns[vn].start_vc + vc_in_vn + 1];
@@ -600,8 +626,7 @@ topo_hyperx::routeMINA(int port, int vc, topo_hyperx_event* ev) {
 void
 topo_hyperx::routeVDAL(int port, int vc, topo_hyperx_event* ev) {
     // Check to see if we made it to the dest router
-    int dest_router = get_dest_router(ev->getDest());
-    if ( dest_router == router_id ) {
+    if ( ev->dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
         // trace.getOutput().output("Made it to dest router\n");
         return;
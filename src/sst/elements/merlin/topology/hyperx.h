@@ -23,6 +23,7 @@
 #include <sst/core/link.h>
 #include <sst/core/params.h>
 #include <sst/core/rng/rng.h>
+#include <sst/core/shared/sharedArray.h>
 
 #include <string.h>
 #include <vector>
@@ -37,6 +38,8 @@ public:
     int dimensions;
     // First non aligned dimension
     int last_routing_dim;
+    // Router the destination endpoint hangs off, found once on entry
+    int dest_router;
     int* dest_loc;
     bool val_route_dest;
     int* val_loc;
@@ -49,6 +52,7 @@ public:
         internal_router_event(),
         dimensions(dim),
         last_routing_dim(-1),
+        dest_router(-1),
         val_route_dest(false)
     {
         dest_loc = new int[dim];
@@ -74,6 +78,7 @@ public:
         internal_router_event::serialize_order(ser);
         ser & dimensions;
         ser & last_routing_dim;
+        ser & dest_router;
 
         if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
             dest_loc = new int[dimensions];
@@ -170,7 +175,10 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  "
                   "For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
-        {"algorithm", "Routing algorithm to use.", "DOR"}
+        {"algorithm", "Routing algorithm to use.", "DOR"},
+        {"route_table", "Precompute the first minimal port for every (dimension, source, destination) coordinate at "
+                        "construction and share the table between the routers of the same shape on a rank.  Minimal "
+                        "and adaptive routing then look up candidate ports instead of computing them.", "false"}
     )
 
     enum RouteAlgo {
@@ -212,6 +220,12 @@ private:
 
     vn_info* vns;
 
+    // Optional precomputed routes: route_table[route_row[dim] + dest_coord]
+    // is the first of the dim_width[dim] minimal ports toward
+    // dest_coord in dimension dim
+    Shared::SharedArray<int16_t> route_table;
+    int* route_row;
+
 
 public:
     topo_hyperx(ComponentId_t cid, Params& p, int num_ports, int rtr_id, int num_vns);
@@ -243,6 +257,13 @@ private:
     void parseDimString(const std::string &shape, int *output) const;
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
+    void init_route_table(const std::string& name);
+    inline int minimal_port(int dim, int dest_coord) const {
+        // The table is empty until it has been published everywhere
+        if ( route_row && route_table.size() != 0 ) return route_table[route_row[dim] + dest_coord];
+        int offset = dest_coord - ((dest_coord > id_loc[dim]) ? 1 : 0);
+        return port_start[dim] + (offset * dim_width[dim]);
+    }
 
     std::pair<int,int> routeDORBase(int* dest_loc);
     void routeDOR(int port, int vc, topo_hyperx_event* ev);
@@ -25,7 +25,7 @@ class topoHyperX(Topology):
     def __init__(self):
         Topology.__init__(self)
         self._declareClassVariables(["link_latency","host_link_latency","bundleEndpoints","_num_dims","_dim_size","_dim_width"])
-        self._declareParams("main",["shape", "width", "local_ports","algorithm"])
+        self._declareParams("main",["shape", "width", "local_ports","algorithm","route_table"])
         self._setCallbackOnWrite("shape",self._shape_callback)
         self._setCallbackOnWrite("width",self._shape_callback)
         self._setCallbackOnWrite("local_ports",self._shape_callback)
@@ -83,6 +83,11 @@ topo_torus::topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr
 
     id_loc = new int[dimensions];
     idToLocation(router_id, id_loc);
+
+    route_row = NULL;
+    if ( params.find<bool>("route_table", false) ) {
+        init_route_table("torus_route_table_" + shape + "_" + width);
+    }
 }
 
 topo_torus::~topo_torus()
@@ -91,20 +96,68 @@ topo_torus::~topo_torus()
     delete [] dim_size;
     delete [] dim_width;
     delete [] port_start;
+    delete [] route_row;
+}
+
+void
+topo_torus::init_route_table(const std::string& name)
+{
+    // One dim_size x dim_size block per dimension, indexed by source
+    // and destination coordinate.  The table only depends on the
+    // shape, so every router on the rank shares it and router 0
+    // fills it in.
+    route_row = new int[dimensions];
+    int size = 0;
+    for ( int d = 0 ; d < dimensions ; d++ ) {
+        route_row[d] = size + id_loc[d] * dim_size[d];
+        size += dim_size[d] * dim_size[d];
+    }
+
+    if ( router_id != 0 ) {
+        route_table.initialize(name);
+        route_table.publish();
+        return;
+    }
+
+    route_table.initialize(name, size, -1);
+    int index = 0;
+    for ( int d = 0 ; d < dimensions ; d++ ) {
+        for ( int src = 0 ; src < dim_size[d] ; src++ ) {
+            for ( int dst = 0 ; dst < dim_size[d] ; dst++, index++ ) {
+                if ( src == dst ) continue;
+                int dist_neg = src - dst;
+                if ( dist_neg < 0 ) dist_neg += dim_size[d];
+                int dist_pos = dst - src;
+                if ( dist_pos < 0 ) dist_pos += dim_size[d];
+                int go_pos = (dist_pos <= dist_neg);
+                route_table.write(index, choose_multipath(port_start[d][(go_pos) ? 0 : 1], dim_width[d],
+                                                          (go_pos) ? dist_pos : dist_neg));
+            }
+        }
+    }
+    route_table.publish();
 }
 
 void
 topo_torus::route_packet(int port, int vc, internal_router_event* ev)
 {
-    int dest_router = get_dest_router(ev->getDest());
-    if ( dest_router == router_id ) {
+    topo_torus_event *tt_ev = static_cast<topo_torus_event*>(ev);
+    if ( tt_ev->dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
     } else {
-        topo_torus_event *tt_ev = static_cast<topo_torus_event*>(ev);
-
         for ( int dim = tt_ev->routing_dim ; dim < dimensions ; dim++ ) {
             if ( tt_ev->dest_loc[dim] != id_loc[dim] ) {
 
+                // The table is empty until it has been published
+                // everywhere; fall back to computing the route
+                if ( route_row && route_table.size() != 0 ) {
+                    tt_ev->setNextPort(route_table[route_row[dim] + tt_ev->dest_loc[dim]]);
+                    if ( id_loc[dim] == 0 && port < local_port_start ) { // Crossing dateline
+                        tt_ev->setVC(vc ^ 1);
+                    }
+                    break;
+                }
+
                 int dist_neg = id_loc[dim] - tt_ev->dest_loc[dim];
                 if ( dist_neg < 0 ) dist_neg += dim_size[dim];
                 int dist_pos = tt_ev->dest_loc[dim] - id_loc[dim];
@@ -151,8 +204,8 @@ topo_torus::process_input(RtrEvent* ev)
     
     // Need to figure out what the torus address is for easier
     // routing.
-    int run_id = get_dest_router(tt_ev->getDest());
-    idToLocation(run_id, tt_ev->dest_loc);
+    tt_ev->dest_router = get_dest_router(tt_ev->getDest());
+    idToLocation(tt_ev->dest_router, tt_ev->dest_loc);
 
 	return tt_ev;
 }
@@ -206,8 +259,8 @@ internal_router_event* topo_torus::process_UntimedData_input(RtrEvent* ev)
             tt_ev->dest_loc[i] = id_loc[i];
         }
     } else {
-        int rtr_id = get_dest_router(tt_ev->getDest());
-        idToLocation(rtr_id, tt_ev->dest_loc);
+        tt_ev->dest_router = get_dest_router(tt_ev->getDest());
+        idToLocation(tt_ev->dest_router, tt_ev->dest_loc);
     }
     return tt_ev;
 }
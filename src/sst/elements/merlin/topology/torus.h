@@ -22,6 +22,7 @@
 #include <sst/core/event.h>
 #include <sst/core/link.h>
 #include <sst/core/params.h>
+#include <sst/core/shared/sharedArray.h>
 
 #include <string.h>
 
@@ -34,10 +35,12 @@ class topo_torus_event : public internal_router_event {
 public:
     int dimensions;
     int routing_dim;
+    // Router the destination endpoint hangs off, found once on entry
+    int dest_router;
     int* dest_loc;
 
     topo_torus_event() {}
-    topo_torus_event(int dim) {	dimensions = dim; routing_dim = 0; dest_loc = new int[dim]; }
+    topo_torus_event(int dim) {	dimensions = dim; routing_dim = 0; dest_router = -1; dest_loc = new int[dim]; }
     ~topo_torus_event() { delete[] dest_loc; }
     virtual internal_router_event* clone(void) override
     {
@@ -51,6 +54,7 @@ public:
         internal_router_event::serialize_order(ser);
         ser & dimensions;
         ser & routing_dim;
+        ser & dest_router;
 
         if ( ser.mode() == SST::Core::Serialization::serializer::UNPACK ) {
             dest_loc = new int[dimensions];
@@ -95,6 +99,9 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  For "
                   "example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
+        {"route_table", "Precompute the output port for every (dimension, source, destination) coordinate at construction "
+                        "and share the table between the routers of the same shape on a rank.  Routing then does a table "
+                        "lookup instead of distance computations.", "false"},
     )
 
 
@@ -112,7 +119,12 @@ private:
     int local_port_start;
 
     int num_vns;
-    
+
+    // Optional precomputed routes: route_table[route_row[dim] + dest_coord]
+    // is the output port toward dest_coord in dimension dim
+    Shared::SharedArray<int16_t> route_table;
+    int* route_row;
+
 public:
     topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns);
     ~topo_torus();
@@ -140,6 +152,7 @@ private:
     void parseDimString(const std::string &shape, int *output) const;
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
+    void init_route_table(const std::string& name);
 
 };
 
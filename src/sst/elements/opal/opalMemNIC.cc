@@ -57,11 +57,10 @@ bool OpalMemNIC::clock() {
 bool OpalMemNIC::recvNotify(int) {
     MemRtrEvent * mre = doRecv(link_control);
     if (mre) {
-        MemHierarchy::MemEventBase * me = mre->takeEvent();
-        delete mre;
-        if (me) {
+        while (MemHierarchy::MemEventBase * me = mre->takeEvent()) {
             (*recvHandler)(me);
         }
+        delete mre;
     }
     return true;
 }